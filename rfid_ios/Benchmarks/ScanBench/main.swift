@@ -0,0 +1,208 @@
+//
+//  main.swift
+//  ScanBench
+//
+//  Created on 2025/05/10.
+//
+//  記録ファイル（.rfcap）を最速で再生し、取り込みステージの性能を測る
+//  ファイル指定がなければ合成した記録を使う
+//
+
+import Foundation
+
+// MARK: - 入力 -----------------------------------------------------------------
+func syntheticCapture(tags: Int, batches: Int, readsPerBatch: Int) -> ScanCapture {
+    var rng = SystemRandomNumberGenerator()
+    let uiis: [Data] = (0..<tags).map { i in
+        var bytes: [UInt8] = [0x30, 0x00]
+        withUnsafeBytes(of: UInt64(i).bigEndian) { bytes.append(contentsOf: $0) }
+        bytes.append(contentsOf: [0, 0])
+        return Data(bytes)
+    }
+    let list = (0..<batches).map { b in
+        CapturedBatch(
+            offsetNanos: UInt64(b) * 20_000_000,
+            reads: (0..<readsPerBatch).map { _ in
+                CapturedRead(uii: uiis[Int.random(in: 0..<tags, using: &rng)],
+                             pc: 0x3000,
+                             rssi: Int.random(in: -80 ... -30, using: &rng))
+            })
+    }
+    return ScanCapture(startedAt: Date(), batches: list)
+}
+
+/// 仮想スキャナ（S1, Q=7）で duration 秒分の読取を生成
+func simulatedCapture(tags: Int, duration: TimeInterval) -> ScanCapture {
+    var settings = SimulatedScanSettings()
+    settings.qParam = 7
+    settings.session = .s1
+    let scanner = SimulatedScanner(population: .random(count: tags), settings: settings)
+    var batches: [CapturedBatch] = []
+    var offset: UInt64 = 0
+    let stats = scanner.run(duration: duration) { reads in
+        batches.append(CapturedBatch(offsetNanos: offset, reads: reads))
+        offset += UInt64(settings.burstInterval * 1e9)
+    }
+    print(String(format: "🧪 simulate : %ld tags, %ld reads, %ld unique, %.0f%% slots collided",
+                 tags, stats.reads, stats.uniqueTags,
+                 100 * Double(stats.collidedSlots) / Double(max(stats.slots, 1))))
+    return ScanCapture(startedAt: Date(), batches: batches)
+}
+
+func loadCapture() throws -> ScanCapture {
+    let args = CommandLine.arguments
+    if let i = args.firstIndex(of: "--capture"), i + 1 < args.count {
+        return try ScanCapture(contentsOf: URL(fileURLWithPath: args[i + 1]))
+    }
+    if let i = args.firstIndex(of: "--simulate"), i + 1 < args.count, let tags = Int(args[i + 1]) {
+        return simulatedCapture(tags: tags, duration: 10)
+    }
+    return syntheticCapture(tags: 5_000, batches: 2_000, readsPerBatch: 50)
+}
+
+/// items + inventory_masters!inner(*) の応答を模した JSON（マスター 1 件に rows / masters 件のアイテム）
+func syntheticItemJoin(rows: Int, masters: Int) -> Data {
+    var json = "["
+    json.reserveCapacity(rows * 520)
+    for i in 0..<rows {
+        let m = i % max(masters, 1)
+        if i > 0 { json += "," }
+        json += """
+        {"id":"00000000-0000-4000-8000-\(String(format: "%012ld", i))","created_at":"2025-05-06T01:15:00.123456+00:00",\
+        "updated_at":"2025-05-06T01:15:00.123456+00:00","rfid":"E28011700000020000\(String(format: "%08lX", i))",\
+        "inventory_master_id":"10000000-0000-4000-8000-\(String(format: "%012ld", m))","user_id":null,"is_inventoried":\(i % 3 == 0),\
+        "inventory_masters":{"id":"10000000-0000-4000-8000-\(String(format: "%012ld", m))","created_at":"2025-05-05T07:45:00+00:00",\
+        "updated_at":"2025-05-05T07:45:00+00:00","col_1":"商品 \(m)","col_2":"説明テキスト \(m)","col_3":null,\
+        "product_code":"PC-\(m)","target":"clinic","user_id":null,"product_image":null}}
+        """
+    }
+    json += "]"
+    return Data(json.utf8)
+}
+
+func percentile(_ sorted: [Double], _ p: Double) -> Double {
+    guard !sorted.isEmpty else { return 0 }
+    return sorted[min(sorted.count - 1, Int(Double(sorted.count) * p))]
+}
+
+// MARK: - 計測 -----------------------------------------------------------------
+let capture = try loadCapture()
+
+// 記録フォーマットの往復
+let encodeStart = Date()
+let encoded = capture.encoded()
+let decoded = try ScanCapture(data: encoded)
+let codecElapsed = Date().timeIntervalSince(encodeStart)
+precondition(decoded.readCount == capture.readCount, "記録の往復で件数が一致しません")
+
+// 取り込みステージ（最速再生で取りこぼさないよう全バッチ分のリングを確保）
+let pipeline = ScanIngestPipeline<CapturedRead>(capacity: max(256, decoded.batches.count),
+                                                policy: .dropNewest,
+                                                expectedTagCount: 8192)
+pipeline.capturesSignal = true
+var latencies: [Double] = []
+var uniqueCount = 0
+var deltas: [[EPC]] = []
+pipeline.onDelta = { delta in
+    latencies.append(Date().timeIntervalSince(delta.oldestReceivedAt) * 1_000)
+    uniqueCount = delta.uniqueCount
+    deltas.append(delta.added)
+}
+
+let replayer = ScanReplayer(capture: decoded, speed: .maximum)
+let ingestStart = Date()
+replayer.run { reads in pipeline.push(reads) }
+pipeline.waitUntilIdle()
+let ingestElapsed = Date().timeIntervalSince(ingestStart)
+
+// マスター突き合わせ（読めたタグの半分 + 未読込 20,000 件をマスターにする）
+let seenTags = deltas.flatMap { $0 }
+var masterTags = Set(seenTags.enumerated().filter { $0.offset % 2 == 0 }.map(\.element))
+for i in 0..<20_000 {
+    masterTags.insert(EPC(bytes: [0xE2, 0x80] + withUnsafeBytes(of: UInt64(i).bigEndian, Array.init))!)
+}
+let engine = CompareEngine()
+engine.loadMaster(masterTags)
+let compareStart = Date()
+var matchedCount = 0
+for added in deltas { matchedCount += engine.consume(added).count }
+let compareElapsed = Date().timeIntervalSince(compareStart)
+precondition(engine.counts.matched == matchedCount && engine.counts.actual == seenTags.count,
+             "突き合わせの件数が一致しません")
+
+// 数十万件のマスターに外れタグが大量に来るとき（Bloom 前段フィルタの有無）
+let largeMaster = (0..<300_000).map { EPC(bytes: [0xE2, 0x80, 0x11] + withUnsafeBytes(of: UInt64($0).bigEndian, Array.init))! }
+let foreignReads = (0..<200_000).map { EPC(bytes: [0x30, 0x00] + withUnsafeBytes(of: UInt64($0).bigEndian, Array.init))! }
+var prefilterElapsed: [Double] = []
+var prefilterReport: MasterPrefilterReport?
+for rate in [nil, 0.01] as [Double?] {
+    let large = CompareEngine()
+    large.prefilterRate = rate
+    large.loadMaster(largeMaster)
+    let start = Date()
+    large.consume(foreignReads)
+    prefilterElapsed.append(Date().timeIntervalSince(start))
+    precondition(large.counts.outer == foreignReads.count, "外れの件数が一致しません")
+    if rate != nil { prefilterReport = large.prefilterReport }
+}
+
+// マスター応答のデコード（合成 100,000 行。--rows で変更）
+let joinRows: Int = {
+    let args = CommandLine.arguments
+    if let i = args.firstIndex(of: "--rows"), i + 1 < args.count, let n = Int(args[i + 1]) { return n }
+    return 100_000
+}()
+let joinData = syntheticItemJoin(rows: joinRows, masters: 2_000)
+let typedStart = Date()
+let joinPayload = try ItemJoinDecoder.decode(joinData)
+let typedElapsed = Date().timeIntervalSince(typedStart)
+precondition(joinPayload.items.count == joinRows && joinPayload.masters.count == min(2_000, joinRows),
+             "デコード件数が一致しません")
+// 従来の JSONSerialization（[[String: Any]]）だけの時間（比較用）
+let untypedStart = Date()
+let untyped = try JSONSerialization.jsonObject(with: joinData) as? [[String: Any]]
+let untypedElapsed = Date().timeIntervalSince(untypedStart)
+precondition(untyped?.count == joinRows)
+
+// マスターのスナップショット（デコード結果から作り、開いて突き合わせできるまで）
+let snapshotBuildStart = Date()
+let snapshotData = MasterSnapshot.build(items: joinPayload.items, masters: joinPayload.masters)
+let snapshotBuildElapsed = Date().timeIntervalSince(snapshotBuildStart)
+let snapshotOpenStart = Date()
+let snapshot = try MasterSnapshot(data: snapshotData)
+let snapshotEngine = CompareEngine()
+snapshotEngine.loadMaster(snapshot.epcs)
+let snapshotOpenElapsed = Date().timeIntervalSince(snapshotOpenStart)
+let probe = EPC(hex: joinPayload.items[joinRows / 2].rfid)!
+let lookupStart = Date()
+var lookupHits = 0
+for _ in 0..<100_000 where snapshot.index(of: probe) != nil { lookupHits += 1 }
+let lookupElapsed = Date().timeIntervalSince(lookupStart)
+precondition(snapshot.count == joinRows && lookupHits == 100_000, "スナップショットの件数が一致しません")
+
+// MARK: - 結果 -----------------------------------------------------------------
+let counters = pipeline.currentCounters
+let reads = Double(counters.readsDecoded)
+latencies.sort()
+print("📼 capture  : \(capture.batches.count) batches / \(capture.readCount) reads / \(encoded.count) bytes")
+print(String(format: "⏱ codec    : %.1f ms (encode + decode)", codecElapsed * 1_000))
+print(String(format: "⏱ ingest   : %.1f ms, %.0f reads/s, %.1f ns/read",
+             ingestElapsed * 1_000, reads / ingestElapsed, ingestElapsed * 1e9 / max(reads, 1)))
+print(String(format: "⏱ delta    : p50 %.2f ms / p99 %.2f ms (%ld deltas)",
+             percentile(latencies, 0.5), percentile(latencies, 0.99), latencies.count))
+print("📊 unique   : \(uniqueCount) tags, dropped \(counters.batchesDropped) / \(counters.batchesPushed) batches")
+print(String(format: "⏱ compare  : %.2f ms for %ld deltas, %.0f ns/tag (master %ld, matched %ld, outer %ld)",
+             compareElapsed * 1_000, deltas.count, compareElapsed * 1e9 / Double(max(seenTags.count, 1)),
+             engine.counts.master, engine.counts.matched, engine.counts.outer))
+if let prefilterReport {
+    print(String(format: "⏱ prefilter: %.0f ns/tag exact / %.0f ns/tag bloom (%.0f KB, FPR %.2f%%, master %ld)",
+                 prefilterElapsed[0] * 1e9 / Double(foreignReads.count), prefilterElapsed[1] * 1e9 / Double(foreignReads.count),
+                 Double(prefilterReport.memoryBytes) / 1024, (prefilterReport.observedFalsePositiveRate ?? 0) * 100,
+                 prefilterReport.keys))
+}
+print(String(format: "⏱ decode   : %.0f ms typed / %.0f ms JSONSerialization only (%ld rows, %.1f MB, %ld masters)",
+             typedElapsed * 1_000, untypedElapsed * 1_000, joinRows, Double(joinData.count) / 1e6,
+             joinPayload.masters.count))
+print(String(format: "⏱ snapshot : build %.0f ms / open→matchable %.1f ms / lookup %.0f ns (%.1f MB)",
+             snapshotBuildElapsed * 1_000, snapshotOpenElapsed * 1_000, lookupElapsed * 1e9 / 100_000,
+             Double(snapshotData.count) / 1e6))
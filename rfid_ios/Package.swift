@@ -0,0 +1,49 @@
+// swift-tools-version:5.7
+//
+//  Package.swift
+//  RFID_ios
+//
+//  スキャン取り込み経路（SDK 非依存部分）を Linux でも回すためのパッケージ
+//  アプリ本体は Xcode プロジェクトでビルドする。ここでは記録再生ベンチのみ
+//
+//    swift run -c release ScanBench [--capture path/to/file.rfcap | --simulate 100000] [--rows 100000]
+//
+
+import PackageDescription
+
+let package = Package(
+    name: "RFIDScanBench",
+    targets: [
+        .executableTarget(
+            name: "ScanBench",
+            path: ".",
+            sources: [
+                "RFID_ios/EPC.swift",
+                "RFID_ios/Models.swift",
+                "RFID_ios/TagStore.swift",
+                "RFID_ios/RingBuffer.swift",
+                "RFID_ios/Log.swift",
+                "RFID_ios/HotPathMetrics.swift",
+                "RFID_ios/SignalStats.swift",
+                "RFID_ios/RSSILocator.swift",
+                "RFID_ios/HuntList.swift",
+                "RFID_ios/ScanIngestPipeline.swift",
+                "RFID_ios/ScanCapture.swift",
+                "RFID_ios/ScanReplayer.swift",
+                "RFID_ios/SimulatedScanner.swift",
+                "RFID_ios/CompareEngine.swift",
+                "RFID_ios/MasterPrefilter.swift",
+                "RFID_ios/InventoryWriteBack.swift",
+                "RFID_ios/ItemJoinDecoder.swift",
+                "RFID_ios/MasterDownloader.swift",
+                "RFID_ios/MasterSnapshot.swift",
+                "RFID_ios/SelectMaskPlanner.swift",
+                "RFID_ios/ScanTuner.swift",
+                "RFID_ios/ScannerCommandQueue.swift",
+                "RFID_ios/ScannerConnection.swift",
+                "RFID_ios/DutyCycleScheduler.swift",
+                "Benchmarks/ScanBench/main.swift",
+            ]
+        ),
+    ]
+)
@@ -18,16 +18,39 @@ final class AppDependencies: ObservableObject {
     let itemRegistrationManager: ItemRegistrationManager
     let inventoryMasterManager: InventoryMasterManager
     let itemSearchManager: ItemSearchManager
+    let scanTuningManager: ScanTuningManager
+    let dutyCycleManager: DutyCycleManager
+    let locateManager: LocateManager
+    let huntManager: HuntManager
+    let syncManager: MasterSyncManager
 
     init() {
         // Scanner 周り
         let sm = ScannerManager()
         scannerManager = sm
+
+        // 端末のストア（開けなければメモリ上で動かし、毎回サーバーから取り込む）
+        let store: LocalItemStore
+        do {
+            store = try LocalItemStore.openDefault()
+        } catch {
+            Log.error(.sync, "ローカルストアを開けません: \(error)")
+            store = try! LocalItemStore(path: ":memory:")
+        }
+        let sync = MasterSyncManager(store: store)
+        syncManager = sync
+
         settingManager = SettingManager(scannerManager: sm)
-        compareManager = CompareMasterManager(scannerManager: sm)
-        itemRegistrationManager = ItemRegistrationManager(scannerManager: sm)
+        // 起動直後の突き合わせ用（開けなければ毎回ストアから読む）
+        let snapshots = try? MasterSnapshotStore.openDefault()
+        compareManager = CompareMasterManager(scannerManager: sm, sync: sync, snapshots: snapshots)
+        itemRegistrationManager = ItemRegistrationManager(scannerManager: sm, sync: sync)
         inventoryMasterManager = InventoryMasterManager(scannerManager: sm)
-        itemSearchManager = ItemSearchManager(scannerManager: sm)
+        itemSearchManager = ItemSearchManager(scannerManager: sm, store: store)
+        scanTuningManager = ScanTuningManager(scannerManager: sm, compareManager: compareManager)
+        dutyCycleManager = DutyCycleManager(scannerManager: sm)
+        locateManager = LocateManager(scannerManager: sm)
+        huntManager = HuntManager(scannerManager: sm, compareManager: compareManager)
 
         // スキャナ準備完了後のコールバック
         scannerManager.onScannerReady = { [weak self] _, _ in
@@ -36,5 +59,8 @@ final class AppDependencies: ObservableObject {
 
         // スキャナ初期化
         scannerManager.initializeScanner()
+
+        // 前回送れなかった変更を送る
+        sync.requestUpload()
     }
 }
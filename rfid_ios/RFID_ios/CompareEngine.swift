@@ -0,0 +1,222 @@
+//
+//  CompareEngine.swift
+//  RFID_ios
+//
+//  Created on 2025/05/22.
+//
+//  マスターと読取結果の突き合わせ（新規タグ毎に差分更新）
+//    • consume() は新しく読めたタグだけを受け取り、一致 / 未読込 / 外れ と件数を 1 件 O(1) で更新する
+//    • 未読込はマスター順（UII 昇順）の配列から抜いた所を空きにしておき、一覧を読むときに詰める
+//      （詰めるのは残っている件数分だけ。一覧は表示中にしか読まれない）
+//    • 一致・外れは読めた順の追記のみ
+//  マスターの読込み直しだけは O(マスター + 読取済み) で作り直す
+//  addMaster() はページ毎に届くマスターを追加する（未読込の並べ直しは一覧を読むときに 1 回）
+//  prefilterRate を設定すると、マスターの辞書のキーから作った Bloom フィルタで外れタグを辞書を引く前に落とす
+//  （辞書は未読込の順序と一致状態に要るので残す。フィルタは外れタグの照合時間を減らすためのもの）
+//
+
+import Foundation
+
+struct CompareCounts: Equatable {
+    var master = 0
+    /// 読めたタグ（マスター外を含む）
+    var actual = 0
+    var matched = 0
+    var uncounted = 0
+    var outer = 0
+}
+
+final class CompareEngine {
+
+    private(set) var counts = CompareCounts()
+
+    /// 読めたタグ全部
+    private(set) var seen: Set<EPC> = []
+    /// マスターと一致したタグ（読めた順）
+    private(set) var matched: [EPC] = []
+    /// マスター外のタグ（読めた順）
+    private(set) var outer: [EPC] = []
+
+    /// マスターの UII → uncountedSlots の位置（一致済みは matchedSlot）
+    private var masterSlot: [EPC: Int] = [:]
+    private static let matchedSlot = -1
+    /// マスター順の未読込（読めたら nil にする）
+    private var uncountedSlots: [EPC?] = []
+    private var holes = 0
+    /// addMaster() でマスター順が崩れた
+    private var isUnsorted = false
+    /// これまでに入れたマスターの最大（これより小さいものを追加したら並べ直しが要る）
+    private var masterTail: EPC?
+    /// 詰めた後の未読込一覧（空きができたら作り直す）
+    private var uncountedCache: [EPC]?
+
+    /// 前段フィルタの目標偽陽性率（nil なら使わない）。変えたらマスターから作り直す
+    var prefilterRate: Double? {
+        didSet { if prefilterRate != oldValue { rebuildPrefilter() } }
+    }
+    private var prefilter: MasterBloomFilter?
+    private var prefilterCounts = (rejected: 0, confirmed: 0, falsePositives: 0)
+
+    // MARK: - Master -------------------------------------------------------
+    /// マスターを差し替える。既に読めていたタグのうち一致したものを返す
+    @discardableResult
+    func loadMaster<S: Sequence>(_ tags: S) -> [EPC] where S.Element == EPC {
+        let sorted = Array(Set(tags)).sorted()
+        masterSlot = Dictionary(uniqueKeysWithValues: sorted.enumerated().map { ($1, $0) })
+        uncountedSlots = sorted
+        holes = 0
+        isUnsorted = false
+        masterTail = sorted.last
+        uncountedCache = nil
+        matched = []
+        outer = []
+        rebuildPrefilter()
+        for uii in seen {
+            if masterSlot[uii] != nil {
+                take(uii)
+                matched.append(uii)
+            } else {
+                outer.append(uii)
+            }
+        }
+        counts = CompareCounts(master: sorted.count,
+                               actual: seen.count,
+                               matched: matched.count,
+                               uncounted: sorted.count - matched.count,
+                               outer: outer.count)
+        return matched
+    }
+
+    /// マスターを追加する。既に読めていたタグのうち一致したものを返す
+    @discardableResult
+    func addMaster<S: Sequence>(_ tags: S) -> [EPC] where S.Element == EPC {
+        var newlyMatched: [EPC] = []
+        for uii in tags where masterSlot[uii] == nil {
+            counts.master += 1
+            prefilter?.insert(uii)
+            if seen.contains(uii) {
+                masterSlot[uii] = CompareEngine.matchedSlot
+                matched.append(uii)
+                newlyMatched.append(uii)
+                counts.matched += 1
+            } else {
+                if let tail = masterTail, uii < tail { isUnsorted = true } else { masterTail = uii }
+                masterSlot[uii] = uncountedSlots.count
+                uncountedSlots.append(uii)
+                counts.uncounted += 1
+                uncountedCache = nil
+            }
+        }
+        if !newlyMatched.isEmpty {
+            // 外れだったタグが一致に移る
+            outer.removeAll { masterSlot[$0] != nil }
+            counts.outer = outer.count
+        }
+        // 想定件数を超えると偽陽性が増えるので大きめに作り直す
+        if let prefilter, prefilter.insertedCount > prefilter.capacity { rebuildPrefilter() }
+        return newlyMatched
+    }
+
+    func isMaster(_ uii: EPC) -> Bool { masterSlot[uii] != nil }
+
+    /// いまのマスター（呼び出し側で別の集合を持たずに済むよう辞書のキーをそのまま返す）
+    var masterTags: Dictionary<EPC, Int>.Keys { masterSlot.keys }
+
+    // MARK: - Scan ---------------------------------------------------------
+    /// 新しく読めたタグを取り込み、マスターと初めて一致したものを返す
+    @discardableResult
+    func consume<S: Sequence>(_ added: S) -> [EPC] where S.Element == EPC {
+        var newlyMatched: [EPC] = []
+        for uii in added {
+            guard seen.insert(uii).inserted else { continue }
+            counts.actual += 1
+            if let prefilter {
+                guard prefilter.mayContain(uii) else {
+                    prefilterCounts.rejected += 1
+                    outer.append(uii)
+                    counts.outer += 1
+                    continue
+                }
+            }
+            if masterSlot[uii] != nil {
+                if prefilter != nil { prefilterCounts.confirmed += 1 }
+                take(uii)
+                matched.append(uii)
+                newlyMatched.append(uii)
+                counts.matched += 1
+                counts.uncounted -= 1
+            } else {
+                if prefilter != nil { prefilterCounts.falsePositives += 1 }
+                outer.append(uii)
+                counts.outer += 1
+            }
+        }
+        return newlyMatched
+    }
+
+    /// 読取結果のクリア（マスターはそのまま）
+    func resetScan() {
+        guard !seen.isEmpty else { return }
+        seen = []
+        loadMaster(masterSlot.keys)
+    }
+
+    // MARK: - Prefilter ----------------------------------------------------
+    /// 前段フィルタの大きさと効き目（使っていなければ nil）
+    var prefilterReport: MasterPrefilterReport? {
+        guard let prefilter else { return nil }
+        return MasterPrefilterReport(keys: prefilter.insertedCount,
+                                     memoryBytes: prefilter.memoryBytes,
+                                     hashCount: prefilter.hashCount,
+                                     expectedFalsePositiveRate: prefilter.expectedFalsePositiveRate,
+                                     rejected: prefilterCounts.rejected,
+                                     confirmed: prefilterCounts.confirmed,
+                                     falsePositives: prefilterCounts.falsePositives)
+    }
+
+    /// いまのマスターから作り直す（addMaster() での追加分に 25% の余裕を見ておく）
+    private func rebuildPrefilter() {
+        prefilterCounts = (0, 0, 0)
+        guard let prefilterRate else {
+            prefilter = nil
+            return
+        }
+        prefilter = MasterBloomFilter(masterSlot.keys, count: max(masterSlot.count + masterSlot.count / 4, 1_024),
+                                      falsePositiveRate: prefilterRate)
+    }
+
+    /// 未読込から外す
+    private func take(_ uii: EPC) {
+        guard let slot = masterSlot[uii], slot != CompareEngine.matchedSlot else { return }
+        uncountedSlots[slot] = nil
+        masterSlot[uii] = CompareEngine.matchedSlot
+        holes += 1
+        uncountedCache = nil
+    }
+
+    // MARK: - Lists --------------------------------------------------------
+    /// 未読込タグ（マスター順）。空きが溜まっていれば詰めてから返す
+    var uncounted: [EPC] {
+        if let uncountedCache { return uncountedCache }
+        if holes > 0 || isUnsorted { compact() }
+        // 空きが無いので強制アンラップは安全
+        let list = uncountedSlots.map { $0! }
+        uncountedCache = list
+        return list
+    }
+
+    func isMatched(_ uii: EPC) -> Bool { masterSlot[uii] == CompareEngine.matchedSlot }
+
+    /// 空きを詰め（追加で順序が崩れていれば並べ直し）、残ったタグの位置を付け直す
+    private func compact() {
+        uncountedSlots.removeAll { $0 == nil }
+        if isUnsorted {
+            uncountedSlots.sort { $0! < $1! }
+            isUnsorted = false
+        }
+        for (slot, uii) in uncountedSlots.enumerated() {
+            masterSlot[uii!] = slot
+        }
+        holes = 0
+    }
+}
@@ -7,267 +7,572 @@
 
 import Foundation
 import Combine
-import Supabase
 
 @MainActor
 final class CompareMasterManager: ObservableObject {
 
     // ───────── 公開プロパティ ─────────
     @Published private(set) var masterFileName = "未選択"
-    @Published private(set) var masterTags:  Set<String> = []
-    @Published private(set) var actualTags:  Set<String> = []
-    @Published var selectedTarget: TargetType = .clinic
+    /// マスター / 読取済 / 一致 / 未読込 / 外れ の件数（新規タグ毎に差分更新）
+    @Published private(set) var counts = CompareCounts()
+    @Published var selectedTarget: TargetType = .clinic {
+        // 読込み中の対象は捨てる（次の loadItemsByTarget で新しい対象を読む）
+        didSet { if selectedTarget != oldValue { loadTask?.cancel() } }
+    }
     @Published private(set) var isLoading = false
+    /// 初回ダウンロードの進み具合（ダウンロード中以外は nil）
+    @Published private(set) var loadProgress: MasterDownloadProgress?
     @Published private(set) var errorMessage: String?
 
-    // RFIDとアイテム情報のマッピング
-    @Published private(set) var itemsMap: [String: Item] = [:]
+    // RFIDとアイテム情報のマッピング（キーは EPC、16進文字列は表示/DB 境界でのみ生成）
+    // 棚卸し済みの反映はバッチ毎にその場で書き換えるので @Published にせず、変更前に objectWillChange を送る
+    private(set) var itemsMap: [EPC: Item] = [:]
     @Published private(set) var inventoryMastersMap: [String: InventoryMaster] = [:]
 
-    // 差分表示用
-    var uncountedTags: [String] { Array(masterTags.subtracting(actualTags)) }
-    var outerTags:     [String] { Array(actualTags.subtracting(masterTags)) }
+    /// マスターから求めた Select フィルタをスキャナへ送るか
+    @Published var usesHardwareFilter = true {
+        didSet { updateHardwareFilter() }
+    }
+    @Published private(set) var filterReport: SelectFilterReport?
+
+    /// 数十万件のマスター向け。外れタグを Bloom フィルタで先に落とし、通ったものだけ辞書で確かめる
+    @Published var usesMasterPrefilter = false {
+        didSet {
+            engine.prefilterRate = usesMasterPrefilter ? Self.prefilterFalsePositiveRate : nil
+            prefilterReport = engine.prefilterReport
+        }
+    }
+    @Published private(set) var prefilterReport: MasterPrefilterReport?
+
+    // 差分表示用（CompareEngine が保持している一覧をそのまま返す）
+    /// マスターの UII（CompareEngine の辞書のキー。別の Set は持たない）
+    private var masterTags: Dictionary<EPC, Int>.Keys { engine.masterTags }
+    var actualTags:    Set<EPC> { engine.seen }
+    var uncountedTags: [EPC] { engine.uncounted }
+    var outerTags:     [EPC] { engine.outer }
 
     // ───────── 依存関係 ─────────
     private var cancellables = Set<AnyCancellable>()
+    private weak var scannerManager: ScannerManager?
+    private let engine = CompareEngine()
+    /// 棚卸し済みの端末への反映（照合が何度発火しても 1 件 1 回、まとめて書く）
+    private let writeBack: InventoryWriteBack<String>
+    /// 読んだタグを対象の棚卸しセッションに追記する（1 件 1 回、まとめて送る）
+    private let scanLog: InventoryWriteBack<ScanRecord>
+    private let sync: MasterSyncManager
+    /// items.id → RFID（書き戻し結果を itemsMap に反映するため）
+    private var rfidByItemId: [String: EPC] = [:]
+    private var loadTask: Task<Void, Never>?
+    /// 対象毎のマスターのスナップショット（nil なら使わない）
+    private let snapshots: MasterSnapshotStore?
+    /// 端末ストアを読み終えるまでの間、照合と棚卸しの引き先にするスナップショット
+    private var snapshot: MasterSnapshot?
+    /// 棚卸し画面を表示している間だけ true（フィルタはアプリ全体の読取に効くため）
+    private var isFilterActive = false
+    /// 読込み開始時刻（照合できるようになったら記録して nil にする）
+    private var loadStartedAt: Date?
+
+    /// スキャナに送るマスク数の上限（Select コマンドはラウンド毎に送られる）
+    static let maxSelectMasks = 8
+    /// 前段フィルタの目標偽陽性率
+    static let prefilterFalsePositiveRate = 0.01
+
+    /// セッションに追記する読取（読んだときの対象毎）
+    struct ScanRecord: Hashable {
+        let target: TargetType
+        let rfid: EPC
+    }
 
-    init(scannerManager: ScannerManager) {
-        // Scanner 側の読取結果を監視
-        scannerManager.$scannedUII
-            .sink { [weak self] list in
+    init(scannerManager: ScannerManager, sync: MasterSyncManager, snapshots: MasterSnapshotStore? = nil) {
+        self.scannerManager = scannerManager
+        self.sync = sync
+        self.snapshots = snapshots
+        // 棚卸し済みは端末のストアだけに書く（サーバーはセッションのスキャンから求める）
+        let store = sync.store
+        writeBack = InventoryWriteBack { ids in
+            try await Task.detached { try store.setInventoried(itemIds: ids, value: true) }.value
+        }
+        // 読取は対象毎にセッションへ追記して送信待ちに積む（送信は MasterSyncManager が後から行う）
+        scanLog = InventoryWriteBack { records in
+            let rfidsByTarget = Dictionary(grouping: records, by: \.target).mapValues { $0.map(\.rfid.hex) }
+            try await Task.detached {
+                for (target, rfids) in rfidsByTarget {
+                    try store.appendScans(rfids, target: target)
+                }
+            }.value
+            await sync.requestUpload()
+        }
+        writeBack.onCommitted = { [weak self] ids in self?.applyInventoried(ids) }
+        writeBack.onFailed = { [weak self] ids, error in
+            self?.errorMessage = "更新エラー: \(ids.count)件 \(error.localizedDescription)（後で送り直します）"
+        }
+        scanLog.onFailed = { [weak self] records, error in
+            self?.errorMessage = "スキャン記録エラー: \(records.count)件 \(error.localizedDescription)（後で送り直します）"
+        }
+        // Scanner 側の新規タグだけを突き合わせる
+        scannerManager.scannedDelta
+            .sink { [weak self] added in
                 guard let self = self else { return }
-                self.actualTags = Set(list)
-                print("🔄 スキャンタグ更新: 実測タグ数=\(self.actualTags.count)")
+                let publishedAt = scannerManager.lastPublishedAt
+                let matches = HotPathMetrics.shared.interval("compare.match") { self.engine.consume(added) }
+                self.counts = self.engine.counts
+                Log.debug(.compare, "スキャンタグ更新: +\(added.count) 実測タグ数=\(self.counts.actual)")
+                // 一致・外れに関わらず読んだタグはすべてセッションに残す
+                self.recordScans(added, target: self.selectedTarget)
                 // マスターと一致したタグを自動棚卸し
-                self.autoMarkMatchingTags()
+                self.autoMarkMatchingTags(matches)
+                if let publishedAt {
+                    HotPathMetrics.shared.record(.publishToMatch, since: publishedAt)
+                }
+            }
+            .store(in: &cancellables)
+        // 読取結果のクリア
+        scannerManager.$scannedCount
+            .filter { $0 == 0 }
+            .sink { [weak self] _ in
+                guard let self = self else { return }
+                self.engine.resetScan()
+                self.counts = self.engine.counts
             }
             .store(in: &cancellables)
     }
 
+    /// 読取済みのタグをいまの対象のセッションにも載せる
+    /// 対象を切り替えてマスターを読んだとき、切替前に読んだタグは scannedDelta からは二度と届かないため
+    private func recordScans<S: Sequence>(_ tags: S, target: TargetType) where S.Element == EPC {
+        scanLog.enqueue(tags.lazy.map { ScanRecord(target: target, rfid: $0) })
+    }
+
     // ───────── マッチしたタグを自動で棚卸しマーク ─────────
-    private func autoMarkMatchingTags() {
-        let matches = masterTags.intersection(actualTags)
-        print("🔍 マッチタグ検出: 件数=\(matches.count) -> \(matches)")
-        for rfid in matches {
-            if let item = itemsMap[rfid], !item.isInventoried {
-                print("🔄 自動棚卸し実行: RFID=\(rfid)")
-                Task {
-                    await markAsInventoried(rfid: rfid)
-                }
-            } else {
-                print("ℹ️ スキップ: 既に棚卸し済みまたはアイテム不明: RFID=\(rfid)")
-            }
+    /// matches は今回初めてマスターと一致したタグ
+    private func autoMarkMatchingTags(_ matches: [EPC]) {
+        guard !matches.isEmpty else { return }
+        Log.debug(.compare, "マッチタグ検出: 件数=\(matches.count) -> \(matches)")
+        let ids = matches.compactMap { rfid -> String? in
+            guard let item = itemState(rfid), !item.isInventoried else { return nil }
+            return item.id
         }
+        let added = writeBack.enqueue(ids)
+        HotPathMetrics.shared.increment(.tagsMatched, by: added)
+        Log.debug(.compare, "自動棚卸し: 受付 \(added) 件 / 一致 \(matches.count) 件")
+    }
+
+    /// 1 件を書き戻し待ちに積む（探索モードの発見時など）
+    func enqueueInventoried(rfid: EPC) {
+        guard let item = itemState(rfid), !item.isInventoried else { return }
+        scanLog.enqueue(CollectionOfOne(ScanRecord(target: selectedTarget, rfid: rfid)))
+        writeBack.enqueue(CollectionOfOne(item.id))
     }
 
-    // ───────── Supabaseからアイテム読み込み ─────────
+    /// itemsMap から、無ければ（端末ストアを読み終えるまでは）スナップショットからその場で引く
+    private func itemState(_ rfid: EPC) -> (id: String, isInventoried: Bool)? {
+        if let item = itemsMap[rfid] { return (item.id, item.isInventoried) }
+        guard let snapshot, let i = snapshot.index(of: rfid) else { return nil }
+        return (snapshot.itemId(at: i), snapshot.isInventoried(at: i))
+    }
+
+    /// 書き戻し済みを itemsMap にその場で反映する（バッチ毎に通知 1 回）
+    private func applyInventoried(_ ids: [String]) {
+        objectWillChange.send()
+        for id in ids {
+            guard let rfid = rfidByItemId[id] else { continue }
+            itemsMap[rfid]?.isInventoried = true
+        }
+        Log.debug(.compare, "ローカルマップ更新完了: \(ids.count) 件")
+    }
+
+    // ───────── 端末のストアからアイテム読み込み ─────────
+    /// スナップショットがあれば開いてすぐに突き合わせを始め、端末のストアを読み終えたら差し替える
+    /// 端末にまだ無い対象はページ毎にダウンロードし、届いたページから突き合わせる
+    /// 差分同期で変わっていたら作り直し、次回用のスナップショットを書き直す
+    /// 前の読込みが残っていればキャンセルする
     func loadItemsByTarget() async {
+        loadTask?.cancel()
+        let target = selectedTarget
+        let task = Task { await load(target) }
+        loadTask = task
+        await task.value
+    }
+
+    private func load(_ target: TargetType) async {
         isLoading = true
         errorMessage = nil
+        loadStartedAt = Date()
+        defer {
+            if target == selectedTarget {
+                isLoading = false
+                loadProgress = nil
+            }
+        }
+        // 書き戻し待ちは先にストアへ入れておく（読み込み結果に反映させる）
+        await writeBack.flush()
+        let fromSnapshot = applySnapshot(target)
+
+        let store = sync.store
+        let downloaded = (try? await Task.detached { try store.isDownloaded(target) }.value) ?? false
+        var complete = true
+        if downloaded {
+            await applyLocal(target)
+        } else {
+            complete = await download(target)
+            // スナップショットにあって今回届かなかった行を落とす
+            if complete, snapshot != nil { await applyLocal(target) }
+        }
+        guard !Task.isCancelled else {
+            Log.info(.compare, "loadItemsByTarget キャンセル: \(target.rawValue)")
+            return
+        }
+        let pulled = await sync.pull()
+        if pulled > 0, !Task.isCancelled {
+            await applyLocal(target)
+        }
+        // 件数も差分も変わっていなければ書き直さない
+        if complete, !Task.isCancelled, pulled > 0 || fromSnapshot?.count != itemsMap.count {
+            saveSnapshot(target)
+        }
+        Log.info(.compare, "loadItemsByTarget 処理完了")
+    }
 
-        do {
-            print("🔍 \(selectedTarget.rawValue)のアイテムを読み込み開始")
-            let query = supabase
-                .from("items")
-                .select("*, inventory_masters!inner(*)")
-                .eq("inventory_masters.target", value: selectedTarget.rawValue)
-
-            print("📊 実行クエリ: items + inventory_masters, target=\(selectedTarget.rawValue)")
-            let response = try await query.execute()
-            print("📦 レスポンスステータス: \(response.status)")
-
-            let data = response.data
-            print("📊 取得データサイズ: \(data.count) bytes")
-
-            if let dataString = String(data: data, encoding: .utf8) {
-                let previewLength = min(dataString.count, 100)
-                print("📄 データプレビュー: \(dataString.prefix(previewLength))...")
+    /// スナップショットを開いて突き合わせを始める（itemsMap は端末ストアを読むまで空）
+    private func applySnapshot(_ target: TargetType) -> MasterSnapshot? {
+        // 前の対象のスナップショットは引き先にしない
+        snapshot = nil
+        guard let snapshots, let opened = snapshots.load(target), opened.count > 0 else { return nil }
+        objectWillChange.send()
+        itemsMap = [:]
+        rfidByItemId = [:]
+        inventoryMastersMap = [:]
+        snapshot = opened
+        let matches = engine.loadMaster(opened.epcs)
+        counts = engine.counts
+        recordScans(actualTags, target: target)
+        markMatchable()
+        Log.info(.compare, "スナップショットから読込: アイテム=\(opened.count)、マスター=\(opened.masterCount)")
+
+        autoMarkMatchingTags(matches)
+        updateHardwareFilter()
+        masterFileName = "\(target.rawValue)の商品 (\(opened.count)件)"
+        return opened
+    }
+
+    /// いまの itemsMap を次回用のスナップショットに書き出す（メインスレッド外）
+    private func saveSnapshot(_ target: TargetType) {
+        guard let snapshots, target == selectedTarget, snapshot == nil, !itemsMap.isEmpty else { return }
+        let items = Array(itemsMap.values)
+        let masters = inventoryMastersMap
+        Task.detached(priority: .utility) {
+            do {
+                try snapshots.save(items: items, masters: masters, for: target)
+            } catch {
+                Log.warning(.compare, "スナップショット書き出しエラー: \(error)")
             }
+        }
+    }
 
-            let decoder = JSONDecoder()
-            decoder.keyDecodingStrategy = .convertFromSnakeCase
-
-            if let jsonArray = try JSONSerialization.jsonObject(with: data, options: []) as? [[String: Any]] {
-                print("✅ JSONパース成功: 件数=\(jsonArray.count)")
-
-                var newItemsMap: [String: Item] = [:]
-                var newMasterIds: Set<String> = []
-                var newInventoryMasters: [String: InventoryMaster] = [:]
-
-                for itemData in jsonArray {
-                    guard let id = itemData["id"] as? String,
-                          let rfid = itemData["rfid"] as? String,
-                          let masterId = itemData["inventory_master_id"] as? String,
-                          let createdAt = itemData["created_at"] as? String,
-                          let updatedAt = itemData["updated_at"] as? String else {
-                        print("⚠️ 必須フィールドが見つかりません: \(itemData)")
-                        continue
-                    }
-
-                    let isInventoried = itemData["is_inventoried"] as? Bool ?? false
-                    let userId = itemData["user_id"] as? String
-
-                    let item = Item(
-                        id: id,
-                        createdAt: createdAt,
-                        updatedAt: updatedAt,
-                        rfid: rfid,
-                        inventoryMasterId: masterId,
-                        userId: userId,
-                        isInventoried: isInventoried
-                    )
-                    newItemsMap[rfid] = item
-                    newMasterIds.insert(masterId)
-
-                    if let invData = itemData["inventory_masters"] as? [String: Any],
-                       let invId = invData["id"] as? String,
-                       let col1 = invData["col_1"] as? String,
-                       let targetStr = invData["target"] as? String,
-                       let invCreated = invData["created_at"] as? String,
-                       let invUpdated = invData["updated_at"] as? String {
-
-                        let col2 = invData["col_2"] as? String
-                        let col3 = invData["col_3"] as? String
-                        let productCode = invData["product_code"] as? String
-                        let userId = invData["user_id"] as? String
-                        let productImage = invData["product_image"] as? String
-
-                        let targetType: TargetType = TargetType(rawValue: targetStr) ?? .clinic
-                        let master = InventoryMaster(
-                            id: invId,
-                            createdAt: invCreated,
-                            updatedAt: invUpdated,
-                            col1: col1,
-                            col2: col2,
-                            col3: col3,
-                            productCode: productCode,
-                            target: targetType,
-                            userId: userId,
-                            productImage: productImage
-                        )
-                        newInventoryMasters[invId] = master
-                    }
-                }
+    private func markMatchable() {
+        guard let startedAt = loadStartedAt else { return }
+        loadStartedAt = nil
+        HotPathMetrics.shared.record(.loadToMatchable, since: startedAt)
+    }
 
-                // データ更新
-                self.itemsMap = newItemsMap
-                self.masterTags = Set(newItemsMap.keys)
-                self.inventoryMastersMap = newInventoryMasters
-                print("✅ データ処理完了: アイテム=\(newItemsMap.count)、マスター=\(newInventoryMasters.count)")
-
-                // 自動棚卸し試行
-                autoMarkMatchingTags()
-
-                masterFileName = "\(selectedTarget.rawValue)の商品 (\(newItemsMap.count)件)"
-
-            } else {
-                if data.count <= 2 {
-                    print("ℹ️ 空の配列を受信")
-                    self.itemsMap = [:]
-                    self.masterTags = []
-                    self.inventoryMastersMap = [:]
-                    masterFileName = "\(selectedTarget.rawValue)の商品 (0件)"
-                } else {
-                    throw NSError(domain: "JSONParseError", code: 1, userInfo: [NSLocalizedDescriptionKey: "JSONデータの形式が不正です"])
-                }
+    /// 初回ダウンロード。空のマスター（スナップショットがあればその上）から始めて、ページ毎にマスターを足していく
+    /// 最後まで取れたら true
+    private func download(_ target: TargetType) async -> Bool {
+        if snapshot == nil {
+            replaceMaster(items: [:], masters: [:], target: target)
+        }
+        do {
+            try await sync.downloadTarget(target, onPage: { [weak self] page in
+                guard let self, target == self.selectedTarget else { throw CancellationError() }
+                self.mergePage(page)
+            }, onProgress: { [weak self] progress in
+                guard let self, target == self.selectedTarget else { return }
+                self.loadProgress = progress
+                self.masterFileName = "\(target.rawValue)の商品 (\(self.itemsMap.count)件 \(Int(progress.fraction * 100))%)"
+            })
+            masterFileName = "\(target.rawValue)の商品 (\(itemsMap.count)件)"
+            updateHardwareFilter()
+            return true
+        } catch is CancellationError {
+            return false
+        } catch {
+            guard target == selectedTarget else { return false }
+            errorMessage = "読込エラー: \(error.localizedDescription)"
+            Log.warning(.compare, "初回ダウンロードエラー: \(error)")
+            // 取れた分だけで続ける
+            updateHardwareFilter()
+            return false
+        }
+    }
+
+    /// 届いたページをその場で itemsMap / 突き合わせに足す
+    private func mergePage(_ page: ItemJoinPayload) {
+        objectWillChange.send()
+        var added: [EPC] = []
+        added.reserveCapacity(page.items.count)
+        for item in page.items {
+            guard let epc = EPC(hex: item.rfid) else {
+                Log.warning(.compare, "RFID形式が不正です: \(item.rfid)")
+                continue
             }
+            itemsMap[epc] = item
+            rfidByItemId[item.id] = epc
+            added.append(epc)
+        }
+        inventoryMastersMap.merge(page.masters) { current, _ in current }
+        let matches = engine.addMaster(added)
+        counts = engine.counts
+        recordScans(matches, target: selectedTarget)
+        markMatchable()
+        autoMarkMatchingTags(matches)
+    }
 
-        } catch let error {
+    private func applyLocal(_ target: TargetType) async {
+        let store = sync.store
+        do {
+            let (items, masters) = try await Task.detached { try store.items(target: target) }.value
+            guard target == selectedTarget, !Task.isCancelled else { return }
+
+            var newItemsMap: [EPC: Item] = [:]
+            newItemsMap.reserveCapacity(items.count)
+            for item in items {
+                guard let epc = EPC(hex: item.rfid) else {
+                    Log.warning(.compare, "RFID形式が不正です: \(item.rfid)")
+                    continue
+                }
+                newItemsMap[epc] = item
+            }
+            replaceMaster(items: newItemsMap, masters: masters, target: target)
+            updateHardwareFilter()
+        } catch {
             errorMessage = "読込エラー: \(error.localizedDescription)"
-            print("⚠️ Supabase読込エラー: \(error)")
+            Log.warning(.compare, "ローカル読込エラー: \(error)")
         }
+    }
 
-        isLoading = false
-        print("✅ loadItemsByTarget 処理完了")
+    /// マスターを丸ごと差し替える
+    private func replaceMaster(items newItemsMap: [EPC: Item], masters: [String: InventoryMaster], target: TargetType) {
+        // データ更新
+        objectWillChange.send()
+        self.itemsMap = newItemsMap
+        self.rfidByItemId = Dictionary(newItemsMap.map { ($1.id, $0) }, uniquingKeysWith: { a, _ in a })
+        self.inventoryMastersMap = masters
+        self.snapshot = nil
+        let matches = engine.loadMaster(newItemsMap.keys)
+        self.counts = engine.counts
+        recordScans(actualTags, target: target)
+        if !newItemsMap.isEmpty { markMatchable() }
+        Log.info(.compare, "データ処理完了: アイテム=\(newItemsMap.count)、マスター=\(masters.count)")
+
+        // 読取済みのタグで自動棚卸し試行
+        autoMarkMatchingTags(matches)
+
+        masterFileName = "\(target.rawValue)の商品 (\(newItemsMap.count)件)"
     }
 
     // ───────── 棚卸しステータス更新 ─────────
-    func markAsInventoried(rfid: String) async {
-        guard let item = itemsMap[rfid] else {
-            print("⚠️ アイテム不明: RFID=\(rfid)")
+    /// 手動の棚卸し。端末に反映してセッションに追記し、書き込みが終わるまで待つ
+    func markAsInventoried(rfid: EPC) async {
+        guard let item = itemState(rfid) else {
+            Log.warning(.compare, "アイテム不明: RFID=\(rfid)")
             errorMessage = "アイテムが見つかりません: \(rfid)"
             return
         }
-        print("🔄 更新開始: ID=\(item.id), RFID=\(rfid)")
-        do {
-            let response = try await supabase
-                .from("items")
-                .update(["is_inventoried": true])
-                .eq("id", value: item.id)
-                .execute()
-            print("✅ 棚卸し更新成功: ステータス=\(response.status)")
-
-            var updatedMap = itemsMap
-            let updatedItem = Item(
-                id: item.id,
-                createdAt: item.createdAt,
-                updatedAt: item.updatedAt,
-                rfid: item.rfid,
-                inventoryMasterId: item.inventoryMasterId,
-                userId: item.userId,
-                isInventoried: true
-            )
-            updatedMap[rfid] = updatedItem
-            self.itemsMap = updatedMap
-            print("✅ ローカルマップ更新完了: RFID=\(rfid)")
-        } catch let updateError {
-            errorMessage = "更新エラー: \(updateError.localizedDescription)"
-            print("⚠️ 更新エラー: \(updateError)")
-        }
+        Log.debug(.compare, "更新開始: ID=\(item.id), RFID=\(rfid)")
+        writeBack.enqueue(CollectionOfOne(item.id))
+        scanLog.enqueue(CollectionOfOne(ScanRecord(target: selectedTarget, rfid: rfid)))
+        await writeBack.flush()
+        await scanLog.flush()
+    }
+
+    // ───────── 全件取り直し ─────────
+    /// 書き戻し待ち・追記待ちをストアに入れてから全件取り直し、いまの対象を読み直す
+    func fullResync() async {
+        await writeBack.flush()
+        await scanLog.flush()
+        await sync.fullResync()
+        await loadItemsByTarget()
+    }
+
+    // ───────── 棚卸し完了 ─────────
+    /// 読んだ分を送ってから対象のセッションを締める（一致 / 未読込 / 外れはサーバー側で求める）
+    /// 端末の棚卸し済みは戻し、次に読んだタグから新しいセッションになる
+    func finishInventory() async {
+        isLoading = true
+        errorMessage = nil
+        let target = selectedTarget
+        Log.info(.compare, "棚卸し完了: ターゲット=\(target.rawValue)")
+
+        await writeBack.flush()
+        await scanLog.flush()
+        await closeSession(target, discard: false)
+
+        isLoading = false
     }
 
     // ───────── 棚卸しステータスリセット ─────────
     func resetInventoryStatus() async {
         isLoading = true
         errorMessage = nil
-        print("🔄 リセット開始: ターゲット=\(selectedTarget.rawValue)")
+        Log.info(.compare, "リセット開始: ターゲット=\(selectedTarget.rawValue)")
+
+        // 書き戻し待ち・追記待ちを捨て、送信中の分が終わってから開いているセッションを破棄する
+        await writeBack.reset()
+        await scanLog.reset()
+        await closeSession(selectedTarget, discard: true)
+
+        isLoading = false
+        Log.info(.compare, "resetInventoryStatus 処理完了")
+    }
 
+    /// 端末のセッションを閉じて送信待ちに積み、対象の棚卸し済みを戻す
+    /// items.is_inventoried を IN (...) で書き換える代わりに、サーバーへは締め / 破棄の 1 回だけ送る
+    private func closeSession(_ target: TargetType, discard: Bool) async {
+        let store = sync.store
         do {
-            // リセット対象のアイテムIDを取得
-            let ids = itemsMap.values.map { $0.id }
-            if ids.isEmpty {
-                print("ℹ️ リセット対象がありません")
-            } else {
-                print("🔄 データベースリセット対象IDs: \(ids)")
-                // バッチ更新
-                let response = try await supabase
-                    .from("items")
-                    .update(["is_inventoried": false])
-                    .in("id", values: ids)
-                    .execute()
-                print("✅ リセット成功: ステータス=\(response.status)")
+            let closed = try await Task.detached { try store.closeSession(target: target, discard: discard) }.value
+            if closed != nil { sync.requestUpload() }
+            Log.info(.compare, "セッション\(discard ? "破棄" : "締め"): \(closed ?? "なし") 送信待ち=\(sync.pendingUploads)")
+
+            // 次の棚卸しで同じタグを受け付け直す（スキャナの一覧も消さないと既に読んだタグが新しいセッションに届かない）
+            await writeBack.reset()
+            await scanLog.reset()
+            scannerManager?.clearScannedData()
+            engine.resetScan()
+            counts = engine.counts
+            guard target == selectedTarget else { return }
+            objectWillChange.send()
+            for rfid in itemsMap.keys {
+                itemsMap[rfid]?.isInventoried = false
             }
+            Log.info(.compare, "ローカルマップリセット完了: アイテム数=\(itemsMap.count)")
+        } catch {
+            errorMessage = "\(discard ? "リセット" : "棚卸し完了")エラー: \(error.localizedDescription)"
+            Log.warning(.compare, "セッション更新エラー: \(error)")
+        }
+    }
 
-            // ローカルマップのリセット
-            var updatedMap: [String: Item] = [:]
-            for (rfid, item) in itemsMap {
-                let resetItem = Item(
-                    id: item.id,
-                    createdAt: item.createdAt,
-                    updatedAt: item.updatedAt,
-                    rfid: item.rfid,
-                    inventoryMasterId: item.inventoryMasterId,
-                    userId: item.userId,
-                    isInventoried: false
-                )
-                updatedMap[rfid] = resetItem
-            }
-            self.itemsMap = updatedMap
-            self.masterTags = Set(updatedMap.keys)
-            print("✅ ローカルマップリセット完了: アイテム数=\(updatedMap.count)")
+    // ───────── ハードウェア Select フィルタ ─────────
+    /// 棚卸し画面の表示開始。マスターからフィルタを作ってスキャナへ送る
+    func activateHardwareFilter() {
+        isFilterActive = true
+        updateHardwareFilter()
+    }
+
+    /// 棚卸し画面を離れるときにフィルタを外す（登録・検索画面で新しいタグを読めるように）
+    func deactivateHardwareFilter() {
+        guard isFilterActive else { return }
+        isFilterActive = false
+        scannerManager?.setSelectFilter([])
+    }
+
+    /// マスター外タグの読取をスキャナ側で止める。マスター再読込のたびに作り直す
+    /// 棚卸し画面の外（探索・位置特定中を含む）ではスキャナのフィルタに触らない
+    private func updateHardwareFilter() {
+        guard let scanner = scannerManager, isFilterActive else { return }
+        guard usesHardwareFilter, !masterTags.isEmpty else {
+            scanner.setSelectFilter([])
+            filterReport = nil
+            return
+        }
+        let masks = SelectMaskPlanner.plan(covering: masterTags, maxMasks: Self.maxSelectMasks)
+        guard !masks.isEmpty else {
+            Log.info(.compare, "共通プレフィックスがないためフィルタなし")
+            scanner.setSelectFilter([])
+            filterReport = nil
+            return
+        }
 
-        } catch let error {
-            errorMessage = "リセットエラー: \(error.localizedDescription)"
-            print("⚠️ リセットエラー: \(error)")
+        // フィルタなしで読めていた分を基準にする（フィルタ適用中は外れタグが来ないので前回値を引き継ぐ）
+        let foreign = outerTags
+        let counters = scanner.ingestCounters
+        var report = SelectFilterReport(masks: masks, masterCount: masterTags.count,
+                                        readsAtApply: counters.readsDecoded)
+        let totalReads = filterReport == nil ? scanner.readCount(of: actualTags) : 0
+        if totalReads > 0 {
+            let foreignReads = scanner.readCount(of: foreign)
+            report.foreignTagsSeen = foreign.count
+            report.foreignTagsLeaking = foreign.filter { uii in masks.contains { $0.matches(uii) } }.count
+            report.foreignReadRatio = Double(foreignReads) / Double(totalReads)
+            report.readsPerCallback = Double(counters.readsDecoded) / Double(max(counters.batchesConsumed, 1))
+            report.bytesPerRead = SelectFilterReport.estimatedBytesPerRead(
+                uiiLength: foreign.isEmpty ? 12 : foreign.reduce(0) { $0 + $1.count } / foreign.count)
+        } else if let previous = filterReport {
+            report.carryBaseline(from: previous)
         }
+        filterReport = report
+        scanner.setSelectFilter(masks)
+        Log.info(.compare, "Select フィルタ: マスター=\(masterTags.count) → マスク \(masks.count) 件, 外れ通過 \(report.foreignTagsLeaking)/\(report.foreignTagsSeen)")
+    }
 
-        isLoading = false
-        print("✅ resetInventoryStatus 処理完了")
+    /// フィルタ適用後の読取数から削減量を見積もり直す
+    func refreshFilterReport() {
+        if prefilterReport != engine.prefilterReport { prefilterReport = engine.prefilterReport }
+        guard let scanner = scannerManager, var report = filterReport else { return }
+        report.update(readsDecoded: scanner.ingestCounters.readsDecoded)
+        filterReport = report
     }
 
     // 特定RFIDのInventoryMaster取得
-    func getInventoryMaster(for rfid: String) -> InventoryMaster? {
+    func getInventoryMaster(for rfid: EPC) -> InventoryMaster? {
         guard let item = itemsMap[rfid] else { return nil }
         return inventoryMastersMap[item.inventoryMasterId]
     }
+
+    /// 商品名（端末ストアを読み終えるまではスナップショットから）
+    func itemName(for rfid: EPC) -> String? {
+        if let master = getInventoryMaster(for: rfid) { return master.col1 }
+        guard let snapshot, let i = snapshot.index(of: rfid) else { return nil }
+        return snapshot.master(at: snapshot.masterIndex(at: i)).col1
+    }
+
+    func isInventoried(_ rfid: EPC) -> Bool { itemState(rfid)?.isInventoried ?? false }
+}
+
+// ───────── フィルタ効果の見積もり ─────────
+/// フィルタなしで観測したマスター外読取の割合から、スキャナ側で止めた量を推定する
+struct SelectFilterReport {
+    let masks: [SelectMask]
+    let masterCount: Int
+    /// フィルタなしで観測したマスター外タグ数
+    var foreignTagsSeen = 0
+    /// そのうちマスクを通過してしまうタグ数
+    var foreignTagsLeaking = 0
+    /// フィルタなしの全読取に占めるマスター外読取の割合
+    var foreignReadRatio = 0.0
+    var readsPerCallback = 1.0
+    var bytesPerRead = SelectFilterReport.estimatedBytesPerRead(uiiLength: 12)
+
+    /// 適用時点の累積読取数
+    let readsAtApply: Int
+    private(set) var savedReads = 0
+    var savedBytes: Int { Int(Double(savedReads) * bytesPerRead) }
+    var savedCallbacks: Int { Int(Double(savedReads) / max(readsPerCallback, 1)) }
+
+    init(masks: [SelectMask], masterCount: Int, readsAtApply: Int) {
+        self.masks = masks
+        self.masterCount = masterCount
+        self.readsAtApply = readsAtApply
+    }
+
+    /// BLE 上の 1 読取あたりの概算（UII + PC + RSSI/アンテナ/偏波/ch/位相 + フレーム）
+    static func estimatedBytesPerRead(uiiLength: Int) -> Double {
+        Double(uiiLength + 2 + 6 + 4)
+    }
+
+    mutating func carryBaseline(from previous: SelectFilterReport) {
+        foreignTagsSeen = previous.foreignTagsSeen
+        foreignTagsLeaking = previous.foreignTagsLeaking
+        foreignReadRatio = previous.foreignReadRatio
+        readsPerCallback = previous.readsPerCallback
+        bytesPerRead = previous.bytesPerRead
+    }
+
+    /// 適用後に届いた読取 n 件に対し、フィルタがなければ n × r / (1 - r) 件の外れ読取があった
+    mutating func update(readsDecoded: Int) {
+        let received = max(readsDecoded - readsAtApply, 0)
+        let leakRatio = foreignTagsSeen == 0 ? 0 : Double(foreignTagsLeaking) / Double(foreignTagsSeen)
+        let blockedRatio = min(foreignReadRatio * (1 - leakRatio), 0.99)
+        savedReads = Int(Double(received) * blockedRatio / (1 - blockedRatio))
+    }
 }
@@ -10,8 +10,9 @@ import Foundation
 
 struct CompareMasterView: View {
     @EnvironmentObject var cmp: CompareMasterManager
-    @State private var showingDetails: String? = nil
+    @State private var showingDetails: EPC? = nil
     @State private var showingResetConfirmation = false
+    @State private var showingFinishConfirmation = false
 
     var body: some View {
         VStack {
@@ -30,13 +31,29 @@ struct CompareMasterView: View {
                 }
             }
 
-            // 棚卸しリセットボタン
-            Button("棚卸しステータスをリセット") {
-                showingResetConfirmation = true
+            // 棚卸し完了 / リセットボタン
+            HStack {
+                Button("棚卸し完了") {
+                    showingFinishConfirmation = true
+                }
+                .buttonStyle(.borderedProminent)
+                Button("棚卸しステータスをリセット") {
+                    showingResetConfirmation = true
+                }
+                .buttonStyle(.bordered)
             }
-            .buttonStyle(.bordered)
             .padding(.horizontal)
             .padding(.bottom)
+            .alert("確認", isPresented: $showingFinishConfirmation) {
+                Button("キャンセル", role: .cancel) { }
+                Button("完了") {
+                    Task {
+                        await cmp.finishInventory()
+                    }
+                }
+            } message: {
+                Text("選択された対象（\(cmp.selectedTarget.rawValue)）の今回の棚卸しを締めます。読み取った結果は履歴として残り、次に読んだタグから新しい棚卸しになります。")
+            }
             .alert("確認", isPresented: $showingResetConfirmation) {
                 Button("キャンセル", role: .cancel) { }
                 Button("リセット", role: .destructive) {
@@ -45,7 +62,7 @@ struct CompareMasterView: View {
                     }
                 }
             } message: {
-                Text("選択された対象（\(cmp.selectedTarget.rawValue)）の全アイテムの棚卸しステータスをリセットします。この操作は元に戻せません。")
+                Text("選択された対象（\(cmp.selectedTarget.rawValue)）の全アイテムの棚卸しステータスをリセットします。締めていない今回の読取結果は破棄されます。この操作は元に戻せません。")
             }
 
             List {
@@ -56,23 +73,50 @@ struct CompareMasterView: View {
                         .lineLimit(1)
                     Spacer()
                 }
+                // 初回ダウンロード中（届いたページから突き合わせ済み）
+                if let progress = cmp.loadProgress {
+                    ProgressView(value: progress.fraction) {
+                        Text("ダウンロード中 \(progress.rowsLoaded)\(progress.totalRows.map { " / \($0)" } ?? "")件")
+                            .font(.caption)
+                    }
+                }
 
                 // ② 数値サマリ：LazyVGrid で横並び
                 LazyVGrid(columns: Array(repeating: .init(.flexible()), count: 4)) {
-                    StatCell(title: "マスター", value: cmp.masterTags.count)
-                    StatCell(title: "読取済",  value: cmp.actualTags.count)
-                    StatCell(title: "未読込",  value: cmp.uncountedTags.count)
-                    StatCell(title: "外れ",    value: cmp.outerTags.count)
+                    StatCell(title: "マスター", value: cmp.counts.master)
+                    StatCell(title: "読取済",  value: cmp.counts.actual)
+                    StatCell(title: "未読込",  value: cmp.counts.uncounted)
+                    StatCell(title: "外れ",    value: cmp.counts.outer)
                 }
                 .padding(.vertical, 4)
 
+                // ②' スキャナ側フィルタ
+                Section("スキャナ側フィルタ") {
+                    Toggle("マスター外タグを読まない", isOn: $cmp.usesHardwareFilter)
+                    if let report = cmp.filterReport {
+                        Text("マスク \(report.masks.count)件 / 外れ通過 \(report.foreignTagsLeaking)/\(report.foreignTagsSeen)件")
+                            .font(.caption)
+                        Text("削減見込み: \(report.savedReads)読取 / \(ByteCountFormatter.string(fromByteCount: Int64(report.savedBytes), countStyle: .binary)) / \(report.savedCallbacks)回")
+                            .font(.caption)
+                            .foregroundColor(.secondary)
+                    }
+                }
+                .onReceive(Timer.publish(every: 1, on: .main, in: .common).autoconnect()) { _ in
+                    cmp.refreshFilterReport()
+                }
+
                 // ③ 未読込タグ
-                if !cmp.uncountedTags.isEmpty {
+                if cmp.counts.uncounted > 0 {
                     Section("未読込タグ") {
+                        NavigationLink {
+                            HuntListView()
+                        } label: {
+                            Label("近い順に探す（\(cmp.counts.uncounted)件）", systemImage: "dot.radiowaves.left.and.right")
+                        }
                         ForEach(cmp.uncountedTags, id: \.self) { rfid in
                             Button(action: { showingDetails = rfid }) {
                                 HStack {
-                                    Text(rfid)
+                                    Text(rfid.hex)
                                     Spacer()
                                     Image(systemName: "info.circle")
                                         .foregroundColor(.blue)
@@ -84,9 +128,9 @@ struct CompareMasterView: View {
                 }
 
                 // ④ 外れタグ
-                if !cmp.outerTags.isEmpty {
+                if cmp.counts.outer > 0 {
                     Section("外れタグ") {
-                        ForEach(cmp.outerTags, id: \.self, content: Text.init)
+                        ForEach(cmp.outerTags, id: \.self) { Text($0.hex) }
                     }
                 }
             }
@@ -100,22 +144,26 @@ struct CompareMasterView: View {
             ItemDetailView(rfid: wrapper.rfid, cmp: cmp)
         }
         .onAppear {
+            cmp.activateHardwareFilter()
             Task {
                 await cmp.loadItemsByTarget()
             }
         }
+        .onDisappear {
+            cmp.deactivateHardwareFilter()
+        }
     }
 }
 
 // アイテム詳細表示用のラッパー
 struct ItemDetailWrapper: Identifiable {
-    let rfid: String
-    var id: String { rfid }
+    let rfid: EPC
+    var id: EPC { rfid }
 }
 
 // アイテム詳細表示View
 struct ItemDetailView: View {
-    let rfid: String
+    let rfid: EPC
     let cmp: CompareMasterManager
     @Environment(\.dismiss) private var dismiss
     @State private var isUpdating = false
@@ -131,7 +179,7 @@ struct ItemDetailView: View {
                             HStack {
                                 Text("RFID:")
                                     .fontWeight(.bold)
-                                Text(rfid)
+                                Text(rfid.hex)
                             }
 
                             Divider()
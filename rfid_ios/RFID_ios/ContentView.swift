@@ -11,6 +11,7 @@ struct ContentView: View {
     @EnvironmentObject var scanner: ScannerManager
     @State private var tab: Tab = .scanner
     @State private var isAuthenticated = false
+    @State private var lastCaptureURL: URL?
 
     var body: some View {
         Group {
@@ -65,18 +66,30 @@ private extension ContentView {
         ScrollView {
             VStack(spacing: 16) {
                 // 読取済みタグ一覧
-                if scanner.scannedUII.isEmpty {
+                HStack {
+                    Text("読取済み: \(scanner.scannedCount)件")
+                        .font(.subheadline)
+                    Spacer()
+                }
+                if scanner.scannedCount == 0 {
                     Text("RFIDをスキャンしてください")
                         .foregroundColor(.secondary)
                         .frame(maxWidth: .infinity, minHeight: 120)
                         .background(Color.gray.opacity(0.1))
                         .cornerRadius(8)
                 } else {
-                    List(scanner.scannedUII, id: \.self) {
-                        Text($0)
+                    // 挿入のみなので添字を id にする（追加分の行だけ作られる）
+                    ScrollView {
+                        LazyVStack(alignment: .leading, spacing: 0) {
+                            ForEach(0..<scanner.scannedCount, id: \.self) { index in
+                                Text(scanner.scannedUII[index].hex)
+                                    .frame(maxWidth: .infinity, minHeight: 44, alignment: .leading)
+                                    .padding(.horizontal)
+                                Divider()
+                            }
+                        }
                     }
-                    .frame(height: min(CGFloat(scanner.scannedUII.count) * 44, CGFloat(300)))
-                    .listStyle(.plain)
+                    .frame(height: min(CGFloat(scanner.scannedCount) * 44, CGFloat(300)))
                 }
 
                 // 操作ボタン
@@ -114,6 +127,37 @@ private extension ContentView {
                     .buttonStyle(.bordered)
                     .controlSize(.small)
                 }
+
+                // 受信イベントの記録 / 再生（現場の読取を持ち帰って再現する用）
+                HStack(spacing: 12) {
+                    Button {
+                        if scanner.isRecording {
+                            lastCaptureURL = scanner.stopRecording()
+                        } else {
+                            scanner.startRecording()
+                        }
+                    } label: {
+                        Image(systemName: scanner.isRecording ? "stop.circle" : "record.circle")
+                        Text(scanner.isRecording ? "記録停止" : "記録開始")
+                    }
+                    .buttonStyle(.bordered)
+                    .tint(scanner.isRecording ? .red : nil)
+                    .controlSize(.small)
+
+                    Button {
+                        if scanner.isReplaying {
+                            scanner.stopReplay()
+                        } else if let url = lastCaptureURL {
+                            try? scanner.replayCapture(at: url)
+                        }
+                    } label: {
+                        Image(systemName: scanner.isReplaying ? "stop.fill" : "play.fill")
+                        Text(scanner.isReplaying ? "再生停止" : "記録を再生")
+                    }
+                    .buttonStyle(.bordered)
+                    .controlSize(.small)
+                    .disabled(lastCaptureURL == nil || scanner.isRecording)
+                }
             }
             .padding(.vertical)
         }
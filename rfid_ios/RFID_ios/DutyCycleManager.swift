@@ -0,0 +1,158 @@
+//
+//  DutyCycleManager.swift
+//  RFID_ios
+//
+//  Created on 2025/05/17.
+//
+//  DutyCycleScheduler に従ってスキャナの読取 / 休止 / 出力 / 省電力を切り替える
+//  停止時に発見タグ数と電池消費を DutyCycleReport として保存する
+//  （Documents/dutycycle-reports.jsonl に 1 行 1 レポートで追記）
+//
+
+import Foundation
+import Combine
+import UIKit
+
+@MainActor
+final class DutyCycleManager: ObservableObject {
+
+    // MARK: - Published -----------------------------------------------------
+    @Published private(set) var isRunning = false
+    @Published private(set) var step: DutyCycleStep?
+    /// 直近 burst の新規ユニークタグ数/秒
+    @Published private(set) var discoveryRate = 0.0
+    @Published private(set) var battery: BatteryBand?
+    @Published private(set) var lastReport: DutyCycleReport?
+    @Published var policy = DutyCyclePolicy()
+
+    // MARK: - Dependencies --------------------------------------------------
+    private let scanner: ScannerManager
+    private var cancellables = Set<AnyCancellable>()
+
+    // MARK: - Run State -----------------------------------------------------
+    private var loopTask: Task<Void, Never>?
+    private var report: DutyCycleReport?
+    private var newUniqueInBurst = 0
+    private var fullPower = 30
+    /// 開始前の拡張省電力モード（stop() で戻す）
+    private var originalPowerSave: PowerSaveLevel = .off
+
+    init(scannerManager: ScannerManager) {
+        self.scanner = scannerManager
+        scannerManager.scannedDelta
+            .sink { [weak self] added in
+                self?.newUniqueInBurst += added.count
+                self?.report?.uniqueTags += added.count
+            }
+            .store(in: &cancellables)
+    }
+
+    // MARK: - Public Controls -----------------------------------------------
+    func start() async {
+        guard !isRunning, scanner.isConnected else { return }
+        if let plan = await scanner.currentPowerPlan() {
+            fullPower = plan.readPower
+            originalPowerSave = plan.powerSave
+        }
+        let band = await scanner.scannerBatteryBand()
+        let scheduler = DutyCycleScheduler(policy: policy, fullPower: fullPower, battery: band ?? .over40)
+
+        UIDevice.current.isBatteryMonitoringEnabled = true
+        var report = DutyCycleReport(policy: policy)
+        report.hostBatteryStart = UIDevice.current.batteryLevel
+        if let band { report.record(band: band, at: 0) }
+        self.report = report
+        battery = band
+        isRunning = true
+        Log.info(.scanner, "[Duty] 開始: \(policy.name) 出力=\(fullPower)dBm 電池=\(band?.label ?? "-")")
+
+        loopTask = Task { [weak self] in await self?.run(scheduler) }
+    }
+
+    func stop() async {
+        guard isRunning else { return }
+        loopTask?.cancel()
+        loopTask = nil
+        isRunning = false
+        await scanner.setReading(false)
+        // 出力と省電力を開始前に戻す
+        await scanner.applyPowerPlan(readPower: fullPower, powerSave: originalPowerSave)
+        finishReport()
+        step = nil
+    }
+
+    // MARK: - Loop ----------------------------------------------------------
+    private func run(_ scheduler: DutyCycleScheduler) async {
+        var applied: DutyCycleStep?
+        var step = scheduler.step
+        while !Task.isCancelled {
+            self.step = step
+            if applied?.readPower != step.readPower || applied?.powerSave != step.powerSave {
+                if await scanner.applyPowerPlan(readPower: step.readPower, powerSave: step.powerSave) {
+                    applied = step
+                }
+            }
+
+            // burst
+            guard !Task.isCancelled else { return }
+            newUniqueInBurst = 0
+            if scanner.readState == .standby { await scanner.setReading(true) }
+            let burstStart = Date()
+            try? await Task.sleep(nanoseconds: UInt64(step.burst * 1_000_000_000))
+            guard !Task.isCancelled else { return }
+            let burstTime = Date().timeIntervalSince(burstStart)
+            report?.readingTime += burstTime
+            report?.bursts += 1
+
+            let band = await scanner.scannerBatteryBand()
+            if let band, let startedAt = report?.startedAt {
+                battery = band
+                let elapsed = Date().timeIntervalSince(startedAt)
+                report?.record(band: band, at: elapsed)
+            }
+            step = scheduler.burstCompleted(newUniqueTags: newUniqueInBurst, duration: burstTime, battery: band)
+            discoveryRate = scheduler.lastRate
+            Log.info(.scanner, String(format: "[Duty] %.1f tags/s → 休止 %.0fs / %lddBm / 省電力 %@",
+                         scheduler.lastRate, step.idle, step.readPower, "\(step.powerSave)"))
+
+            // idle
+            if step.idle > 0 {
+                await scanner.setReading(false)
+                try? await Task.sleep(nanoseconds: UInt64(step.idle * 1_000_000_000))
+            }
+        }
+    }
+
+    // MARK: - Report --------------------------------------------------------
+    private func finishReport() {
+        guard var report else { return }
+        self.report = nil
+        report.duration = Date().timeIntervalSince(report.startedAt)
+        report.hostBatteryEnd = UIDevice.current.batteryLevel
+        lastReport = report
+        Log.info(.scanner, String(format: "[Duty] %@: %ld tags / %.0fs (読取 %.0f%%) / %@ tags/%%",
+                     report.policy.name, report.uniqueTags, report.duration, report.dutyRatio * 100,
+                     report.tagsPerHostPercent.map { String(format: "%.0f", $0) } ?? "-"))
+        append(report)
+    }
+
+    private static var reportURL: URL {
+        FileManager.default.urls(for: .documentDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("dutycycle-reports.jsonl")
+    }
+
+    private func append(_ report: DutyCycleReport) {
+        let encoder = JSONEncoder()
+        encoder.dateEncodingStrategy = .iso8601
+        guard var line = try? encoder.encode(report) else { return }
+        line.append(0x0A)
+        let url = Self.reportURL
+        if let handle = try? FileHandle(forWritingTo: url) {
+            handle.seekToEndOfFile()
+            handle.write(line)
+            try? handle.close()
+        } else {
+            try? line.write(to: url)
+        }
+    }
+}
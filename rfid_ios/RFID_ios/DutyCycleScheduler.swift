@@ -0,0 +1,166 @@
+//
+//  DutyCycleScheduler.swift
+//  RFID_ios
+//
+//  Created on 2025/05/17.
+//
+//  長時間の棚卸し向けの間欠読取の方針
+//    • 読取（burst）→ 休止（idle）を繰り返し、burst 毎の新規ユニーク数で次を決める
+//    • 新規が多い間は休止なし・最大出力、出尽くしたら休止を倍々に延ばし出力を下げる
+//    • 拡張省電力モードはスキャナの電池残量で切り替える
+//  新しい棚に移ると発見レートが上がるので、その時点で最大出力・連続読取に戻る
+//  SDK には依存しない
+//
+
+import Foundation
+
+/// スキャナの電池残量（SDK の CommBattery は 3 段階）
+enum BatteryBand: Int, Codable, CaseIterable {
+    case under10, under40, over40
+
+    var label: String {
+        switch self {
+        case .under10: return "10%未満"
+        case .under40: return "40%未満"
+        case .over40:  return "40%以上"
+        }
+    }
+}
+
+/// RFIDScannerScan.powerSaveExt
+enum PowerSaveLevel: Int, Codable, CaseIterable {
+    case off, mode1, mode2
+}
+
+struct DutyCyclePolicy: Codable, Equatable {
+    /// 比較用の名前（レポートに残す）
+    var name = "default"
+    /// 1 回の読取時間
+    var burst: TimeInterval = 4
+    var minIdle: TimeInterval = 1
+    var maxIdle: TimeInterval = 30
+    /// これ以上（件/秒）なら休止せず読み続ける
+    var activeRate = 5.0
+    /// これ以下（件/秒）なら出尽くしとみなす
+    var saturatedRate = 0.5
+    /// 出尽くし時に 1 burst 毎に下げる出力 (dBm) と下限
+    var powerStep = 4
+    var minPower = 14
+    /// 電池残量毎の拡張省電力モード
+    var powerSaveOver40: PowerSaveLevel = .off
+    var powerSaveUnder40: PowerSaveLevel = .mode1
+    var powerSaveUnder10: PowerSaveLevel = .mode2
+
+    func powerSave(for band: BatteryBand) -> PowerSaveLevel {
+        switch band {
+        case .over40:  return powerSaveOver40
+        case .under40: return powerSaveUnder40
+        case .under10: return powerSaveUnder10
+        }
+    }
+}
+
+/// 次の 1 周期
+struct DutyCycleStep: Equatable {
+    var burst: TimeInterval
+    /// 0 なら読取を止めずに次の burst へ
+    var idle: TimeInterval
+    var readPower: Int
+    var powerSave: PowerSaveLevel
+}
+
+final class DutyCycleScheduler {
+
+    let policy: DutyCyclePolicy
+    let fullPower: Int
+    private(set) var step: DutyCycleStep
+    /// 直近 burst の発見レート（件/秒）
+    private(set) var lastRate = 0.0
+
+    init(policy: DutyCyclePolicy = DutyCyclePolicy(), fullPower: Int, battery: BatteryBand = .over40) {
+        self.policy = policy
+        self.fullPower = fullPower
+        self.step = DutyCycleStep(burst: policy.burst, idle: 0, readPower: fullPower,
+                                  powerSave: policy.powerSave(for: battery))
+    }
+
+    /// burst 1 回分の結果を渡し、次の周期を受け取る（battery が nil なら前回のまま）
+    @discardableResult
+    func burstCompleted(newUniqueTags: Int, duration: TimeInterval, battery: BatteryBand?) -> DutyCycleStep {
+        let rate = duration > 0 ? Double(newUniqueTags) / duration : 0
+        lastRate = rate
+        var next = step
+
+        if rate >= policy.activeRate {
+            next.idle = 0
+            next.readPower = fullPower
+        } else if rate <= policy.saturatedRate {
+            next.idle = min(max(step.idle * 2, policy.minIdle), policy.maxIdle)
+            next.readPower = max(step.readPower - policy.powerStep, min(policy.minPower, fullPower))
+        } else {
+            // まだ少しずつ見つかっている。休止は最短、出力は据え置き
+            next.idle = policy.minIdle
+        }
+        if let battery { next.powerSave = policy.powerSave(for: battery) }
+        step = next
+        return next
+    }
+}
+
+// MARK: - Report -------------------------------------------------------------
+
+/// 間欠読取 1 回分（開始〜停止）の記録。方針の比較に使う
+struct DutyCycleReport: Codable, Equatable {
+    let policy: DutyCyclePolicy
+    let startedAt: Date
+    var duration: TimeInterval = 0
+    /// 読取していた時間（休止を除く）
+    var readingTime: TimeInterval = 0
+    var bursts = 0
+    var uniqueTags = 0
+    /// 端末の電池残量 (0〜1)
+    var hostBatteryStart: Float?
+    var hostBatteryEnd: Float?
+    /// スキャナの電池残量が変わった時点（経過秒と、それまでに見つけたタグ数）
+    var scannerBattery: [BandChange] = []
+
+    struct BandChange: Codable, Equatable {
+        let band: BatteryBand
+        let elapsed: TimeInterval
+        let uniqueTags: Int
+    }
+
+    init(policy: DutyCyclePolicy, startedAt: Date = Date()) {
+        self.policy = policy
+        self.startedAt = startedAt
+    }
+
+    var dutyRatio: Double { duration > 0 ? readingTime / duration : 0 }
+
+    /// 端末電池 1% あたりの発見タグ数。消費が 1% 未満なら nil
+    var tagsPerHostPercent: Double? {
+        guard let start = hostBatteryStart, let end = hostBatteryEnd, start >= 0, end >= 0 else { return nil }
+        let used = Double(start - end) * 100
+        return used >= 1 ? Double(uniqueTags) / used : nil
+    }
+
+    mutating func record(band: BatteryBand, at elapsed: TimeInterval) {
+        guard scannerBattery.last?.band != band else { return }
+        scannerBattery.append(BandChange(band: band, elapsed: elapsed, uniqueTags: uniqueTags))
+    }
+
+    /// 電池残量の段階毎の発見タグ数/時（次の段階へ移るまで）。スキャナは 3 段階しか返さないのでこの粒度
+    var tagsPerHourByBand: [BatteryBand: Double] {
+        var tags: [BatteryBand: Int] = [:]
+        var time: [BatteryBand: TimeInterval] = [:]
+        let marks = scannerBattery + [BandChange(band: scannerBattery.last?.band ?? .over40,
+                                                 elapsed: duration, uniqueTags: uniqueTags)]
+        for (from, to) in zip(marks, marks.dropFirst()) {
+            tags[from.band, default: 0] += to.uniqueTags - from.uniqueTags
+            time[from.band, default: 0] += to.elapsed - from.elapsed
+        }
+        return time.filter { $0.value > 0 }.reduce(into: [:]) { result, entry in
+            result[entry.key] = Double(tags[entry.key] ?? 0) / (entry.value / 3600)
+        }
+    }
+}
@@ -0,0 +1,169 @@
+//
+//  EPC.swift
+//  RFID_ios
+//
+//  Created on 2025/05/07.
+//
+//  UII(EPC) を 16 byte 固定長でインライン保持する値型
+//    • EPC-96 / EPC-128 をヒープ確保なしで保持
+//    • ハッシュ・比較は UInt64 ×2 のみ
+//    • 16進文字列への変換はテーブル引き（表示 / Supabase 境界でのみ使用）
+//
+
+import Foundation
+
+struct EPC: Hashable {
+
+    /// 保持できる最大バイト長（EPC-128）
+    static let maxByteCount = 16
+
+    /// 先頭 8 byte（ビッグエンディアン）
+    private let hi: UInt64
+    /// 後半 8 byte（ビッグエンディアン、未使用部は 0）
+    private let lo: UInt64
+    /// 有効バイト長
+    let count: Int
+
+    // MARK: - Init ---------------------------------------------------------
+    /// 16 byte を超える UII は保持できないため nil
+    init?(bytes: UnsafeRawBufferPointer) {
+        guard bytes.count <= EPC.maxByteCount else { return nil }
+        var h: UInt64 = 0
+        var l: UInt64 = 0
+        for i in 0..<bytes.count {
+            let b = UInt64(bytes[i])
+            if i < 8 { h |= b << (56 - 8 * i) } else { l |= b << (56 - 8 * (i - 8)) }
+        }
+        hi = h
+        lo = l
+        count = bytes.count
+    }
+
+    init?(data: Data) {
+        guard let epc = data.withUnsafeBytes({ EPC(bytes: $0) }) else { return nil }
+        self = epc
+    }
+
+    init?(bytes: [UInt8]) {
+        guard let epc = bytes.withUnsafeBytes({ EPC(bytes: $0) }) else { return nil }
+        self = epc
+    }
+
+    /// 16進文字列（大文字/小文字どちらも可）から生成。不正な文字列は nil
+    init?(hex: String) {
+        var hex = hex
+        guard let epc = hex.withUTF8({ EPC(hexBytes: $0) }) else { return nil }
+        self = epc
+    }
+
+    private init?(hexBytes: UnsafeBufferPointer<UInt8>) {
+        let n = hexBytes.count
+        guard n % 2 == 0, n / 2 <= EPC.maxByteCount else { return nil }
+        var h: UInt64 = 0
+        var l: UInt64 = 0
+        for i in 0..<(n / 2) {
+            let upper = EPC.hexValues[Int(hexBytes[2 * i])]
+            let lower = EPC.hexValues[Int(hexBytes[2 * i + 1])]
+            guard upper != 0xFF, lower != 0xFF else { return nil }
+            let b = UInt64(upper << 4 | lower)
+            if i < 8 { h |= b << (56 - 8 * i) } else { l |= b << (56 - 8 * (i - 8)) }
+        }
+        hi = h
+        lo = l
+        count = n / 2
+    }
+
+    // MARK: - Access -------------------------------------------------------
+    subscript(i: Int) -> UInt8 {
+        precondition(i >= 0 && i < count, "EPC index out of range")
+        return i < 8 ? UInt8(truncatingIfNeeded: hi >> (56 - 8 * i))
+                     : UInt8(truncatingIfNeeded: lo >> (56 - 8 * (i - 8)))
+    }
+
+    var bytes: [UInt8] { (0..<count).map { self[$0] } }
+
+    var data: Data { Data(bytes) }
+
+    /// 大文字 16 進文字列（表示・DB 用）
+    var hex: String {
+        String(unsafeUninitializedCapacity: count * 2) { buf in
+            EPC.hexDigits.withUnsafeBufferPointer { digits in
+                for i in 0..<count {
+                    let b = self[i]
+                    buf[2 * i]     = digits[Int(b >> 4)]
+                    buf[2 * i + 1] = digits[Int(b & 0x0F)]
+                }
+            }
+            return count * 2
+        }
+    }
+
+    // MARK: - Prefix -------------------------------------------------------
+    /// 先頭から一致しているビット数（短い方の長さが上限）
+    func commonPrefixBitLength(with other: EPC) -> Int {
+        let limit = min(count, other.count) * 8
+        let hiDiff = hi ^ other.hi
+        let bits = hiDiff != 0 ? hiDiff.leadingZeroBitCount
+                               : 64 + (lo ^ other.lo).leadingZeroBitCount
+        return min(bits, limit)
+    }
+
+    /// 先頭 bitLength ビットだけを残し、以降を 0 にしたもの
+    func prefix(bitLength: Int) -> EPC {
+        let bits = min(max(bitLength, 0), count * 8)
+        let h = bits >= 64 ? hi : (bits == 0 ? 0 : hi & ~(UInt64.max >> bits))
+        let l = bits <= 64 ? 0 : (bits >= 128 ? lo : lo & ~(UInt64.max >> (bits - 64)))
+        return EPC(hi: h, lo: l, count: (bits + 7) / 8)
+    }
+
+    private init(hi: UInt64, lo: UInt64, count: Int) {
+        self.hi = hi
+        self.lo = lo
+        self.count = count
+    }
+
+    // MARK: - Fingerprint --------------------------------------------------
+    /// フィルタ用の 64bit ハッシュ（Hasher と違って起動毎に変わらない）
+    var fingerprint: UInt64 {
+        EPC.mix(EPC.mix(hi ^ UInt64(count)) ^ lo)
+    }
+
+    /// splitmix64 の仕上げ
+    private static func mix(_ value: UInt64) -> UInt64 {
+        var x = value &+ 0x9E37_79B9_7F4A_7C15
+        x = (x ^ (x >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        x = (x ^ (x >> 27)) &* 0x94D0_49BB_1331_11EB
+        return x ^ (x >> 31)
+    }
+
+    // MARK: - Hashable -----------------------------------------------------
+    func hash(into hasher: inout Hasher) {
+        hasher.combine(hi)
+        hasher.combine(lo ^ UInt64(count))
+    }
+
+    // MARK: - Tables -------------------------------------------------------
+    private static let hexDigits: [UInt8] = Array("0123456789ABCDEF".utf8)
+
+    /// ASCII → 4bit 値（不正文字は 0xFF）
+    private static let hexValues: [UInt8] = {
+        var table = [UInt8](repeating: 0xFF, count: 256)
+        for (i, c) in "0123456789".utf8.enumerated() { table[Int(c)] = UInt8(i) }
+        for (i, c) in "ABCDEF".utf8.enumerated() { table[Int(c)] = UInt8(10 + i) }
+        for (i, c) in "abcdef".utf8.enumerated() { table[Int(c)] = UInt8(10 + i) }
+        return table
+    }()
+}
+
+/// バイト列の辞書順（同じ先頭なら短い方が前）
+extension EPC: Comparable {
+    static func < (lhs: EPC, rhs: EPC) -> Bool {
+        if lhs.hi != rhs.hi { return lhs.hi < rhs.hi }
+        if lhs.lo != rhs.lo { return lhs.lo < rhs.lo }
+        return lhs.count < rhs.count
+    }
+}
+
+extension EPC: CustomStringConvertible {
+    var description: String { hex }
+}
@@ -0,0 +1,208 @@
+//
+//  HotPathMetrics.swift
+//  RFID_ios
+//
+//  Created on 2025/05/18.
+//
+//  タグ読取 → DB 更新 までの区間計測
+//    • 区間毎の固定バケット遅延ヒストグラム（μs）
+//    • 件数カウンタ
+//    • Instruments 用の signpost 区間（os が使える環境のみ）
+//  snapshot() / exportJSON() で取り出し、テストや設定画面から予算と比べる
+//  記録側は区間毎に別ロック（各区間は 1 つのキュー/スレッドからしか書かれないので競合しない）
+//
+
+import Foundation
+#if canImport(os)
+import os
+#endif
+
+// MARK: - Histogram ------------------------------------------------------------
+
+/// 固定バケットの遅延ヒストグラム。バケットは上限値（μs）、最後は上限なし
+struct LatencyHistogram: Codable, Equatable {
+    static let bucketUpperBoundsMicros: [Int] = [
+        50, 100, 250, 500,
+        1_000, 2_500, 5_000, 10_000, 25_000, 50_000,
+        100_000, 250_000, 500_000, 1_000_000, 2_500_000, 5_000_000,
+    ]
+
+    /// bucketUpperBoundsMicros.count + 1 個（最後は超過分）
+    private(set) var counts = [Int](repeating: 0, count: LatencyHistogram.bucketUpperBoundsMicros.count + 1)
+    private(set) var count = 0
+    private(set) var sumMicros = 0
+    private(set) var maxMicros = 0
+
+    mutating func record(micros: Int) {
+        let micros = max(micros, 0)
+        let bounds = LatencyHistogram.bucketUpperBoundsMicros
+        // 二分探索: micros 以上の最初の上限
+        var lo = 0, hi = bounds.count
+        while lo < hi {
+            let mid = (lo + hi) / 2
+            if bounds[mid] < micros { lo = mid + 1 } else { hi = mid }
+        }
+        counts[lo] += 1
+        count += 1
+        sumMicros += micros
+        maxMicros = max(maxMicros, micros)
+    }
+
+    var meanMicros: Double { count > 0 ? Double(sumMicros) / Double(count) : 0 }
+
+    /// p (0〜1) 分位が入るバケットの上限（μs）。超過バケットなら最大値
+    func percentileMicros(_ p: Double) -> Int {
+        guard count > 0 else { return 0 }
+        let rank = max(Int((Double(count) * p).rounded(.up)), 1)
+        var seen = 0
+        for (i, c) in counts.enumerated() {
+            seen += c
+            if seen >= rank {
+                return i < LatencyHistogram.bucketUpperBoundsMicros.count
+                    ? min(LatencyHistogram.bucketUpperBoundsMicros[i], maxMicros)
+                    : maxMicros
+            }
+        }
+        return maxMicros
+    }
+}
+
+// MARK: - Metrics --------------------------------------------------------------
+
+final class HotPathMetrics: @unchecked Sendable {
+
+    /// アプリ全体で使う計測先（テストでは個別に生成して注入する）
+    static let shared = HotPathMetrics()
+
+    /// 計測区間
+    enum Stage: String, CaseIterable, Codable {
+        /// SDK コールバック受信 → 重複排除完了
+        case callbackToDedup
+        /// 重複排除完了 → scannedUII へ反映
+        case dedupToPublish
+        /// scannedUII へ反映 → マスター照合完了
+        case publishToMatch
+        /// マスター照合 → Supabase 更新の応答
+        case matchToPersist
+        /// SDK コールバック受信 → 探索音の更新
+        case readToFeedback
+        /// マスター読込み開始 → 照合できる状態（スナップショット・最初のページ・端末ストアのいずれか）
+        case loadToMatchable
+    }
+
+    enum Counter: String, CaseIterable, Codable {
+        case sdkCallbacks
+        case readsDeduped
+        case tagsPublished
+        case tagsMatched
+        case persistRequests
+        case persistFailures
+    }
+
+    struct Snapshot: Codable, Equatable {
+        var capturedAt: Date
+        var histograms: [String: LatencyHistogram]
+        var counters: [String: Int]
+
+        func histogram(_ stage: Stage) -> LatencyHistogram {
+            histograms[stage.rawValue] ?? LatencyHistogram()
+        }
+
+        func counter(_ counter: Counter) -> Int {
+            counters[counter.rawValue] ?? 0
+        }
+    }
+
+    private final class Slot<Value> {
+        let lock = NSLock()
+        var value: Value
+        init(_ value: Value) { self.value = value }
+    }
+
+    private let histograms: [Stage: Slot<LatencyHistogram>]
+    private let counters: [Counter: Slot<Int>]
+
+    #if canImport(os)
+    private let signposter = OSSignposter(subsystem: "rfid_ios", category: "HotPath")
+    #endif
+
+    init() {
+        histograms = Dictionary(uniqueKeysWithValues: Stage.allCases.map { ($0, Slot(LatencyHistogram())) })
+        counters = Dictionary(uniqueKeysWithValues: Counter.allCases.map { ($0, Slot(0)) })
+    }
+
+    // MARK: - Record -------------------------------------------------------
+    func record(_ stage: Stage, seconds: TimeInterval) {
+        guard let slot = histograms[stage] else { return }
+        let micros = Int(seconds * 1_000_000)
+        slot.lock.lock()
+        slot.value.record(micros: micros)
+        slot.lock.unlock()
+    }
+
+    func record(_ stage: Stage, since start: Date, now: Date = Date()) {
+        record(stage, seconds: now.timeIntervalSince(start))
+    }
+
+    func increment(_ counter: Counter, by amount: Int = 1) {
+        guard let slot = counters[counter] else { return }
+        slot.lock.lock()
+        slot.value += amount
+        slot.lock.unlock()
+    }
+
+    // MARK: - Signpost -----------------------------------------------------
+    /// Instruments に区間を出す。os が無い環境では body を実行するだけ
+    func interval<T>(_ name: StaticString, _ body: () throws -> T) rethrows -> T {
+        #if canImport(os)
+        let state = signposter.beginInterval(name, id: signposter.makeSignpostID())
+        defer { signposter.endInterval(name, state) }
+        #endif
+        return try body()
+    }
+
+    func interval<T>(_ name: StaticString, _ body: () async throws -> T) async rethrows -> T {
+        #if canImport(os)
+        let state = signposter.beginInterval(name, id: signposter.makeSignpostID())
+        defer { signposter.endInterval(name, state) }
+        #endif
+        return try await body()
+    }
+
+    // MARK: - Export -------------------------------------------------------
+    func snapshot(now: Date = Date()) -> Snapshot {
+        var h: [String: LatencyHistogram] = [:]
+        for (stage, slot) in histograms {
+            slot.lock.lock()
+            h[stage.rawValue] = slot.value
+            slot.lock.unlock()
+        }
+        var c: [String: Int] = [:]
+        for (counter, slot) in counters {
+            slot.lock.lock()
+            c[counter.rawValue] = slot.value
+            slot.lock.unlock()
+        }
+        return Snapshot(capturedAt: now, histograms: h, counters: c)
+    }
+
+    func exportJSON() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        encoder.dateEncodingStrategy = .iso8601
+        return try encoder.encode(snapshot())
+    }
+
+    func reset() {
+        for slot in histograms.values {
+            slot.lock.lock()
+            slot.value = LatencyHistogram()
+            slot.lock.unlock()
+        }
+        for slot in counters.values {
+            slot.lock.lock()
+            slot.value = 0
+            slot.lock.unlock()
+        }
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  HotPathMetricsView.swift
+//  RFID_ios
+//
+//  Created on 2025/05/18.
+//
+//  区間計測（HotPathMetrics）の確認と JSON 書き出し用のデバッグ画面
+//
+
+import SwiftUI
+
+struct HotPathMetricsView: View {
+
+    var metrics: HotPathMetrics = .shared
+
+    @State private var snapshot: HotPathMetrics.Snapshot?
+    @State private var exportURL: URL?
+
+    var body: some View {
+        Form {
+            Section(header: Text("Latency (p50 / p95 / p99 / max)")) {
+                ForEach(HotPathMetrics.Stage.allCases, id: \.self) { stage in
+                    let histogram = snapshot?.histogram(stage) ?? LatencyHistogram()
+                    VStack(alignment: .leading, spacing: 2) {
+                        Text(stage.rawValue)
+                        Text(histogramText(histogram))
+                            .font(.caption.monospacedDigit())
+                            .foregroundColor(.secondary)
+                    }
+                }
+            }
+
+            Section(header: Text("Counters")) {
+                ForEach(HotPathMetrics.Counter.allCases, id: \.self) { counter in
+                    HStack {
+                        Text(counter.rawValue)
+                        Spacer()
+                        Text("\(snapshot?.counter(counter) ?? 0)")
+                            .font(.body.monospacedDigit())
+                            .foregroundColor(.secondary)
+                    }
+                }
+            }
+
+            Section {
+                Button("Refresh") { refresh() }
+                Button("Export JSON") { export() }
+                if let exportURL {
+                    ShareLink(item: exportURL) {
+                        Label(exportURL.lastPathComponent, systemImage: "square.and.arrow.up")
+                    }
+                }
+                Button("Reset", role: .destructive) {
+                    metrics.reset()
+                    refresh()
+                }
+            }
+        }
+        .navigationTitle("Hot Path")
+        .onAppear { refresh() }
+    }
+
+    private func refresh() {
+        snapshot = metrics.snapshot()
+    }
+
+    private func export() {
+        do {
+            let data = try metrics.exportJSON()
+            let url = FileManager.default.temporaryDirectory.appendingPathComponent("hotpath-metrics.json")
+            try data.write(to: url, options: .atomic)
+            exportURL = url
+            Log.info(.ingest, "[Metrics] 書き出し: \(url.path)")
+        } catch {
+            Log.warning(.ingest, "[Metrics] 書き出し失敗: \(error.localizedDescription)")
+        }
+    }
+
+    private func histogramText(_ h: LatencyHistogram) -> String {
+        guard h.count > 0 else { return "-" }
+        return String(format: "%@ / %@ / %@ / %@  ×%ld",
+                      millis(h.percentileMicros(0.5)), millis(h.percentileMicros(0.95)),
+                      millis(h.percentileMicros(0.99)), millis(h.maxMicros), h.count)
+    }
+
+    private func millis(_ micros: Int) -> String {
+        String(format: "%.1fms", Double(micros) / 1000)
+    }
+}
@@ -0,0 +1,176 @@
+//
+//  HuntList.swift
+//  RFID_ios
+//
+//  Created on 2025/05/21.
+//
+//  未読込タグをまとめて探すための近さランキング
+//    • 対象 UII 毎に RSSI を平滑化（OneEuroFilter）し、ゆっくりした平均との差で近づいている / 離れているを出す
+//    • 順位のキーは「平滑 RSSI − 経過秒 × decayPerSecond」。全タグ同じ速さで減衰するので
+//      rssi + decayPerSecond × lastSeen で比べれば読取が無い間は順位が変わらない
+//    • 読取のあったタグだけを隣と入れ替えて位置を直す（毎回の全件ソートはしない）
+//    • 初めて読めたタグは onFound で知らせる（SDK スレッド上、ロック外）
+//
+
+import Foundation
+
+final class HuntList: @unchecked Sendable {
+
+    enum Trend: Equatable {
+        case approaching, receding, steady
+    }
+
+    struct Entry: Equatable {
+        let uii: EPC
+        /// 平滑化後の RSSI（未検出は nil）
+        var rssi: Double?
+        var peakRSSI: Double?
+        var lastSeen: TimeInterval?
+        var readCount = 0
+        /// 表示時点の近さ（0〜1、減衰込み）
+        var proximity = 0.0
+        var trend = Trend.steady
+        var isLost = true
+    }
+
+    let calibration: LocateCalibration
+    /// 読めていない間の順位の下げ幅 (dB/秒)
+    let decayPerSecond: Double
+    /// この時間読めなければ見失い扱い
+    let staleAfter: TimeInterval
+    /// 近づいている / 離れていると判断する平均との差 (dB)
+    let trendThreshold: Double
+    var onFound: ((EPC) -> Void)?
+
+    private struct Track {
+        var filter = OneEuroFilter()
+        /// 数秒単位の平均（傾向の基準）
+        var slowRSSI: Double?
+    }
+
+    private let lock = NSLock()
+    private var entries: [Entry]
+    private var tracks: [Track]
+    private let indexByUII: [EPC: Int]
+    /// 検出済みタグの順位（entries の添字、キーの降順）
+    private var order: [Int] = []
+    /// entries の添字 → order 上の位置（未検出は nil）
+    private var position: [Int?]
+    private(set) var ignoredReads = 0
+
+    init(targets: [EPC],
+         calibration: LocateCalibration = LocateCalibration(),
+         decayPerSecond: Double = 6,
+         staleAfter: TimeInterval = 3,
+         trendThreshold: Double = 3) {
+        let unique = Array(Set(targets)).sorted()
+        entries = unique.map { Entry(uii: $0) }
+        tracks = Array(repeating: Track(), count: unique.count)
+        position = Array(repeating: nil, count: unique.count)
+        indexByUII = Dictionary(uniqueKeysWithValues: unique.enumerated().map { ($1, $0) })
+        self.calibration = calibration
+        self.decayPerSecond = decayPerSecond
+        self.staleAfter = staleAfter
+        self.trendThreshold = trendThreshold
+    }
+
+    var targetCount: Int { entries.count }
+
+    var foundCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return order.count
+    }
+
+    // MARK: - Ingest -------------------------------------------------------
+    /// 読取 1 件。対象タグなら true
+    @discardableResult
+    func ingest(uii data: Data, rssi: Int, at t: TimeInterval) -> Bool {
+        guard let uii = EPC(data: data) else { return false }
+        lock.lock()
+        guard let i = indexByUII[uii] else {
+            ignoredReads += 1
+            lock.unlock()
+            return false
+        }
+        var track = tracks[i]
+        if let lastSeen = entries[i].lastSeen, t - lastSeen > staleAfter {
+            track = Track()
+        }
+        let smoothed = track.filter.filter(Double(rssi), at: t)
+        // 時定数 1.5 秒の指数平均
+        if let slow = track.slowRSSI, let lastSeen = entries[i].lastSeen {
+            let a = 1 - exp(-max(t - lastSeen, 0.001) / 1.5)
+            track.slowRSSI = slow + a * (smoothed - slow)
+        } else {
+            track.slowRSSI = smoothed
+        }
+        tracks[i] = track
+
+        entries[i].rssi = smoothed
+        entries[i].peakRSSI = max(entries[i].peakRSSI ?? smoothed, smoothed)
+        entries[i].lastSeen = max(entries[i].lastSeen ?? t, t)
+        entries[i].readCount += 1
+        let diff = smoothed - (track.slowRSSI ?? smoothed)
+        entries[i].trend = diff > trendThreshold ? .approaching : diff < -trendThreshold ? .receding : .steady
+
+        let isNew = position[i] == nil
+        if isNew {
+            order.append(i)
+            position[i] = order.count - 1
+        }
+        reposition(i)
+        lock.unlock()
+
+        if isNew { onFound?(uii) }
+        return true
+    }
+
+    // MARK: - Read ---------------------------------------------------------
+    /// 検出済みタグを近い順に（now 時点の近さ・見失いを反映）
+    func ranked(at now: TimeInterval) -> [Entry] {
+        lock.lock()
+        defer { lock.unlock() }
+        return order.map { i in
+            var entry = entries[i]
+            let age = max(now - (entry.lastSeen ?? now), 0)
+            entry.isLost = age > staleAfter
+            entry.proximity = calibration.proximity(rssi: (entry.rssi ?? calibration.floorRSSI) - decayPerSecond * age)
+            if entry.isLost { entry.trend = .steady }
+            return entry
+        }
+    }
+
+    /// まだ一度も読めていない対象
+    func undetected() -> [EPC] {
+        lock.lock()
+        defer { lock.unlock() }
+        return entries.indices.filter { position[$0] == nil }.map { entries[$0].uii }
+    }
+
+    // MARK: - Order --------------------------------------------------------
+    /// lock 内で呼ぶ
+    private func key(_ i: Int) -> Double {
+        (entries[i].rssi ?? -.infinity) + decayPerSecond * (entries[i].lastSeen ?? 0)
+    }
+
+    /// 値が変わった 1 件を隣との入れ替えで正しい位置へ動かす（lock 内で呼ぶ）
+    private func reposition(_ i: Int) {
+        guard var p = position[i] else { return }
+        let k = key(i)
+        while p > 0, key(order[p - 1]) < k {
+            move(from: p, to: p - 1)
+            p -= 1
+        }
+        while p < order.count - 1, key(order[p + 1]) > k {
+            move(from: p, to: p + 1)
+            p += 1
+        }
+    }
+
+    private func move(from p: Int, to q: Int) {
+        order.swapAt(p, q)
+        position[order[p]] = p
+        position[order[q]] = q
+    }
+}
@@ -0,0 +1,105 @@
+//
+//  HuntListView.swift
+//  RFID_ios
+//
+//  Created on 2025/05/21.
+//
+//  未読込タグの一括探索画面（近い順の一覧）
+//
+
+import SwiftUI
+
+struct HuntListView: View {
+    @EnvironmentObject var cmp: CompareMasterManager
+    @EnvironmentObject var scanner: ScannerManager
+    @EnvironmentObject var huntManager: HuntManager
+
+    var body: some View {
+        List {
+            Section {
+                HStack {
+                    Text("発見 \(huntManager.targetCount - huntManager.undetectedCount) / \(huntManager.targetCount)")
+                        .font(.headline)
+                    Spacer()
+                    Button {
+                        Task {
+                            if huntManager.isHunting {
+                                await huntManager.stop()
+                            } else {
+                                await huntManager.start()
+                            }
+                        }
+                    } label: {
+                        Label(huntManager.isHunting ? "停止" : "探索開始",
+                              systemImage: huntManager.isHunting ? "stop.circle" : "dot.radiowaves.left.and.right")
+                    }
+                    .buttonStyle(.borderedProminent)
+                    .disabled(!huntManager.isHunting && (cmp.counts.uncounted == 0 || !scanner.isConnected))
+                }
+            }
+
+            Section("近い順") {
+                if huntManager.ranked.isEmpty {
+                    Text(huntManager.isHunting ? "フロアを歩いて電波を拾ってください" : "探索を開始すると未読込タグを近い順に表示します")
+                        .foregroundColor(.secondary)
+                }
+                ForEach(huntManager.ranked, id: \.uii) { entry in
+                    NavigationLink {
+                        ItemLocateView(target: entry.uii, itemName: cmp.itemName(for: entry.uii))
+                    } label: {
+                        HuntRow(entry: entry,
+                                name: cmp.itemName(for: entry.uii),
+                                isInventoried: cmp.isInventoried(entry.uii))
+                    }
+                }
+            }
+        }
+        .listStyle(.insetGrouped)
+        .navigationTitle("探索リスト")
+        .onDisappear {
+            // 1 件探索（ItemLocateView）へ移るときも RSSI の受け口を空ける
+            Task { await huntManager.stop() }
+        }
+    }
+}
+
+private struct HuntRow: View {
+    let entry: HuntList.Entry
+    let name: String?
+    let isInventoried: Bool
+
+    var body: some View {
+        HStack(spacing: 12) {
+            Image(systemName: isInventoried ? "checkmark.circle.fill" : "circle")
+                .foregroundColor(isInventoried ? .green : .secondary)
+
+            VStack(alignment: .leading, spacing: 4) {
+                Text(name ?? entry.uii.hex)
+                    .lineLimit(1)
+                ProgressView(value: entry.proximity)
+                    .tint(entry.isLost ? .gray : .orange)
+                Text(detail)
+                    .font(.caption.monospacedDigit())
+                    .foregroundColor(.secondary)
+            }
+
+            Image(systemName: trendSymbol)
+                .foregroundColor(entry.trend == .approaching ? .green : entry.trend == .receding ? .red : .secondary)
+        }
+        .padding(.vertical, 2)
+    }
+
+    private var detail: String {
+        let rssi = entry.rssi.map { String(format: "%.0f", $0) } ?? "-"
+        return entry.isLost ? "見失い（最大 \(entry.peakRSSI.map { String(format: "%.0f", $0) } ?? "-")）"
+                            : "RSSI \(rssi) / \(entry.readCount)回"
+    }
+
+    private var trendSymbol: String {
+        switch entry.trend {
+        case .approaching: return "arrow.up.right"
+        case .receding:    return "arrow.down.right"
+        case .steady:      return "minus"
+        }
+    }
+}
@@ -0,0 +1,116 @@
+//
+//  HuntManager.swift
+//  RFID_ios
+//
+//  Created on 2025/05/21.
+//
+//  未読込タグの一括探索モード
+//    • 開始時点の uncountedTags を探索対象にし、Select フィルタを対象だけに絞る
+//    • セッションは S0（読めたタグも応答し続けるので RSSI の推移が取れる）
+//    • 初めて読めたタグはその場で棚卸し済みにする（通常の読取経路を待たない）
+//    • 一覧は 5Hz で近い順に更新。終了時にフィルタと読取設定を元に戻す
+//
+
+import Foundation
+import UIKit
+
+@MainActor
+final class HuntManager: ObservableObject {
+
+    // MARK: - Published -----------------------------------------------------
+    @Published private(set) var isHunting = false
+    @Published private(set) var ranked: [HuntList.Entry] = []
+    @Published private(set) var targetCount = 0
+    @Published private(set) var undetectedCount = 0
+
+    /// 一覧の更新間隔
+    static let refreshInterval: TimeInterval = 0.2
+
+    // MARK: - Dependencies --------------------------------------------------
+    private let scanner: ScannerManager
+    private let compare: CompareMasterManager
+    private let feedback = UINotificationFeedbackGenerator()
+
+    // MARK: - Run State -----------------------------------------------------
+    private var hunt: HuntList?
+    private var refreshTask: Task<Void, Never>?
+    private var savedProfile: ScanProfile?
+    private var savedMasks: [SelectMask] = []
+
+    init(scannerManager: ScannerManager, compareManager: CompareMasterManager) {
+        self.scanner = scannerManager
+        self.compare = compareManager
+    }
+
+    // MARK: - Public Controls -----------------------------------------------
+    func start() async {
+        guard !isHunting else { return }
+        let targets = compare.uncountedTags
+        guard !targets.isEmpty else { return }
+        Log.info(.compare, "[Hunt] 開始: 対象 \(targets.count) 件")
+
+        if scanner.readState == .reading { await scanner.setReading(false) }
+        savedMasks = scanner.selectFilter
+        savedProfile = await scanner.currentScanProfile()
+        await scanner.applySelectFilter(SelectMaskPlanner.plan(covering: targets, maxMasks: CompareMasterManager.maxSelectMasks))
+        if let saved = savedProfile, saved.session != .s0 {
+            var profile = saved
+            profile.session = .s0
+            await scanner.applyScanProfile(profile)
+        }
+
+        let hunt = HuntList(targets: targets)
+        hunt.onFound = { [weak self] uii in
+            Task { @MainActor in self?.found(uii) }
+        }
+        scanner.setRSSITap { uii, rssi, receivedAt in
+            hunt.ingest(uii: uii, rssi: rssi, at: receivedAt)
+        }
+        self.hunt = hunt
+        targetCount = hunt.targetCount
+        undetectedCount = hunt.targetCount
+        ranked = []
+        isHunting = true
+        feedback.prepare()
+
+        if scanner.isConnected { await scanner.setReading(true) }
+        startRefresh()
+    }
+
+    func stop() async {
+        guard isHunting else { return }
+        refreshTask?.cancel()
+        refreshTask = nil
+        scanner.setRSSITap(nil)
+        isHunting = false
+        hunt = nil
+
+        if scanner.readState == .reading { await scanner.setReading(false) }
+        await scanner.applySelectFilter(savedMasks)
+        if let savedProfile { await scanner.applyScanProfile(savedProfile) }
+        savedProfile = nil
+        Log.info(.compare, "[Hunt] 終了: 発見 \(targetCount - undetectedCount)/\(targetCount) 件")
+    }
+
+    // MARK: - Found ---------------------------------------------------------
+    private func found(_ uii: EPC) {
+        guard isHunting else { return }
+        Log.info(.compare, "[Hunt] 発見: \(uii.hex)")
+        feedback.notificationOccurred(.success)
+        feedback.prepare()
+        compare.enqueueInventoried(rfid: uii)
+        undetectedCount -= 1
+    }
+
+    // MARK: - Refresh -------------------------------------------------------
+    private func startRefresh() {
+        refreshTask = Task { [weak self] in
+            while !Task.isCancelled {
+                try? await Task.sleep(nanoseconds: UInt64(HuntManager.refreshInterval * 1_000_000_000))
+                guard let self, let hunt = self.hunt, !Task.isCancelled else { return }
+                let current = hunt.ranked(at: ProcessInfo.processInfo.systemUptime)
+                if current != self.ranked { self.ranked = current }
+            }
+        }
+    }
+}
@@ -0,0 +1,226 @@
+//
+//  InventoryWriteBack.swift
+//  RFID_ios
+//
+//  Created on 2025/05/23.
+//
+//  棚卸し済みの書き戻しをまとめて送る
+//    • enqueue() で受けたキーは reset() まで 1 回しか送らない（照合が何度発火しても重複しない）
+//    • maxBatchSize 件溜まったら即送信、それ未満は flushInterval 後に送信
+//    • 送信は常に 1 本ずつ。送信中に溜まった分は次の 1 回でまとめて送る
+//    • 失敗はバックオフ付きで再試行し、使い切ったら onFailed。キーは捨てずに requeueDelay 後に送り直す
+//      （照合も読取も同じタグを二度は流さないので、ここで捨てると二度と送られない）
+//  送信処理そのものは send で注入する（Supabase にも SDK にも依存しない）
+//
+
+import Foundation
+
+/// 書き戻しの閾値と再試行
+struct WriteBackPolicy {
+    var maxBatchSize = 200
+    var flushInterval: TimeInterval = 0.5
+    var maxAttempts = 5
+    /// 再試行間隔（initial から倍々で maxRetryDelay まで）
+    var initialRetryDelay: TimeInterval = 0.5
+    var maxRetryDelay: TimeInterval = 16
+    /// 再試行を使い切ったバッチを送り直すまでの間隔
+    var requeueDelay: TimeInterval = 60
+
+    func retryDelay(attempt: Int) -> TimeInterval {
+        min(initialRetryDelay * pow(2, Double(max(attempt - 1, 0))), maxRetryDelay)
+    }
+}
+
+struct WriteBackStats: Equatable {
+    /// 受け付けたキー（重複を除く）
+    var accepted = 0
+    /// 送信済み・送信待ちだったため捨てた重複
+    var duplicates = 0
+    var committed = 0
+    var requests = 0
+    var retries = 0
+    var failed = 0
+    var pending = 0
+}
+
+@MainActor
+final class InventoryWriteBack<Key: Hashable> {
+
+    typealias Send = ([Key]) async throws -> Void
+
+    /// 送信成功したキー（バッチ毎に 1 回）
+    var onCommitted: (([Key]) -> Void)?
+    /// 再試行を使い切ったキー
+    var onFailed: (([Key], Error) -> Void)?
+
+    let policy: WriteBackPolicy
+    private(set) var stats = WriteBackStats()
+
+    private let send: Send
+    /// 受け付け済み（送信待ち・送信中・送信済み）
+    private var accepted: Set<Key> = []
+    private var pending: [Key] = []
+    /// 再試行を使い切り、requeueDelay 後に pending へ戻すキー
+    private var parked: [Key] = []
+    private var requeueTask: Task<Void, Never>?
+    /// pending の最古の受付時刻（照合 → 書き戻しの計測用）
+    private var oldestPendingAt: Date?
+    private var timerTask: Task<Void, Never>?
+    private var drainTask: Task<Void, Never>?
+    /// reset() で進める。送信中のバッチは完了後に自分が古いと分かる
+    private var epoch = 0
+
+    nonisolated init(policy: WriteBackPolicy = WriteBackPolicy(), send: @escaping Send) {
+        self.policy = policy
+        self.send = send
+    }
+
+    var pendingCount: Int { pending.count + parked.count }
+    var isIdle: Bool { pending.isEmpty && parked.isEmpty && drainTask == nil }
+
+    // MARK: - Enqueue --------------------------------------------------------
+    /// 未送信のキーだけを溜める。新しく受け付けた件数を返す
+    @discardableResult
+    func enqueue<S: Sequence>(_ keys: S, at now: Date = Date()) -> Int where S.Element == Key {
+        var added = 0
+        for key in keys {
+            if accepted.insert(key).inserted {
+                pending.append(key)
+                added += 1
+            } else {
+                stats.duplicates += 1
+            }
+        }
+        guard added > 0 else { return 0 }
+        stats.accepted += added
+        stats.pending = pending.count
+        if oldestPendingAt == nil { oldestPendingAt = now }
+
+        if pending.count >= policy.maxBatchSize {
+            startDrain()
+        } else {
+            scheduleFlush()
+        }
+        return added
+    }
+
+    func contains(_ key: Key) -> Bool { accepted.contains(key) }
+
+    // MARK: - Flush ----------------------------------------------------------
+    /// 溜まっている分（送り直し待ちも含む）を今すぐ送り、送信が終わるまで待つ
+    /// 送れなかった分は送り直し待ちに戻して返る
+    func flush() async {
+        unpark()
+        startDrain()
+        while let drainTask {
+            await drainTask.value
+            if pending.isEmpty { break }
+            startDrain()
+        }
+    }
+
+    /// 送信待ちを捨て、受付済みの記録も消す（送信中のバッチは終わるまで待つ）
+    func reset() async {
+        epoch += 1
+        timerTask?.cancel()
+        timerTask = nil
+        requeueTask?.cancel()
+        requeueTask = nil
+        pending.removeAll()
+        parked.removeAll()
+        accepted.removeAll()
+        oldestPendingAt = nil
+        stats.pending = 0
+        if let drainTask { await drainTask.value }
+    }
+
+    private func scheduleFlush() {
+        guard timerTask == nil, drainTask == nil else { return }
+        let delay = policy.flushInterval
+        timerTask = Task { [weak self] in
+            try? await Task.sleep(nanoseconds: UInt64(delay * 1_000_000_000))
+            guard let self, !Task.isCancelled else { return }
+            self.timerTask = nil
+            self.startDrain()
+        }
+    }
+
+    /// 再試行を使い切ったバッチを後で送り直す（受付済みのままにして重複は受けない）
+    private func park(_ batch: [Key]) {
+        parked.append(contentsOf: batch)
+        guard requeueTask == nil else { return }
+        let delay = policy.requeueDelay
+        requeueTask = Task { [weak self] in
+            try? await Task.sleep(nanoseconds: UInt64(delay * 1_000_000_000))
+            guard let self, !Task.isCancelled else { return }
+            self.requeueTask = nil
+            self.unpark()
+            self.startDrain()
+        }
+    }
+
+    private func unpark() {
+        requeueTask?.cancel()
+        requeueTask = nil
+        guard !parked.isEmpty else { return }
+        pending.insert(contentsOf: parked, at: 0)
+        parked.removeAll()
+        stats.pending = pending.count
+        if oldestPendingAt == nil { oldestPendingAt = Date() }
+    }
+
+    private func startDrain() {
+        timerTask?.cancel()
+        timerTask = nil
+        guard drainTask == nil, !pending.isEmpty else { return }
+        drainTask = Task { [weak self] in
+            await self?.drain()
+        }
+    }
+
+    /// 溜まっている分が無くなるまで 1 バッチずつ送る
+    private func drain() async {
+        while !pending.isEmpty {
+            let batch = Array(pending.prefix(policy.maxBatchSize))
+            pending.removeFirst(batch.count)
+            stats.pending = pending.count
+            let since = oldestPendingAt
+            oldestPendingAt = pending.isEmpty ? nil : Date()
+            await deliver(batch, epoch: epoch, since: since)
+        }
+        drainTask = nil
+    }
+
+    private func deliver(_ batch: [Key], epoch: Int, since: Date?) async {
+        var attempt = 1
+        while true {
+            stats.requests += 1
+            HotPathMetrics.shared.increment(.persistRequests)
+            do {
+                try await HotPathMetrics.shared.interval("writeback.send") { try await send(batch) }
+                if let since { HotPathMetrics.shared.record(.matchToPersist, since: since) }
+                guard epoch == self.epoch else { return }
+                stats.committed += batch.count
+                Log.debug(.sync, "[WriteBack] 送信成功: \(batch.count) 件 (\(attempt)回目)")
+                onCommitted?(batch)
+                return
+            } catch {
+                HotPathMetrics.shared.increment(.persistFailures)
+                guard epoch == self.epoch else { return }
+                guard attempt < policy.maxAttempts else {
+                    stats.failed += batch.count
+                    park(batch)
+                    Log.error(.sync, "[WriteBack] 送信失敗: \(batch.count) 件, \(policy.requeueDelay)s 後に送り直し, \(error.localizedDescription)")
+                    onFailed?(batch, error)
+                    return
+                }
+                let delay = policy.retryDelay(attempt: attempt)
+                Log.warning(.sync, "[WriteBack] 再試行 \(attempt)/\(policy.maxAttempts - 1): \(delay)s 後, \(error.localizedDescription)")
+                stats.retries += 1
+                attempt += 1
+                try? await Task.sleep(nanoseconds: UInt64(delay * 1_000_000_000))
+                guard epoch == self.epoch else { return }
+            }
+        }
+    }
+}
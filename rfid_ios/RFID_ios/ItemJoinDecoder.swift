@@ -0,0 +1,143 @@
+//
+//  ItemJoinDecoder.swift
+//  RFID_ios
+//
+//  Created on 2025/05/25.
+//
+//  items（+ inventory_masters の埋め込み）の PostgREST 応答を型付きでデコードする
+//    • JSONSerialization の [[String: Any]] を経由せず、Codable で Item / InventoryMaster に直接入れる
+//    • 埋め込みマスターは id を先に読み、既に出てきた id なら残りの列を読まない（id で 1 つにまとめる）
+//    • 必須列が欠けた行は捨てて件数だけ数える（1 行の不正で全体を失敗にしない）
+//    • ページのカーソル用に、捨てた行も含めた最後の行の id / updated_at を残す
+//    • decodeDetached() はメインスレッド外で実行する
+//  アプリ・同期・検索の各所で同じデコーダを使う
+//
+
+import Foundation
+
+struct ItemJoinPayload {
+    var items: [Item] = []
+    /// 埋め込みマスター（id → マスター）
+    var masters: [String: InventoryMaster] = [:]
+    /// 必須列が欠けていて捨てた行
+    var skipped = 0
+    /// 応答の最後の行（捨てた行も含む）。次のページのカーソルに使う
+    var lastRow: ItemJoinRowKey?
+}
+
+/// 応答の行の並び順のキー。列が読めなければ nil
+struct ItemJoinRowKey: Equatable {
+    let id: String?
+    let updatedAt: String?
+}
+
+enum ItemJoinError: LocalizedError, Equatable {
+    /// ページの最後の行から次のカーソルが作れない
+    case missingCursor(String)
+
+    var errorDescription: String? {
+        switch self {
+        case .missingCursor(let column): return "ページの最後の行に \(column) がありません"
+        }
+    }
+}
+
+enum ItemJoinDecoder {
+
+    static func decode(_ data: Data) throws -> ItemJoinPayload {
+        let decoder = JSONDecoder()
+        let cache = MasterCache()
+        decoder.userInfo[.itemJoinMasterCache] = cache
+        let rows = try decoder.decode([ItemRow].self, from: data)
+
+        var payload = ItemJoinPayload()
+        payload.items.reserveCapacity(rows.count)
+        for row in rows {
+            if let item = row.item {
+                payload.items.append(item)
+            } else {
+                payload.skipped += 1
+            }
+        }
+        payload.masters = cache.masters
+        payload.lastRow = rows.last?.key
+        return payload
+    }
+
+    /// メインスレッド外でデコードする
+    static func decodeDetached(_ data: Data) async throws -> ItemJoinPayload {
+        try await Task.detached(priority: .userInitiated) { try decode(data) }.value
+    }
+
+    // MARK: - Rows -----------------------------------------------------------
+    /// 1 回のデコード中に出てきたマスター
+    fileprivate final class MasterCache {
+        var masters: [String: InventoryMaster] = [:]
+    }
+
+    private enum ItemKey: String, CodingKey {
+        case id
+        case createdAt = "created_at"
+        case updatedAt = "updated_at"
+        case rfid
+        case inventoryMasterId = "inventory_master_id"
+        case userId = "user_id"
+        case isInventoried = "is_inventoried"
+        case inventoryMasters = "inventory_masters"
+    }
+
+    private struct ItemRow: Decodable {
+        let item: Item?
+        let key: ItemJoinRowKey
+
+        init(from decoder: Decoder) throws {
+            let c = try decoder.container(keyedBy: ItemKey.self)
+            key = ItemJoinRowKey(id: try? c.decode(String.self, forKey: .id),
+                                 updatedAt: try? c.decode(String.self, forKey: .updatedAt))
+            guard let id = key.id,
+                  let rfid = try? c.decode(String.self, forKey: .rfid),
+                  let masterId = try? c.decode(String.self, forKey: .inventoryMasterId),
+                  let createdAt = try? c.decode(String.self, forKey: .createdAt),
+                  let updatedAt = key.updatedAt else {
+                item = nil
+                return
+            }
+            item = Item(id: id,
+                        createdAt: createdAt,
+                        updatedAt: updatedAt,
+                        rfid: rfid,
+                        inventoryMasterId: masterId,
+                        userId: try? c.decodeIfPresent(String.self, forKey: .userId),
+                        // is_inventoried は NULL のことがある
+                        isInventoried: (try? c.decodeIfPresent(Bool.self, forKey: .isInventoried)) ?? false)
+
+            guard let cache = decoder.userInfo[.itemJoinMasterCache] as? MasterCache,
+                  let m = try? c.nestedContainer(keyedBy: InventoryMaster.CodingKeys.self, forKey: .inventoryMasters),
+                  let invId = try? m.decode(String.self, forKey: .id),
+                  cache.masters[invId] == nil else { return }
+            cache.masters[invId] = ItemJoinDecoder.decodeMaster(id: invId, m)
+        }
+    }
+
+    /// 必須列が欠けていれば nil。target が不明なら clinic 扱い（従来の読込と同じ）
+    fileprivate static func decodeMaster(id: String, _ m: KeyedDecodingContainer<InventoryMaster.CodingKeys>) -> InventoryMaster? {
+        guard let col1 = try? m.decode(String.self, forKey: .col1),
+              let createdAt = try? m.decode(String.self, forKey: .createdAt),
+              let updatedAt = try? m.decode(String.self, forKey: .updatedAt),
+              let target = try? m.decode(String.self, forKey: .target) else { return nil }
+        return InventoryMaster(id: id,
+                               createdAt: createdAt,
+                               updatedAt: updatedAt,
+                               col1: col1,
+                               col2: try? m.decodeIfPresent(String.self, forKey: .col2),
+                               col3: try? m.decodeIfPresent(String.self, forKey: .col3),
+                               productCode: try? m.decodeIfPresent(String.self, forKey: .productCode),
+                               target: TargetType(rawValue: target) ?? .clinic,
+                               userId: try? m.decodeIfPresent(String.self, forKey: .userId),
+                               productImage: try? m.decodeIfPresent(String.self, forKey: .productImage))
+    }
+}
+
+private extension CodingUserInfoKey {
+    static let itemJoinMasterCache = CodingUserInfoKey(rawValue: "itemJoinMasterCache")!
+}
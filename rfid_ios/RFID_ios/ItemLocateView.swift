@@ -0,0 +1,95 @@
+//
+//  ItemLocateView.swift
+//  RFID_ios
+//
+//  Created on 2025/05/20.
+//
+//  1 タグの探索画面（近さの表示と音）
+//
+
+import SwiftUI
+
+struct ItemLocateView: View {
+    @EnvironmentObject var scanner: ScannerManager
+    @EnvironmentObject var locateManager: LocateManager
+
+    let target: EPC
+    var itemName: String?
+
+    private var isActive: Bool { locateManager.isLocating && locateManager.target == target }
+    private var reading: RSSILocator.Reading { isActive ? locateManager.reading : .empty }
+
+    var body: some View {
+        VStack(spacing: 24) {
+            VStack(spacing: 4) {
+                if let itemName { Text(itemName).font(.headline) }
+                Text(target.hex)
+                    .font(.caption.monospaced())
+                    .foregroundColor(.secondary)
+            }
+
+            // 近さ
+            ZStack {
+                Circle()
+                    .stroke(Color.gray.opacity(0.3), lineWidth: 2)
+                Circle()
+                    .fill(proximityColor.opacity(0.8))
+                    .scaleEffect(0.15 + 0.85 * reading.proximity)
+                    .animation(.linear(duration: LocateManager.refreshInterval), value: reading.proximity)
+                Text(reading.isLost ? "—" : String(format: "%.0f%%", reading.proximity * 100))
+                    .font(.system(size: 44, weight: .bold).monospacedDigit())
+            }
+            .frame(width: 240, height: 240)
+
+            Group {
+                ItemSearchInfoRow(label: "RSSI (平滑 / 生 / 最大)", value: rssiText)
+                ItemSearchInfoRow(label: "読取レート", value: String(format: "%.1f 回/秒", reading.readsPerSecond))
+            }
+            .frame(maxWidth: .infinity, alignment: .leading)
+            .padding(.horizontal)
+
+            Toggle("音で知らせる", isOn: $locateManager.isToneOn)
+                .padding(.horizontal)
+
+            Button {
+                Task {
+                    if isActive {
+                        await locateManager.stop()
+                    } else {
+                        await locateManager.start(target: target)
+                    }
+                }
+            } label: {
+                Label(isActive ? "探索停止" : "探索開始",
+                      systemImage: isActive ? "stop.circle" : "dot.radiowaves.left.and.right")
+                    .frame(maxWidth: .infinity)
+                    .padding(.vertical, 12)
+            }
+            .buttonStyle(.borderedProminent)
+            .disabled(!scanner.isConnected && !scanner.isSimulating && !scanner.isReplaying)
+
+            Spacer()
+        }
+        .padding()
+        .navigationTitle("探索")
+        .onDisappear {
+            Task { await locateManager.stop() }
+        }
+    }
+
+    private var proximityColor: Color {
+        switch reading.proximity {
+        case ..<0.01: return .gray
+        case ..<0.4:  return .blue
+        case ..<0.75: return .orange
+        default:      return .red
+        }
+    }
+
+    private var rssiText: String {
+        guard let rssi = reading.rssi else { return "-" }
+        return String(format: "%.1f / %@ / %@", rssi,
+                      reading.rawRSSI.map { "\($0)" } ?? "-",
+                      reading.peakRSSI.map { String(format: "%.1f", $0) } ?? "-")
+    }
+}
@@ -19,9 +19,11 @@ final class ItemRegistrationManager: ObservableObject {
 
     // MARK: - Dependencies
     private let scanner: ScannerManager
+    private let sync: MasterSyncManager
 
-    init(scannerManager: ScannerManager) {
+    init(scannerManager: ScannerManager, sync: MasterSyncManager) {
         self.scanner = scannerManager
+        self.sync = sync
     }
 
     /// 商品コードでマスタを検索
@@ -35,13 +37,20 @@ final class ItemRegistrationManager: ObservableObject {
         errorMessage = nil
 
         do {
-            let query = supabase
-                .from("inventory_masters")
-                .select()
-                .ilike("product_code", pattern: "%\(productCodeInput)%")
-
-            // デコードは .value プロパティで
-            let masters: [InventoryMaster] = try await query.execute().value
+            // 端末のストアから引く（商品コードに索引あり）
+            let store = sync.store
+            let code = productCodeInput
+            var masters = try await Task.detached { try store.masters(productCodeContaining: code) }.value
+            if masters.isEmpty && sync.localMasterCount == 0 {
+                // まだ同期していなければサーバーへ
+                let query = supabase
+                    .from("inventory_masters")
+                    .select()
+                    .ilike("product_code", pattern: "%\(productCodeInput)%")
+
+                // デコードは .value プロパティで
+                masters = try await query.execute().value
+            }
 
             self.inventoryMasters = masters
             if masters.isEmpty {
@@ -70,19 +79,16 @@ final class ItemRegistrationManager: ObservableObject {
         errorMessage = nil
 
         do {
-            let params = CreateItemParams(
-                rfid: rfid,
-                inventoryMasterId: master.id,
-                isInventoried: false
-            )
-
             print("登録パラメータ: rfid=\(rfid), inventory_master_id=\(master.id)")
 
-            // 挿入クエリ実行
-            _ = try await supabase
-                .from("items")
-                .insert(params)
-                .execute()
+            // 端末のストアに登録して送信待ちに積む（通信できなくても登録できる）
+            if try sync.store.item(rfid: rfid) != nil {
+                errorMessage = "このRFIDは登録済みです"
+                isLoading = false
+                return false
+            }
+            _ = try sync.store.insertItem(rfid: rfid, inventoryMasterId: master.id)
+            sync.requestUpload()
 
             isLoading = false
             return true
@@ -10,7 +10,7 @@ struct ItemRegistrationView: View {
     @EnvironmentObject var itemRegistrationManager: ItemRegistrationManager
     @EnvironmentObject var scanner: ScannerManager
 
-    @State private var selectedRFID: String?
+    @State private var selectedRFID: EPC?
     @State private var showAlert = false
     @State private var alertMessage = ""
     @State private var isRegistering = false
@@ -99,12 +99,12 @@ struct ItemRegistrationView: View {
 
                 // RFID読み取り結果
                 VStack(alignment: .leading, spacing: 8) {
-                    Text("RFID読み取り結果")
+                    Text("RFID読み取り結果 (\(scanner.scannedCount)件)")
                         .font(.headline)
                         .fontWeight(.bold)
                         .padding(.horizontal)
 
-                    if scanner.scannedUII.isEmpty {
+                    if scanner.scannedCount == 0 {
                         Text("RFIDをスキャンしてください")
                             .foregroundColor(.gray)
                             .frame(maxWidth: .infinity, alignment: .center)
@@ -112,12 +112,14 @@ struct ItemRegistrationView: View {
                     } else {
                         ScrollView {
                             LazyVStack(spacing: 8) {
-                                ForEach(scanner.scannedUII, id: \.self) { rfid in
+                                // 挿入のみなので添字を id にする（追加分の行だけ作られる）
+                                ForEach(0..<scanner.scannedCount, id: \.self) { index in
+                                    let rfid = scanner.scannedUII[index]
                                     Button(action: {
                                         selectedRFID = rfid
                                     }) {
                                         HStack {
-                                            Text(rfid)
+                                            Text(rfid.hex)
                                                 .padding()
                                                 .frame(maxWidth: .infinity, alignment: .leading)
                                         }
@@ -216,7 +218,7 @@ struct ItemRegistrationView: View {
         isRegistering = true
 
         Task {
-            let success = await itemRegistrationManager.registerItem(rfid: selectedRFID)
+            let success = await itemRegistrationManager.registerItem(rfid: selectedRFID.hex)
 
             await MainActor.run {
                 isRegistering = false
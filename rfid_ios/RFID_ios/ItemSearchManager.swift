@@ -19,25 +19,34 @@ final class ItemSearchManager: ObservableObject {
 
     // MARK: - Dependencies
     private let scanner: ScannerManager
+    private let store: LocalItemStore
     private var cancellables = Set<AnyCancellable>()
+    /// 実行中の検索（新しい検索を始めたら前の検索は捨てる）
+    private var searchTask: Task<Void, Never>?
 
-    init(scannerManager: ScannerManager) {
+    init(scannerManager: ScannerManager, store: LocalItemStore) {
         self.scanner = scannerManager
+        self.store = store
 
         // スキャナーからのRFID読み取り結果を監視
-        scanner.$scannedUII
-            .sink { [weak self] tags in
-                guard let self = self, !tags.isEmpty else { return }
+        // 新規タグの差分だけを受け取る（配列全体の再通知は受けない）
+        scanner.scannedDelta
+            .sink { [weak self] added in
+                guard let self = self else { return }
                 // 最新のタグを自動検索
-                if let latestTag = tags.last {
-                    Task {
-                        await self.searchItemByRFID(rfid: latestTag)
-                    }
+                if let latestTag = added.last {
+                    self.search(rfid: latestTag.hex)
                 }
             }
             .store(in: &cancellables)
     }
 
+    /// 前の検索をキャンセルしてから検索する（遅れて返った古い結果で新しい結果を上書きしない）
+    func search(rfid: String) {
+        searchTask?.cancel()
+        searchTask = Task { await searchItemByRFID(rfid: rfid) }
+    }
+
     /// RFIDタグで商品を検索
     func searchItemByRFID(rfid: String) async {
         guard !rfid.isEmpty else {
@@ -50,8 +59,19 @@ final class ItemSearchManager: ObservableObject {
         searchedItem = nil
         inventoryMaster = nil
 
+        // 端末のストアにあればそれを使う（通信しない）
+        let store = self.store
+        let local = try? await Task.detached(operation: { try store.item(rfid: rfid) }).value
+        guard !Task.isCancelled else { return }
+        if let local {
+            searchedItem = local.item
+            inventoryMaster = local.master
+            isLoading = false
+            return
+        }
+
         do {
-            print("🔍 RFID検索開始: \(rfid)")
+            Log.debug(.sync, "RFID検索開始（端末になし、サーバーへ）: \(rfid)")
 
             // itemsテーブルからRFIDで検索
             let query = supabase
@@ -61,78 +81,23 @@ final class ItemSearchManager: ObservableObject {
                 .limit(1)
 
             let response = try await query.execute()
-            print("📦 レスポンスステータス: \(response.status)")
-
-            let data = response.data
-            if let jsonArray = try JSONSerialization.jsonObject(with: data, options: []) as? [[String: Any]],
-               !jsonArray.isEmpty {
-
-                print("✅ JSONパース成功: 件数=\(jsonArray.count)")
-
-                if let itemData = jsonArray.first {
-                    // アイテムデータの解析
-                    guard let id = itemData["id"] as? String,
-                          let rfid = itemData["rfid"] as? String,
-                          let masterId = itemData["inventory_master_id"] as? String,
-                          let createdAt = itemData["created_at"] as? String,
-                          let updatedAt = itemData["updated_at"] as? String else {
-                        throw NSError(domain: "ParseError", code: 1, userInfo: [NSLocalizedDescriptionKey: "必須フィールドが見つかりません"])
-                    }
-
-                    let isInventoried = itemData["is_inventoried"] as? Bool ?? false
-                    let userId = itemData["user_id"] as? String
-
-                    let item = Item(
-                        id: id,
-                        createdAt: createdAt,
-                        updatedAt: updatedAt,
-                        rfid: rfid,
-                        inventoryMasterId: masterId,
-                        userId: userId,
-                        isInventoried: isInventoried
-                    )
-
-                    // マスターデータの解析
-                    if let invData = itemData["inventory_masters"] as? [String: Any],
-                       let invId = invData["id"] as? String,
-                       let col1 = invData["col_1"] as? String,
-                       let targetStr = invData["target"] as? String,
-                       let invCreated = invData["created_at"] as? String,
-                       let invUpdated = invData["updated_at"] as? String {
-
-                        let col2 = invData["col_2"] as? String
-                        let col3 = invData["col_3"] as? String
-                        let productCode = invData["product_code"] as? String
-                        let userId = invData["user_id"] as? String
-                        let productImage = invData["product_image"] as? String
-
-                        let targetType: TargetType = TargetType(rawValue: targetStr) ?? .clinic
-                        let master = InventoryMaster(
-                            id: invId,
-                            createdAt: invCreated,
-                            updatedAt: invUpdated,
-                            col1: col1,
-                            col2: col2,
-                            col3: col3,
-                            productCode: productCode,
-                            target: targetType,
-                            userId: userId,
-                            productImage: productImage
-                        )
-
-                        self.inventoryMaster = master
-                    }
-
-                    self.searchedItem = item
-                    print("✅ 商品情報取得成功: RFID=\(rfid)")
-                }
+            Log.debug(.sync, "RFID検索レスポンス: status=\(response.status)")
+
+            // 型付きデコーダでメインスレッド外でデコード
+            let payload = try await ItemJoinDecoder.decodeDetached(response.data)
+            guard !Task.isCancelled else { return }
+            if let item = payload.items.first {
+                self.inventoryMaster = payload.masters[item.inventoryMasterId]
+                self.searchedItem = item
+                Log.info(.sync, "商品情報取得成功: RFID=\(item.rfid)")
             } else {
                 errorMessage = "商品が見つかりませんでした"
-                print("ℹ️ 商品が見つかりません: RFID=\(rfid)")
+                Log.info(.sync, "商品が見つかりません: RFID=\(rfid)")
             }
         } catch {
+            guard !Task.isCancelled else { return }
             errorMessage = "検索エラー: \(error.localizedDescription)"
-            print("⚠️ 検索エラー: \(error)")
+            Log.warning(.sync, "検索エラー: \(error)")
         }
 
         isLoading = false
@@ -11,7 +11,7 @@ struct ItemSearchView: View {
     @EnvironmentObject var scanner: ScannerManager
     @EnvironmentObject var itemSearchManager: ItemSearchManager
 
-    @State private var selectedRFID: String?
+    @State private var selectedRFID: EPC?
     @State private var manualSearchRFID: String = ""
 
     var body: some View {
@@ -32,9 +32,7 @@ struct ItemSearchView: View {
                         .padding(.vertical, 4)
 
                         Button("検索") {
-                            Task {
-                                await itemSearchManager.searchItemByRFID(rfid: manualSearchRFID)
-                            }
+                            itemSearchManager.search(rfid: manualSearchRFID)
                         }
                         .buttonStyle(.borderedProminent)
                         .controlSize(.regular)
@@ -88,6 +86,19 @@ struct ItemSearchView: View {
                             ItemSearchInfoRow(label: "棚卸し状態", value: item.isInventoried ? "済" : "未")
                         }
                         .padding(.horizontal)
+
+                        // 見つからない商品を電波の強さで探す
+                        if let epc = EPC(hex: item.rfid) {
+                            NavigationLink {
+                                ItemLocateView(target: epc, itemName: master.col1)
+                            } label: {
+                                Label("この商品を探す", systemImage: "dot.radiowaves.left.and.right")
+                                    .frame(maxWidth: .infinity)
+                                    .padding(.vertical, 8)
+                            }
+                            .buttonStyle(.bordered)
+                            .padding(.horizontal)
+                        }
                     }
                     .padding(.vertical)
                     .background(Color.gray.opacity(0.1))
@@ -96,12 +107,12 @@ struct ItemSearchView: View {
 
                 // RFID読み取り結果
                 VStack(alignment: .leading, spacing: 8) {
-                    Text("RFID読み取り結果")
+                    Text("RFID読み取り結果 (\(scanner.scannedCount)件)")
                         .font(.headline)
                         .fontWeight(.bold)
                         .padding(.horizontal)
 
-                    if scanner.scannedUII.isEmpty {
+                    if scanner.scannedCount == 0 {
                         Text("RFIDをスキャンしてください")
                             .foregroundColor(.gray)
                             .frame(maxWidth: .infinity, alignment: .center)
@@ -109,15 +120,15 @@ struct ItemSearchView: View {
                     } else {
                         ScrollView {
                             LazyVStack(spacing: 8) {
-                                ForEach(scanner.scannedUII, id: \.self) { rfid in
+                                // 挿入のみなので添字を id にする（追加分の行だけ作られる）
+                                ForEach(0..<scanner.scannedCount, id: \.self) { index in
+                                    let rfid = scanner.scannedUII[index]
                                     Button(action: {
                                         selectedRFID = rfid
-                                        Task {
-                                            await itemSearchManager.searchItemByRFID(rfid: rfid)
-                                        }
+                                        itemSearchManager.search(rfid: rfid.hex)
                                     }) {
                                         HStack {
-                                            Text(rfid)
+                                            Text(rfid.hex)
                                                 .padding()
                                                 .frame(maxWidth: .infinity, alignment: .leading)
                                         }
@@ -133,6 +144,27 @@ struct ItemSearchView: View {
                         }
                         .frame(maxHeight: 150)
                     }
+
+                    // 選択タグの電波統計
+                    if let rfid = selectedRFID,
+                       let record = scanner.tagRecord(for: rfid),
+                       record.signal.hasSamples {
+                        Group {
+                            ItemSearchInfoRow(
+                                label: "RSSI (平均 / 最大)",
+                                value: String(format: "%.1f / %ld", record.signal.rssiMean, record.signal.rssiMax)
+                            )
+                            ItemSearchInfoRow(
+                                label: "読取回数 / レート",
+                                value: String(format: "%ld回 / %.1f回/秒", record.readCount, record.readsPerSecond)
+                            )
+                            ItemSearchInfoRow(
+                                label: "アンテナ / ch",
+                                value: "\(record.signal.lastAntenna ?? 0) / \(record.signal.lastChannel ?? 0)"
+                            )
+                        }
+                        .padding(.horizontal)
+                    }
                 }
                 .padding(.vertical)
                 .background(Color.gray.opacity(0.1))
@@ -0,0 +1,385 @@
+//
+//  LocalItemStore.swift
+//  RFID_ios
+//
+//  Created on 2025/05/24.
+//
+//  items / inventory_masters の端末内コピー（SQLite）
+//    • 突き合わせ・RFID 検索・商品コード検索はすべてここから引く（電波が悪くても止まらない）
+//    • サーバーからは updated_at + id のカーソルで差分だけ取り込む（MasterSyncManager）
+//    • 端末での変更はその場で反映し、送信待ち（outbox）に積んで後から送る
+//    • 棚卸しは対象毎のセッションに読んだ RFID を追記する（items.is_inventoried はサーバーへ書かない）
+//  サーバー側で削除された行は差分では分からないので、全件取り直し（resetCursors）で消す
+//
+
+import Foundation
+
+/// 差分取得の位置（この行より後を取りに行く）
+struct SyncCursor: Equatable, Codable {
+    var updatedAt: String
+    var id: String
+}
+
+/// サーバーへの送信待ち操作
+enum OutboxOperation: Codable, Equatable {
+    /// items.is_inventoried をまとめて書き換える（旧版で積んだ分を送り切るためだけに残す）
+    case setInventoried(itemIds: [String], value: Bool)
+    /// 端末で登録した items 行（id は端末で採番）
+    case insertItem(id: String, rfid: String, inventoryMasterId: String)
+    /// 棚卸しセッションを開く（id は端末で採番）
+    case openSession(id: String, target: String)
+    /// セッションに読んだ RFID を追記する（再送しても重複しない）
+    case appendScans(sessionId: String, rfids: [String])
+    /// セッションを締める（discard なら破棄）
+    case closeSession(id: String, discard: Bool)
+}
+
+struct OutboxEntry: Equatable {
+    let seq: Int64
+    let operation: OutboxOperation
+    let attempts: Int
+}
+
+final class LocalItemStore: @unchecked Sendable {
+
+    enum Table: String, CaseIterable {
+        case items
+        case inventoryMasters = "inventory_masters"
+    }
+
+    static let schemaVersion = 4
+
+    private let db: SQLiteDatabase
+
+    /// アプリ全体で使うストア（Application Support/local_items.sqlite）
+    static func openDefault() throws -> LocalItemStore {
+        let dir = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        return try LocalItemStore(path: dir.appendingPathComponent("local_items.sqlite").path)
+    }
+
+    init(path: String) throws {
+        db = try SQLiteDatabase(path: path)
+        try migrate()
+    }
+
+    private func migrate() throws {
+        let version = try db.query("PRAGMA user_version") { $0.int(0) }.first ?? 0
+        guard version < Self.schemaVersion else { return }
+        if version < 1 { try createTables() }
+        if version < 2 {
+            // 対象毎の初回ダウンロード済み（v1 で既に取り込んでいた対象は済みにする）
+            try db.execute("""
+                CREATE TABLE IF NOT EXISTS downloaded_targets (target TEXT PRIMARY KEY NOT NULL);
+                INSERT OR IGNORE INTO downloaded_targets (target)
+                    SELECT DISTINCT m.target FROM items i JOIN inventory_masters m ON m.id = i.inventory_master_id;
+                """)
+        }
+        if version < 3 {
+            // 棚卸しセッション（締めるまで closed_at は NULL）
+            try db.execute("""
+                CREATE TABLE IF NOT EXISTS inventory_sessions (
+                    id TEXT PRIMARY KEY NOT NULL,
+                    target TEXT NOT NULL,
+                    opened_at TEXT NOT NULL,
+                    closed_at TEXT
+                );
+                CREATE INDEX IF NOT EXISTS inventory_sessions_target_idx ON inventory_sessions (target, closed_at);
+                """)
+        }
+        if version < 4 {
+            // 全件取り直しの間も端末の棚卸し済みを残す（取り直した行に戻したら消す）
+            try db.execute("""
+                CREATE TABLE IF NOT EXISTS kept_inventoried (
+                    id TEXT PRIMARY KEY NOT NULL,
+                    target TEXT NOT NULL
+                );
+                """)
+        }
+        try db.execute("PRAGMA user_version = \(Self.schemaVersion)")
+    }
+
+    private func createTables() throws {
+        try db.execute("""
+            CREATE TABLE IF NOT EXISTS inventory_masters (
+                id TEXT PRIMARY KEY NOT NULL,
+                created_at TEXT NOT NULL,
+                updated_at TEXT NOT NULL,
+                col_1 TEXT NOT NULL,
+                col_2 TEXT,
+                col_3 TEXT,
+                product_code TEXT,
+                target TEXT NOT NULL,
+                user_id TEXT,
+                product_image TEXT
+            );
+            CREATE INDEX IF NOT EXISTS inventory_masters_target_idx ON inventory_masters (target);
+            CREATE INDEX IF NOT EXISTS inventory_masters_product_code_idx ON inventory_masters (product_code);
+
+            CREATE TABLE IF NOT EXISTS items (
+                id TEXT PRIMARY KEY NOT NULL,
+                created_at TEXT NOT NULL,
+                updated_at TEXT NOT NULL,
+                rfid TEXT NOT NULL,
+                inventory_master_id TEXT NOT NULL,
+                user_id TEXT,
+                is_inventoried INTEGER NOT NULL DEFAULT 0
+            );
+            CREATE INDEX IF NOT EXISTS items_rfid_idx ON items (rfid);
+            CREATE INDEX IF NOT EXISTS items_inventory_master_id_idx ON items (inventory_master_id);
+
+            CREATE TABLE IF NOT EXISTS sync_cursors (
+                table_name TEXT PRIMARY KEY NOT NULL,
+                updated_at TEXT NOT NULL,
+                id TEXT NOT NULL
+            );
+
+            CREATE TABLE IF NOT EXISTS outbox (
+                seq INTEGER PRIMARY KEY AUTOINCREMENT,
+                operation BLOB NOT NULL,
+                attempts INTEGER NOT NULL DEFAULT 0
+            );
+            """)
+    }
+
+    // MARK: - Upsert (サーバー → 端末) ----------------------------------------
+    /// サーバーの行で上書きする。is_inventoried は端末で数えている途中の状態なので既存行は残す
+    /// 新しい行は未棚卸しで入れる（全件取り直しの前に棚卸し済みだった行はそれに戻す）
+    func upsert(items: [Item]) throws {
+        guard !items.isEmpty else { return }
+        let hasKept = try db.query("SELECT 1 FROM kept_inventoried LIMIT 1") { _ in true }.first ?? false
+        try db.transaction {
+            for item in items {
+                try db.run("""
+                    INSERT INTO items (id, created_at, updated_at, rfid, inventory_master_id, user_id, is_inventoried)
+                    VALUES (?1, ?2, ?3, ?4, ?5, ?6, EXISTS (SELECT 1 FROM kept_inventoried WHERE id = ?1))
+                    ON CONFLICT(id) DO UPDATE SET
+                        created_at = excluded.created_at, updated_at = excluded.updated_at,
+                        rfid = excluded.rfid, inventory_master_id = excluded.inventory_master_id,
+                        user_id = excluded.user_id
+                    """, [.text(item.id), .text(item.createdAt), .text(item.updatedAt), .text(item.rfid),
+                          .text(item.inventoryMasterId), .optional(item.userId)])
+                if hasKept {
+                    try db.run("DELETE FROM kept_inventoried WHERE id = ?", [.text(item.id)])
+                }
+            }
+        }
+    }
+
+    func upsert(masters: [InventoryMaster]) throws {
+        guard !masters.isEmpty else { return }
+        try db.transaction {
+            for master in masters {
+                try db.run("""
+                    INSERT OR REPLACE INTO inventory_masters
+                        (id, created_at, updated_at, col_1, col_2, col_3, product_code, target, user_id, product_image)
+                    VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+                    """, [.text(master.id), .text(master.createdAt), .text(master.updatedAt), .text(master.col1),
+                          .optional(master.col2), .optional(master.col3), .optional(master.productCode),
+                          .text(master.target.rawValue), .optional(master.userId), .optional(master.productImage)])
+            }
+        }
+    }
+
+    // MARK: - Cursor ----------------------------------------------------------
+    func cursor(for table: Table) throws -> SyncCursor? {
+        try db.query("SELECT updated_at, id FROM sync_cursors WHERE table_name = ?", [.text(table.rawValue)]) {
+            SyncCursor(updatedAt: $0.text(0), id: $0.text(1))
+        }.first
+    }
+
+    func setCursor(_ cursor: SyncCursor, for table: Table) throws {
+        try db.run("INSERT OR REPLACE INTO sync_cursors (table_name, updated_at, id) VALUES (?, ?, ?)",
+                   [.text(table.rawValue), .text(cursor.updatedAt), .text(cursor.id)])
+    }
+
+    /// 次回を全件取り直しにする（サーバー側の削除を反映するため、取り込んだ行も消す）
+    /// 端末の棚卸し済みはサーバーに無いので、取り直した行に戻せるよう残しておく
+    func resetCursors() throws {
+        try db.transaction {
+            try db.execute("""
+                INSERT OR IGNORE INTO kept_inventoried (id, target)
+                    SELECT i.id, m.target FROM items i JOIN inventory_masters m ON m.id = i.inventory_master_id
+                    WHERE i.is_inventoried = 1;
+                DELETE FROM sync_cursors; DELETE FROM downloaded_targets;
+                DELETE FROM items; DELETE FROM inventory_masters;
+                """)
+        }
+    }
+
+    // MARK: - Initial download --------------------------------------------------
+    /// 対象の items を一通り取り込み済みか（途中で止めた対象は済みにしない）
+    func isDownloaded(_ target: TargetType) throws -> Bool {
+        try !db.query("SELECT 1 FROM downloaded_targets WHERE target = ?", [.text(target.rawValue)]) { _ in true }.isEmpty
+    }
+
+    func markDownloaded(_ target: TargetType) throws {
+        try db.run("INSERT OR IGNORE INTO downloaded_targets (target) VALUES (?)", [.text(target.rawValue)])
+    }
+
+    /// 初回ダウンロードのページ（items と埋め込みマスター）を 1 トランザクションで入れる
+    func upsert(page: ItemJoinPayload) throws {
+        try db.transaction {
+            try upsert(masters: Array(page.masters.values))
+            try upsert(items: page.items)
+        }
+    }
+
+    // MARK: - Query -------------------------------------------------------------
+    private static let itemColumns = "i.id, i.created_at, i.updated_at, i.rfid, i.inventory_master_id, i.user_id, i.is_inventoried"
+    private static let masterColumns = "m.id, m.created_at, m.updated_at, m.col_1, m.col_2, m.col_3, m.product_code, m.target, m.user_id, m.product_image"
+
+    private static func item(_ row: SQLiteDatabase.Row, from c: Int32 = 0) -> Item {
+        Item(id: row.text(c), createdAt: row.text(c + 1), updatedAt: row.text(c + 2), rfid: row.text(c + 3),
+             inventoryMasterId: row.text(c + 4), userId: row.optionalText(c + 5), isInventoried: row.bool(c + 6))
+    }
+
+    private static func master(_ row: SQLiteDatabase.Row, from c: Int32 = 0) -> InventoryMaster {
+        InventoryMaster(id: row.text(c), createdAt: row.text(c + 1), updatedAt: row.text(c + 2), col1: row.text(c + 3),
+                        col2: row.optionalText(c + 4), col3: row.optionalText(c + 5),
+                        productCode: row.optionalText(c + 6),
+                        target: TargetType(rawValue: row.text(c + 7)) ?? .clinic,
+                        userId: row.optionalText(c + 8), productImage: row.optionalText(c + 9))
+    }
+
+    /// 対象の items 全件（マスターは id で 1 つにまとめる）
+    func items(target: TargetType) throws -> (items: [Item], masters: [String: InventoryMaster]) {
+        var masters: [String: InventoryMaster] = [:]
+        let items = try db.query("""
+            SELECT \(Self.itemColumns), \(Self.masterColumns)
+            FROM items i JOIN inventory_masters m ON m.id = i.inventory_master_id
+            WHERE m.target = ?
+            """, [.text(target.rawValue)]) { row -> Item in
+            let item = Self.item(row)
+            if masters[item.inventoryMasterId] == nil {
+                masters[item.inventoryMasterId] = Self.master(row, from: 7)
+            }
+            return item
+        }
+        return (items, masters)
+    }
+
+    /// RFID（16 進文字列）で 1 件
+    func item(rfid: String) throws -> (item: Item, master: InventoryMaster?)? {
+        try db.query("""
+            SELECT \(Self.itemColumns), \(Self.masterColumns)
+            FROM items i LEFT JOIN inventory_masters m ON m.id = i.inventory_master_id
+            WHERE i.rfid = ? LIMIT 1
+            """, [.text(rfid)]) { row in
+            (item: Self.item(row), master: row.optionalText(7) == nil ? nil : Self.master(row, from: 7))
+        }.first
+    }
+
+    /// 商品コードの部分一致
+    func masters(productCodeContaining code: String, limit: Int = 200) throws -> [InventoryMaster] {
+        let escaped = code.replacingOccurrences(of: "\\", with: "\\\\")
+            .replacingOccurrences(of: "%", with: "\\%")
+            .replacingOccurrences(of: "_", with: "\\_")
+        return try db.query("""
+            SELECT \(Self.masterColumns) FROM inventory_masters m
+            WHERE m.product_code LIKE ? ESCAPE '\\' ORDER BY m.product_code LIMIT ?
+            """, [.text("%\(escaped)%"), .int(Int64(limit))]) { Self.master($0) }
+    }
+
+    func count(_ table: Table) throws -> Int {
+        Int(try db.query("SELECT COUNT(*) FROM \(table.rawValue)") { $0.int(0) }.first ?? 0)
+    }
+
+    // MARK: - Local writes ------------------------------------------------------
+    /// is_inventoried を端末だけで書き換える（数えている途中の表示用。サーバーへはスキャンとして送る）
+    func setInventoried(itemIds: [String], value: Bool) throws {
+        guard !itemIds.isEmpty else { return }
+        try db.transaction {
+            for id in itemIds {
+                try db.run("UPDATE items SET is_inventoried = ? WHERE id = ?", [.bool(value), .text(id)])
+            }
+        }
+    }
+
+    /// 端末で items を登録し、送信待ちに積む。登録した行を返す
+    func insertItem(rfid: String, inventoryMasterId: String, now: Date = Date()) throws -> Item {
+        let stamp = ISO8601DateFormatter().string(from: now)
+        let item = Item(id: UUID().uuidString.lowercased(), createdAt: stamp, updatedAt: stamp, rfid: rfid,
+                        inventoryMasterId: inventoryMasterId, userId: nil, isInventoried: false)
+        try db.transaction {
+            try db.run("""
+                INSERT INTO items (id, created_at, updated_at, rfid, inventory_master_id, user_id, is_inventoried)
+                VALUES (?, ?, ?, ?, ?, NULL, 0)
+                """, [.text(item.id), .text(stamp), .text(stamp), .text(rfid), .text(inventoryMasterId)])
+            try appendOutbox(.insertItem(id: item.id, rfid: rfid, inventoryMasterId: inventoryMasterId))
+        }
+        return item
+    }
+
+    // MARK: - Inventory session -------------------------------------------------
+    /// 対象の開いているセッション
+    func openSessionId(target: TargetType) throws -> String? {
+        try db.query("SELECT id FROM inventory_sessions WHERE target = ? AND closed_at IS NULL LIMIT 1",
+                     [.text(target.rawValue)]) { $0.text(0) }.first
+    }
+
+    /// 読んだ RFID をセッションに追記して送信待ちに積む（開いていなければ先に開く）。セッション id を返す
+    @discardableResult
+    func appendScans(_ rfids: [String], target: TargetType, now: Date = Date()) throws -> String? {
+        guard !rfids.isEmpty else { return nil }
+        return try db.transaction { () -> String in
+            let sessionId: String
+            if let open = try openSessionId(target: target) {
+                sessionId = open
+            } else {
+                sessionId = UUID().uuidString.lowercased()
+                try db.run("INSERT INTO inventory_sessions (id, target, opened_at) VALUES (?, ?, ?)",
+                           [.text(sessionId), .text(target.rawValue), .text(ISO8601DateFormatter().string(from: now))])
+                try appendOutbox(.openSession(id: sessionId, target: target.rawValue))
+            }
+            try appendOutbox(.appendScans(sessionId: sessionId, rfids: rfids))
+            return sessionId
+        }
+    }
+
+    /// 開いているセッションを締め（discard なら破棄し）、対象の is_inventoried を戻す。締めたセッション id を返す
+    @discardableResult
+    func closeSession(target: TargetType, discard: Bool = false, now: Date = Date()) throws -> String? {
+        try db.transaction {
+            let open = try openSessionId(target: target)
+            if let open {
+                try db.run("UPDATE inventory_sessions SET closed_at = ? WHERE id = ?",
+                           [.text(ISO8601DateFormatter().string(from: now)), .text(open)])
+                try appendOutbox(.closeSession(id: open, discard: discard))
+            }
+            try db.run("""
+                UPDATE items SET is_inventoried = 0
+                WHERE is_inventoried = 1
+                  AND inventory_master_id IN (SELECT id FROM inventory_masters WHERE target = ?)
+                """, [.text(target.rawValue)])
+            try db.run("DELETE FROM kept_inventoried WHERE target = ?", [.text(target.rawValue)])
+            return open
+        }
+    }
+
+    // MARK: - Outbox ------------------------------------------------------------
+    private func appendOutbox(_ operation: OutboxOperation) throws {
+        try db.run("INSERT INTO outbox (operation) VALUES (?)", [.blob(try JSONEncoder().encode(operation))])
+    }
+
+    /// 古い順に limit 件
+    func pendingOutbox(limit: Int = 50) throws -> [OutboxEntry] {
+        let decoder = JSONDecoder()
+        return try db.query("SELECT seq, operation, attempts FROM outbox ORDER BY seq LIMIT ?", [.int(Int64(limit))]) {
+            OutboxEntry(seq: $0.int(0), operation: try decoder.decode(OutboxOperation.self, from: $0.blob(1)),
+                        attempts: Int($0.int(2)))
+        }
+    }
+
+    func outboxCount() throws -> Int {
+        Int(try db.query("SELECT COUNT(*) FROM outbox") { $0.int(0) }.first ?? 0)
+    }
+
+    func completeOutbox(_ seq: Int64) throws {
+        try db.run("DELETE FROM outbox WHERE seq = ?", [.int(seq)])
+    }
+
+    func failOutbox(_ seq: Int64) throws {
+        try db.run("UPDATE outbox SET attempts = attempts + 1 WHERE seq = ?", [.int(seq)])
+    }
+}
@@ -0,0 +1,120 @@
+//
+//  LocateManager.swift
+//  RFID_ios
+//
+//  Created on 2025/05/20.
+//
+//  1 タグの探索モード
+//    • 対象 UII だけを通す Select フィルタ + Q=0 / S0 で読取（周囲のタグは応答しないので対象の読取レートが最大になる）
+//    • 重複排除前の読取を RSSILocator に流し、読取毎に音を更新（SDK スレッド上で完結）
+//    • 画面は 20Hz で追従。終了時にフィルタと読取設定を元に戻す
+//
+
+import Foundation
+
+@MainActor
+final class LocateManager: ObservableObject {
+
+    // MARK: - Published -----------------------------------------------------
+    @Published private(set) var target: EPC?
+    @Published private(set) var isLocating = false
+    @Published private(set) var reading = RSSILocator.Reading.empty
+    @Published var isToneOn = true {
+        didSet { updateTone() }
+    }
+    @Published var calibration = LocateCalibration()
+
+    /// 画面の更新間隔
+    static let refreshInterval: TimeInterval = 0.05
+
+    // MARK: - Dependencies --------------------------------------------------
+    private let scanner: ScannerManager
+    private let tone = LocateTone()
+    private let metrics: HotPathMetrics
+
+    // MARK: - Run State -----------------------------------------------------
+    private var locator: RSSILocator?
+    private var refreshTask: Task<Void, Never>?
+    private var savedProfile: ScanProfile?
+    private var savedMasks: [SelectMask] = []
+
+    init(scannerManager: ScannerManager, metrics: HotPathMetrics = .shared) {
+        self.scanner = scannerManager
+        self.metrics = metrics
+    }
+
+    // MARK: - Public Controls -----------------------------------------------
+    func start(target: EPC) async {
+        if isLocating { await stop() }
+        Log.info(.scanner, "[Locate] 開始: \(target.hex)")
+
+        if scanner.readState == .reading { await scanner.setReading(false) }
+        savedMasks = scanner.selectFilter
+        savedProfile = await scanner.currentScanProfile()
+        await scanner.applySelectFilter([SelectMask(prefix: target, bitLength: target.count * 8)])
+        if let saved = savedProfile {
+            await scanner.applyScanProfile(ScanProfile(qParam: 0, session: .s0, linkProfile: saved.linkProfile))
+        }
+
+        let locator = RSSILocator(target: target, calibration: calibration)
+        let tone = self.tone
+        let metrics = self.metrics
+        // 音を止めている間もエンジン停止中の値更新になるだけなので条件分岐しない
+        locator.onSample = { reading in tone.update(reading) }
+        scanner.setRSSITap { uii, rssi, receivedAt in
+            guard locator.ingest(uii: uii, rssi: rssi, at: receivedAt) else { return }
+            metrics.record(.readToFeedback, seconds: ProcessInfo.processInfo.systemUptime - receivedAt)
+        }
+        self.locator = locator
+        self.target = target
+        reading = .empty
+        isLocating = true
+
+        updateTone()
+        if scanner.isConnected { await scanner.setReading(true) }
+        startRefresh()
+    }
+
+    func stop() async {
+        guard isLocating else { return }
+        refreshTask?.cancel()
+        refreshTask = nil
+        scanner.setRSSITap(nil)
+        tone.stop()
+        isLocating = false
+        locator = nil
+
+        if scanner.readState == .reading { await scanner.setReading(false) }
+        await scanner.applySelectFilter(savedMasks)
+        if let savedProfile { await scanner.applyScanProfile(savedProfile) }
+        savedProfile = nil
+        Log.info(.scanner, "[Locate] 終了 (最大 RSSI \(reading.peakRSSI.map { String(format: "%.1f", $0) } ?? "-"))")
+    }
+
+    // MARK: - Tone ----------------------------------------------------------
+    private func updateTone() {
+        guard isLocating, isToneOn else {
+            tone.stop()
+            return
+        }
+        do {
+            try tone.start()
+        } catch {
+            Log.warning(.scanner, "[Locate] 音の開始失敗: \(error.localizedDescription)")
+        }
+    }
+
+    // MARK: - Refresh -------------------------------------------------------
+    /// 見失いの判定と画面更新。音は読取毎に更新済みなので、ここでは見失ったときに止めるだけ
+    private func startRefresh() {
+        refreshTask = Task { [weak self] in
+            while !Task.isCancelled {
+                try? await Task.sleep(nanoseconds: UInt64(LocateManager.refreshInterval * 1_000_000_000))
+                guard let self, let locator = self.locator, !Task.isCancelled else { return }
+                let current = locator.reading(at: ProcessInfo.processInfo.systemUptime)
+                if current.isLost { self.tone.silence() }
+                if current != self.reading { self.reading = current }
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+//
+//  LocateTone.swift
+//  RFID_ios
+//
+//  Created on 2025/05/20.
+//
+//  探索用の音（近いほど高く・速く鳴る）
+//    • スキャナのブザーは固定パターンで BLE 越しのコマンドになるため、端末側で鳴らす
+//    • AVAudioSourceNode でサイン波を生成。update() は値を書き換えるだけなので SDK スレッドから直接呼べる
+//    • IO バッファを 5ms に下げ、読取 → 音の変化を 50ms 以内に収める
+//
+
+import AVFoundation
+import os
+
+final class LocateTone {
+
+    /// レンダースレッドと共有する値（書き込み側とは unfair lock、レンダー側は trylock）
+    private struct Parameters {
+        var frequency = 440.0
+        /// 鳴動周期 (秒)。0 なら連続音
+        var period = 0.6
+        var isSilent = true
+    }
+
+    /// 近さ 0 → 1 で 2 オクターブ上げる
+    static let baseFrequency = 440.0
+    static let octaves = 2.0
+    /// 近さ 0 → 1 で鳴動周期を短くする。連続音になる近さ
+    static let slowestPeriod = 0.6
+    static let fastestPeriod = 0.06
+    static let continuousProximity = 0.92
+    static let beepLength = 0.04
+
+    private let engine = AVAudioEngine()
+    private var source: AVAudioSourceNode?
+    private let lock: UnsafeMutablePointer<os_unfair_lock>
+    private var shared = Parameters()
+    private(set) var isRunning = false
+
+    init() {
+        lock = .allocate(capacity: 1)
+        lock.initialize(to: os_unfair_lock())
+    }
+
+    deinit {
+        stop()
+        lock.deinitialize(count: 1)
+        lock.deallocate()
+    }
+
+    // MARK: - Control ------------------------------------------------------
+    func start() throws {
+        guard !isRunning else { return }
+        let session = AVAudioSession.sharedInstance()
+        try session.setCategory(.playback, options: [.mixWithOthers])
+        try? session.setPreferredIOBufferDuration(0.005)
+        try session.setActive(true)
+
+        let format = engine.outputNode.inputFormat(forBus: 0)
+        let sampleRate = format.sampleRate
+        // レンダースレッド専用の状態
+        var phase = 0.0
+        var clock = 0.0
+        var current = Parameters()
+        let node = AVAudioSourceNode { [unowned self] _, _, frameCount, audioBufferList -> OSStatus in
+            if os_unfair_lock_trylock(self.lock) {
+                current = self.shared
+                os_unfair_lock_unlock(self.lock)
+            }
+            let buffers = UnsafeMutableAudioBufferListPointer(audioBufferList)
+            let step = 2 * Double.pi * current.frequency / sampleRate
+            for frame in 0..<Int(frameCount) {
+                clock += 1 / sampleRate
+                if current.period > 0, clock >= current.period { clock = 0 }
+                let audible = !current.isSilent && (current.period == 0 || clock < LocateTone.beepLength)
+                let sample = audible ? Float(sin(phase)) * 0.3 : 0
+                phase += step
+                if phase > 2 * Double.pi { phase -= 2 * Double.pi }
+                for buffer in buffers {
+                    buffer.mData?.assumingMemoryBound(to: Float.self)[frame] = sample
+                }
+            }
+            return noErr
+        }
+        let mono = AVAudioFormat(standardFormatWithSampleRate: sampleRate, channels: 1)
+        engine.attach(node)
+        engine.connect(node, to: engine.mainMixerNode, format: mono)
+        try engine.start()
+        source = node
+        isRunning = true
+    }
+
+    func stop() {
+        guard isRunning else { return }
+        engine.stop()
+        if let source { engine.detach(source) }
+        source = nil
+        isRunning = false
+        try? AVAudioSession.sharedInstance().setActive(false, options: [.notifyOthersOnDeactivation])
+    }
+
+    /// 近さに合わせて音を変える（どのスレッドからでも可）
+    func update(_ reading: RSSILocator.Reading) {
+        var next = Parameters()
+        next.isSilent = reading.isLost
+        next.frequency = LocateTone.baseFrequency * pow(2, LocateTone.octaves * reading.proximity)
+        next.period = reading.proximity >= LocateTone.continuousProximity
+            ? 0
+            : LocateTone.slowestPeriod + (LocateTone.fastestPeriod - LocateTone.slowestPeriod) * reading.proximity
+        os_unfair_lock_lock(lock)
+        shared = next
+        os_unfair_lock_unlock(lock)
+    }
+
+    func silence() {
+        os_unfair_lock_lock(lock)
+        shared.isSilent = true
+        os_unfair_lock_unlock(lock)
+    }
+}
@@ -0,0 +1,138 @@
+//
+//  Log.swift
+//  RFID_ios
+//
+//  Created on 2025/05/19.
+//
+//  レベル・カテゴリ付きのログ
+//    • メッセージは @autoclosure。minimumLevel 未満ならその場で捨て、文字列補間は評価しない
+//    • debug はビルド条件 DEBUG / RFID_LOG_DEBUG が無いと呼び出しごと消える
+//    • 出力はメモリ上の固定長リングバッファ（起動時に確保）。dump() で取り出す
+//    • echoToConsole のときだけ print も行う（Release の既定は off）
+//
+
+import Foundation
+
+enum LogLevel: Int, Comparable, CaseIterable, Codable {
+    case debug, info, warning, error
+
+    static func < (lhs: LogLevel, rhs: LogLevel) -> Bool { lhs.rawValue < rhs.rawValue }
+
+    var symbol: String {
+        switch self {
+        case .debug:   return "🔸"
+        case .info:    return "🟢"
+        case .warning: return "⚠️"
+        case .error:   return "🛑"
+        }
+    }
+}
+
+enum LogCategory: String, CaseIterable, Codable {
+    case scanner, connection, ingest, compare, settings, sync
+}
+
+struct LogEntry: Equatable {
+    let time: Date
+    let level: LogLevel
+    let category: LogCategory
+    let message: String
+
+    var line: String {
+        "\(LogEntry.timeFormatter.string(from: time)) \(level.symbol) [\(category.rawValue)] \(message)"
+    }
+
+    private static let timeFormatter: DateFormatter = {
+        let f = DateFormatter()
+        f.locale = Locale(identifier: "en_US_POSIX")
+        f.dateFormat = "HH:mm:ss.SSS"
+        return f
+    }()
+}
+
+/// ログの保存先（固定長、古いものから上書き）
+final class LogStore: @unchecked Sendable {
+    private let lock = NSLock()
+    private var ring: RingBuffer<LogEntry>
+
+    init(capacity: Int) {
+        ring = RingBuffer(capacity: capacity)
+    }
+
+    func append(_ entry: LogEntry) {
+        lock.lock()
+        ring.pushOverwriting(entry)
+        lock.unlock()
+    }
+
+    func entries(minimumLevel: LogLevel = .debug) -> [LogEntry] {
+        lock.lock()
+        defer { lock.unlock() }
+        return ring.elements.filter { $0.level >= minimumLevel }
+    }
+
+    func removeAll() {
+        lock.lock()
+        ring.removeAll()
+        lock.unlock()
+    }
+}
+
+enum Log {
+    /// 起動時に設定する。実行中の変更は次の呼び出しから効く
+    static var minimumLevel: LogLevel = {
+        #if DEBUG
+        return .debug
+        #else
+        return .info
+        #endif
+    }()
+
+    static var echoToConsole: Bool = {
+        #if DEBUG
+        return true
+        #else
+        return false
+        #endif
+    }()
+
+    static let store = LogStore(capacity: 4096)
+
+    // MARK: - Emit ---------------------------------------------------------
+    /// 読取毎・タグ毎など頻度の高いもの。Release ではコンパイルされない
+    @inline(__always)
+    static func debug(_ category: LogCategory, _ message: @autoclosure () -> String) {
+        #if DEBUG || RFID_LOG_DEBUG
+        emit(.debug, category, message)
+        #endif
+    }
+
+    @inline(__always)
+    static func info(_ category: LogCategory, _ message: @autoclosure () -> String) {
+        emit(.info, category, message)
+    }
+
+    @inline(__always)
+    static func warning(_ category: LogCategory, _ message: @autoclosure () -> String) {
+        emit(.warning, category, message)
+    }
+
+    @inline(__always)
+    static func error(_ category: LogCategory, _ message: @autoclosure () -> String) {
+        emit(.error, category, message)
+    }
+
+    @inline(__always)
+    private static func emit(_ level: LogLevel, _ category: LogCategory, _ message: () -> String) {
+        guard level >= minimumLevel else { return }
+        let entry = LogEntry(time: Date(), level: level, category: category, message: message())
+        store.append(entry)
+        if echoToConsole { print("\(level.symbol) [\(category.rawValue)] \(entry.message)") }
+    }
+
+    // MARK: - Dump ---------------------------------------------------------
+    /// バッファの中身を 1 行 1 件で返す
+    static func dump(minimumLevel: LogLevel = .debug) -> String {
+        store.entries(minimumLevel: minimumLevel).map(\.line).joined(separator: "\n")
+    }
+}
@@ -0,0 +1,47 @@
+//
+//  LogView.swift
+//  RFID_ios
+//
+//  Created on 2025/05/19.
+//
+//  メモリ上のログ（Log.store）の確認と共有用のデバッグ画面
+//
+
+import SwiftUI
+
+struct LogView: View {
+
+    @State private var minimumLevel: LogLevel = .info
+    @State private var text = ""
+
+    var body: some View {
+        VStack(spacing: 0) {
+            Picker("Level", selection: $minimumLevel) {
+                ForEach(LogLevel.allCases, id: \.self) { Text("\($0)").tag($0) }
+            }
+            .pickerStyle(.segmented)
+            .padding()
+
+            ScrollView {
+                Text(text.isEmpty ? "ログはありません" : text)
+                    .font(.caption2.monospaced())
+                    .frame(maxWidth: .infinity, alignment: .leading)
+                    .textSelection(.enabled)
+                    .padding(.horizontal)
+            }
+        }
+        .navigationTitle("Log")
+        .toolbar {
+            ToolbarItemGroup(placement: .navigationBarTrailing) {
+                Button { refresh() } label: { Image(systemName: "arrow.clockwise") }
+                ShareLink(item: text) { Image(systemName: "square.and.arrow.up") }
+            }
+        }
+        .onAppear { refresh() }
+        .onChange(of: minimumLevel) { _ in refresh() }
+    }
+
+    private func refresh() {
+        text = Log.dump(minimumLevel: minimumLevel)
+    }
+}
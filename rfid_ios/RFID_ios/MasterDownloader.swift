@@ -0,0 +1,130 @@
+//
+//  MasterDownloader.swift
+//  RFID_ios
+//
+//  Created on 2025/05/26.
+//
+//  対象マスター（items + inventory_masters）の初回ダウンロードを id のキーセットで並列に取る
+//    • id（UUID）の先頭 16 進 1 桁で partitions 個の範囲に分け、範囲毎に id 昇順でページを辿る
+//    • 同時に取りに行くページは maxConcurrentPages 本まで
+//    • ページはメインスレッド外でデコードし、届いた順に onPage へ渡す（最初のページから照合できる）
+//    • Task のキャンセルでページの合間に止まる
+//    • 次のページは応答の最後の行の id から辿る（id が読めなければ黙って止めずに失敗にする）
+//  ページの取得は fetch で注入する（Supabase に依存しない）
+//
+
+import Foundation
+
+/// id の範囲 [lower, upper)。upper が nil なら上限なし
+struct MasterIdRange: Equatable, Hashable {
+    let lower: String
+    let upper: String?
+
+    /// UUID の先頭 1 桁で count 個（1〜16）に分ける
+    static func partitions(_ count: Int) -> [MasterIdRange] {
+        let count = min(max(count, 1), 16)
+        let digits = Array("0123456789abcdef")
+        let bounds = (0..<count).map { i -> String in
+            let digit = digits[i * 16 / count]
+            return String(digit) + "0000000-0000-0000-0000-000000000000"
+        }
+        return bounds.enumerated().map { i, lower in
+            MasterIdRange(lower: lower, upper: i + 1 < bounds.count ? bounds[i + 1] : nil)
+        }
+    }
+}
+
+struct MasterDownloadProgress: Equatable {
+    var pagesLoaded = 0
+    var rowsLoaded = 0
+    /// サーバーが返した件数（取れなければ nil）
+    var totalRows: Int?
+    var rangesDone = 0
+    var rangeCount = 0
+
+    /// 0〜1。件数が分からなければ終わった範囲の割合
+    var fraction: Double {
+        if let totalRows, totalRows > 0 { return min(Double(rowsLoaded) / Double(totalRows), 1) }
+        return rangeCount > 0 ? Double(rangesDone) / Double(rangeCount) : 0
+    }
+}
+
+struct MasterDownloadPolicy {
+    var pageSize = 1000
+    var maxConcurrentPages = 4
+    var partitions = 16
+}
+
+final class MasterDownloader {
+
+    /// range 内で afterId より後を id 昇順に limit 件取り、応答の JSON を返す
+    typealias FetchPage = (_ range: MasterIdRange, _ afterId: String?, _ limit: Int) async throws -> Data
+
+    let policy: MasterDownloadPolicy
+    private let fetch: FetchPage
+
+    init(policy: MasterDownloadPolicy = MasterDownloadPolicy(), fetch: @escaping FetchPage) {
+        self.policy = policy
+        self.fetch = fetch
+    }
+
+    /// 全範囲を取り切るまで進める。onPage / onProgress は届いた順に 1 つずつ呼ぶ
+    func run(totalRows: Int? = nil,
+             onPage: @escaping @MainActor (ItemJoinPayload) async throws -> Void,
+             onProgress: @escaping @MainActor (MasterDownloadProgress) -> Void) async throws {
+        let ranges = MasterIdRange.partitions(policy.partitions)
+        var progress = MasterDownloadProgress(totalRows: totalRows, rangeCount: ranges.count)
+        await onProgress(progress)
+
+        try await withThrowingTaskGroup(of: RangeStep.self) { group in
+            var queued = ranges[...]
+            func startNext(_ step: RangeStep?) {
+                if let step, let next = step.next {
+                    group.addTask { try await self.page(next.range, after: next.afterId) }
+                } else if let range = queued.popFirst() {
+                    group.addTask { try await self.page(range, after: nil) }
+                }
+            }
+            for _ in 0..<min(policy.maxConcurrentPages, ranges.count) { startNext(nil) }
+
+            while let step = try await group.next() {
+                try Task.checkCancellation()
+                if !step.payload.items.isEmpty {
+                    try await onPage(step.payload)
+                }
+                progress.pagesLoaded += 1
+                progress.rowsLoaded += step.rows
+                if step.next == nil { progress.rangesDone += 1 }
+                await onProgress(progress)
+                startNext(step)
+            }
+        }
+    }
+
+    // MARK: - Page -----------------------------------------------------------
+    private struct RangeStep {
+        let payload: ItemJoinPayload
+        let rows: Int
+        /// 同じ範囲の次のページ（最後なら nil）
+        let next: RangeCursor?
+    }
+
+    private struct RangeCursor {
+        let range: MasterIdRange
+        let afterId: String
+    }
+
+    private func page(_ range: MasterIdRange, after afterId: String?) async throws -> RangeStep {
+        try Task.checkCancellation()
+        let data = try await fetch(range, afterId, policy.pageSize)
+        let payload = try ItemJoinDecoder.decode(data)
+        let rows = payload.items.count + payload.skipped
+        // 捨てた行も含めた最後の行で進める（最後が不正な行でも範囲の残りを取りこぼさない）
+        var next: RangeCursor?
+        if rows >= policy.pageSize {
+            guard let lastId = payload.lastRow?.id else { throw ItemJoinError.missingCursor("id") }
+            next = RangeCursor(range: range, afterId: lastId)
+        }
+        return RangeStep(payload: payload, rows: rows, next: next)
+    }
+}
@@ -0,0 +1,101 @@
+//
+//  MasterPrefilter.swift
+//  RFID_ios
+//
+//  Created on 2025/05/28.
+//
+//  数十万件のマスター向けの Bloom フィルタ（CompareEngine の前段）
+//    • 「無い」と答えたタグは確実にマスター外。辞書を引かずに外れにする
+//    • 「あるかも」と答えたタグだけ正確な集合（CompareEngine の辞書）で確かめる
+//    • 1 件あたり約 1.2 byte（偽陽性 1%）。辞書（約 60 byte/件）よりずっと小さくキャッシュに載る
+//  ビット数は 2 のべき乗に切り上げ、k 本のハッシュは EPC.fingerprint からの二重ハッシュで作る
+//
+
+import Foundation
+
+struct MasterBloomFilter {
+
+    /// 作ったときに想定した件数（超えたら作り直す）
+    let capacity: Int
+    let bitCount: Int
+    let hashCount: Int
+    private(set) var insertedCount = 0
+    private var words: [UInt64]
+    private let mask: UInt64
+
+    init(capacity: Int, falsePositiveRate: Double) {
+        let n = Double(max(capacity, 1))
+        let p = min(max(falsePositiveRate, 1e-6), 0.5)
+        // m = -n ln p / (ln 2)^2、k = m / n ln 2
+        let bits = max(Int((-n * log(p) / (log(2) * log(2))).rounded(.up)), 64)
+        let rounded = 1 << (Int.bitWidth - (bits - 1).leadingZeroBitCount)
+        self.capacity = max(capacity, 1)
+        bitCount = rounded
+        hashCount = max(Int((Double(rounded) / n * log(2)).rounded()), 1)
+        words = [UInt64](repeating: 0, count: rounded / 64)
+        mask = UInt64(rounded - 1)
+    }
+
+    init<S: Sequence>(_ tags: S, count: Int, falsePositiveRate: Double) where S.Element == EPC {
+        self.init(capacity: count, falsePositiveRate: falsePositiveRate)
+        for uii in tags { insert(uii) }
+    }
+
+    mutating func insert(_ uii: EPC) {
+        let (h1, h2) = Self.hashes(uii)
+        for i in 0..<UInt64(hashCount) {
+            let bit = (h1 &+ i &* h2) & mask
+            words[Int(bit >> 6)] |= 1 << (bit & 63)
+        }
+        insertedCount += 1
+    }
+
+    /// false ならマスター外で確定
+    func mayContain(_ uii: EPC) -> Bool {
+        let (h1, h2) = Self.hashes(uii)
+        for i in 0..<UInt64(hashCount) {
+            let bit = (h1 &+ i &* h2) & mask
+            if words[Int(bit >> 6)] & (1 << (bit & 63)) == 0 { return false }
+        }
+        return true
+    }
+
+    var memoryBytes: Int { words.count * MemoryLayout<UInt64>.stride }
+
+    /// 入れた件数での理論上の偽陽性率 (1 - e^(-kn/m))^k
+    var expectedFalsePositiveRate: Double {
+        let k = Double(hashCount)
+        return pow(1 - exp(-k * Double(insertedCount) / Double(bitCount)), k)
+    }
+
+    private static func hashes(_ uii: EPC) -> (UInt64, UInt64) {
+        let h = uii.fingerprint
+        // 2 本目は奇数にして全ビットを巡るようにする
+        return (h, (h >> 32 | h << 32) | 1)
+    }
+}
+
+/// 前段フィルタの効き目（デバッグ画面用）
+struct MasterPrefilterReport: Equatable {
+    var keys = 0
+    var memoryBytes = 0
+    var hashCount = 0
+    var expectedFalsePositiveRate = 0.0
+    /// フィルタで落としたタグ（辞書を引かずに外れにした）
+    var rejected = 0
+    /// フィルタを通って辞書でも一致したタグ
+    var confirmed = 0
+    /// フィルタを通ったが辞書に無かったタグ
+    var falsePositives = 0
+
+    /// 実測の偽陽性率（マスター外のうちフィルタを通ってしまった割合）
+    var observedFalsePositiveRate: Double? {
+        let negatives = rejected + falsePositives
+        return negatives > 0 ? Double(falsePositives) / Double(negatives) : nil
+    }
+
+    /// 同じ件数を辞書（EPC → 位置）で持つときの概算（負荷率 0.75）
+    var exactSetBytes: Int {
+        Int(Double(keys * (MemoryLayout<EPC>.stride + MemoryLayout<Int>.stride)) / 0.75)
+    }
+}
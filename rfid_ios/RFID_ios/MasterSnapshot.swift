@@ -0,0 +1,280 @@
+//
+//  MasterSnapshot.swift
+//  RFID_ios
+//
+//  Created on 2025/05/27.
+//
+//  対象（TargetType）毎のマスターを詰めたバイナリファイル。起動直後の突き合わせに使う
+//    • EPC 列は昇順に並べた 16 byte 固定長（+ 長さ 1 byte）。引くときは二分探索
+//    • 行毎に items.id・マスター番号・棚卸し済みフラグ、マスター毎に id / col_1 / product_code を持つ
+//    • 文字列は重複を除いた文字列表にまとめ、番号で参照する
+//    • ファイルはメモリマップで開き、デコードせずにその場で読む（JSON / SQLite を経由しない）
+//  中身は書いた時点の端末ストアの写し。正は LocalItemStore で、差分同期の後に作り直す
+//
+//  レイアウト（数値はリトルエンディアン）
+//    header  : magic "RFMS", version, itemCount, masterCount, stringCount, stringBytes（各 UInt32）
+//    epcs    : itemCount × 16 byte（ビッグエンディアン、未使用部は 0）
+//    lengths : itemCount × 1 byte（4 byte 境界まで 0 埋め）
+//    rows    : itemCount × (itemId, masterIndex, flags)
+//    masters : masterCount × (id, col1, productCode)   ※ 文字列番号。nil は UInt32.max
+//    offsets : (stringCount + 1) × UInt32
+//    strings : UTF-8
+//
+
+import Foundation
+
+enum MasterSnapshotError: LocalizedError, Equatable {
+    case corrupt(String)
+    case version(UInt32)
+
+    var errorDescription: String? {
+        switch self {
+        case .corrupt(let reason): return "マスターのスナップショットが壊れています: \(reason)"
+        case .version(let v):      return "マスターのスナップショットの形式が違います: v\(v)"
+        }
+    }
+}
+
+final class MasterSnapshot: @unchecked Sendable {
+
+    static let formatVersion: UInt32 = 1
+    private static let magic: UInt32 = 0x534D_4652   // "RFMS"
+    private static let headerSize = 24
+    private static let rowSize = 12
+    private static let masterSize = 12
+    private static let none = UInt32.max
+
+    /// マスターの表示に要る列だけ
+    struct Master: Equatable {
+        let id: String
+        let col1: String
+        let productCode: String?
+    }
+
+    let count: Int
+    let masterCount: Int
+    private let data: Data
+    private let stringCount: Int
+    private let lengthsOffset: Int
+    private let rowsOffset: Int
+    private let mastersOffset: Int
+    private let stringOffsetsOffset: Int
+    private let stringsOffset: Int
+
+    // MARK: - Open -----------------------------------------------------------
+    /// ファイルをメモリマップで開く（読むのは使った部分だけ）
+    static func open(_ url: URL) throws -> MasterSnapshot {
+        try MasterSnapshot(data: Data(contentsOf: url, options: .alwaysMapped))
+    }
+
+    /// 見出し・大きさと、引くときに使う長さ・番号・オフセットが範囲内かを確かめる
+    /// （文字列や EPC はデコードしない。壊れたファイルで引いたときに落ちないようにするため）
+    init(data: Data) throws {
+        guard data.count >= Self.headerSize else { throw MasterSnapshotError.corrupt("header") }
+        let word = { (i: Int) in data.withUnsafeBytes { Self.u32($0, i * 4) } }
+        guard word(0) == Self.magic else { throw MasterSnapshotError.corrupt("magic") }
+        guard word(1) == Self.formatVersion else { throw MasterSnapshotError.version(word(1)) }
+        count = Int(word(2))
+        masterCount = Int(word(3))
+        stringCount = Int(word(4))
+        let stringBytes = Int(word(5))
+
+        lengthsOffset = Self.headerSize + count * EPC.maxByteCount
+        rowsOffset = Self.aligned(lengthsOffset + count)
+        mastersOffset = rowsOffset + count * Self.rowSize
+        stringOffsetsOffset = mastersOffset + masterCount * Self.masterSize
+        stringsOffset = stringOffsetsOffset + (stringCount + 1) * 4
+        guard data.count == stringsOffset + stringBytes else { throw MasterSnapshotError.corrupt("size") }
+        self.data = data
+        try validate(stringBytes: stringBytes)
+    }
+
+    private func validate(stringBytes: Int) throws {
+        try data.withUnsafeBytes { raw in
+            for i in 0..<count where !(1...EPC.maxByteCount).contains(Int(raw[lengthsOffset + i])) {
+                throw MasterSnapshotError.corrupt("length \(i)")
+            }
+            var previous: UInt32 = 0
+            for i in 0...stringCount {
+                let offset = Self.u32(raw, stringOffsetsOffset + i * 4)
+                guard offset >= previous, Int(offset) <= stringBytes else { throw MasterSnapshotError.corrupt("string offset \(i)") }
+                previous = offset
+            }
+            // 文字列番号は表の範囲内か none（items.id とマスター id は必須）
+            let isString = { (number: UInt32, required: Bool) in
+                number == Self.none ? !required : Int(number) < self.stringCount
+            }
+            for i in 0..<count {
+                let base = rowsOffset + i * Self.rowSize
+                guard isString(Self.u32(raw, base), true),
+                      Int(Self.u32(raw, base + 4)) < masterCount else { throw MasterSnapshotError.corrupt("row \(i)") }
+            }
+            for i in 0..<masterCount {
+                let base = mastersOffset + i * Self.masterSize
+                guard isString(Self.u32(raw, base), true),
+                      isString(Self.u32(raw, base + 4), false),
+                      isString(Self.u32(raw, base + 8), false) else { throw MasterSnapshotError.corrupt("master \(i)") }
+            }
+        }
+    }
+
+    // MARK: - Lookup ---------------------------------------------------------
+    func epc(at index: Int) -> EPC {
+        data.withUnsafeBytes { raw in
+            let start = Self.headerSize + index * EPC.maxByteCount
+            let length = Int(raw[lengthsOffset + index])
+            return EPC(bytes: UnsafeRawBufferPointer(rebasing: raw[start..<start + length]))!
+        }
+    }
+
+    /// 昇順のまま全件（CompareEngine への読込み用）
+    var epcs: LazyMapSequence<Range<Int>, EPC> { (0..<count).lazy.map(epc(at:)) }
+
+    /// 二分探索で行番号を引く
+    func index(of uii: EPC) -> Int? {
+        var lo = 0, hi = count
+        while lo < hi {
+            let mid = (lo + hi) / 2
+            if epc(at: mid) < uii { lo = mid + 1 } else { hi = mid }
+        }
+        return lo < count && epc(at: lo) == uii ? lo : nil
+    }
+
+    func itemId(at index: Int) -> String { string(row(index, 0))! }
+
+    func isInventoried(at index: Int) -> Bool { row(index, 2) & 1 != 0 }
+
+    func masterIndex(at index: Int) -> Int { Int(row(index, 1)) }
+
+    func master(at index: Int) -> Master {
+        let field = { (i: Int) in self.data.withUnsafeBytes { Self.u32($0, self.mastersOffset + index * Self.masterSize + i * 4) } }
+        return Master(id: string(field(0))!, col1: string(field(1)) ?? "", productCode: string(field(2)))
+    }
+
+    private func row(_ index: Int, _ field: Int) -> UInt32 {
+        data.withUnsafeBytes { Self.u32($0, rowsOffset + index * Self.rowSize + field * 4) }
+    }
+
+    private func string(_ number: UInt32) -> String? {
+        guard number != Self.none, Int(number) < stringCount else { return nil }
+        return data.withUnsafeBytes { raw in
+            let start = Int(Self.u32(raw, stringOffsetsOffset + Int(number) * 4))
+            let end = Int(Self.u32(raw, stringOffsetsOffset + Int(number) * 4 + 4))
+            return String(decoding: UnsafeRawBufferPointer(rebasing: raw[stringsOffset + start..<stringsOffset + end]),
+                          as: UTF8.self)
+        }
+    }
+
+    private static func u32(_ raw: UnsafeRawBufferPointer, _ offset: Int) -> UInt32 {
+        UInt32(littleEndian: raw.loadUnaligned(fromByteOffset: offset, as: UInt32.self))
+    }
+
+    private static func aligned(_ offset: Int) -> Int { (offset + 3) & ~3 }
+
+    // MARK: - Build ----------------------------------------------------------
+    /// 端末ストアの読込み結果から作る。RFID が不正な行は落とし、同じ EPC は 1 行だけ残す
+    static func build(items: [Item], masters: [String: InventoryMaster]) -> Data {
+        var strings = StringTable()
+        var masterNumbers: [String: Int] = [:]
+        var masterFields: [UInt32] = []
+        for master in masters.values.sorted(by: { $0.id < $1.id }) {
+            masterNumbers[master.id] = masterNumbers.count
+            masterFields += [strings.add(master.id), strings.add(master.col1), strings.add(master.productCode)]
+        }
+
+        var rows: [(epc: EPC, item: Item, master: Int)] = []
+        rows.reserveCapacity(items.count)
+        for item in items {
+            guard let epc = EPC(hex: item.rfid), let master = masterNumbers[item.inventoryMasterId] else { continue }
+            rows.append((epc, item, master))
+        }
+        rows.sort { $0.epc < $1.epc }
+        var unique: [(epc: EPC, item: Item, master: Int)] = []
+        unique.reserveCapacity(rows.count)
+        for row in rows where unique.last?.epc != row.epc { unique.append(row) }
+        // 見出しに文字列の数を書くので先に表へ入れておく
+        let itemIds = unique.map { strings.add($0.item.id) }
+
+        var out = Data()
+        out.reserveCapacity(headerSize + unique.count * (EPC.maxByteCount + 1 + rowSize) + strings.bytes.count)
+        for word in [magic, formatVersion, UInt32(unique.count), UInt32(masterFields.count / 3),
+                     UInt32(strings.offsets.count - 1), UInt32(strings.bytes.count)] {
+            append(word, to: &out)
+        }
+        for row in unique {
+            let bytes = row.epc.bytes
+            out.append(contentsOf: bytes)
+            out.append(contentsOf: [UInt8](repeating: 0, count: EPC.maxByteCount - bytes.count))
+        }
+        out.append(contentsOf: unique.map { UInt8($0.epc.count) })
+        out.append(contentsOf: [UInt8](repeating: 0, count: aligned(out.count) - out.count))
+        for (row, itemId) in zip(unique, itemIds) {
+            append(itemId, to: &out)
+            append(UInt32(row.master), to: &out)
+            append(row.item.isInventoried ? 1 : 0, to: &out)
+        }
+        for field in masterFields { append(field, to: &out) }
+        for offset in strings.offsets { append(offset, to: &out) }
+        out.append(strings.bytes)
+        return out
+    }
+
+    private static func append(_ word: UInt32, to data: inout Data) {
+        withUnsafeBytes(of: word.littleEndian) { data.append(contentsOf: $0) }
+    }
+
+    /// 重複を除いた文字列表
+    private struct StringTable {
+        private var numbers: [String: UInt32] = [:]
+        private(set) var offsets: [UInt32] = [0]
+        private(set) var bytes = Data()
+
+        mutating func add(_ string: String?) -> UInt32 {
+            guard let string else { return MasterSnapshot.none }
+            if let number = numbers[string] { return number }
+            let number = UInt32(offsets.count - 1)
+            numbers[string] = number
+            bytes.append(contentsOf: string.utf8)
+            offsets.append(UInt32(bytes.count))
+            return number
+        }
+    }
+}
+
+// MARK: - Files ----------------------------------------------------------------
+
+/// 対象毎のスナップショットの置き場所
+struct MasterSnapshotStore: Sendable {
+    let directory: URL
+
+    static func openDefault() throws -> MasterSnapshotStore {
+        let dir = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("MasterSnapshots", isDirectory: true)
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        return MasterSnapshotStore(directory: dir)
+    }
+
+    func url(for target: TargetType) -> URL {
+        directory.appendingPathComponent("\(target.rawValue).rfms")
+    }
+
+    /// 無い・形式が古い・壊れている場合は nil（作り直すまで使わない）
+    func load(_ target: TargetType) -> MasterSnapshot? {
+        let url = url(for: target)
+        guard FileManager.default.fileExists(atPath: url.path) else { return nil }
+        do {
+            return try MasterSnapshot.open(url)
+        } catch {
+            Log.warning(.sync, "[Snapshot] 読めないため破棄: \(target.rawValue) \(error)")
+            try? FileManager.default.removeItem(at: url)
+            return nil
+        }
+    }
+
+    /// 書き終わってから差し替える（マップ中の古いファイルはそのまま読める）
+    func save(items: [Item], masters: [String: InventoryMaster], for target: TargetType) throws {
+        let data = MasterSnapshot.build(items: items, masters: masters)
+        try data.write(to: url(for: target), options: .atomic)
+        Log.info(.sync, "[Snapshot] 更新: \(target.rawValue) \(items.count) 件 \(data.count / 1024) KB")
+    }
+}
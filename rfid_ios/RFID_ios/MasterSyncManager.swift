@@ -0,0 +1,289 @@
+//
+//  MasterSyncManager.swift
+//  RFID_ios
+//
+//  Created on 2025/05/24.
+//
+//  LocalItemStore とサーバーの同期
+//    • pull(): updated_at + id のキーセットで items / inventory_masters の差分をページ毎に取り込む
+//    • downloadTarget(): 対象の items を MasterDownloader で並列に初回ダウンロードする
+//    • 送信待ち（outbox）は古い順に 1 件ずつ送り、失敗したらそこで止めてバックオフ後に再開する
+//  通信できなくても端末のストアで棚卸しは続けられる
+//
+
+import Foundation
+import Combine
+import Supabase
+
+@MainActor
+final class MasterSyncManager: ObservableObject {
+
+    @Published private(set) var isSyncing = false
+    @Published private(set) var lastSyncedAt: Date?
+    @Published private(set) var pendingUploads = 0
+    @Published private(set) var lastError: String?
+    /// 端末に持っている行数
+    @Published private(set) var localItemCount = 0
+    @Published private(set) var localMasterCount = 0
+
+    let store: LocalItemStore
+
+    /// 1 ページの行数（PostgREST の max-rows より小さくする）
+    static let pageSize = 1000
+    /// 対象の初回ダウンロード（並列ページ数は回線に合わせて変えられる）
+    var downloadPolicy = MasterDownloadPolicy()
+    static let maxUploadDelay: TimeInterval = 60
+
+    private var uploadTask: Task<Void, Never>?
+    private var retryTask: Task<Void, Never>?
+
+    init(store: LocalItemStore) {
+        self.store = store
+        refreshCounts()
+    }
+
+    // MARK: - Pull -----------------------------------------------------------
+    /// サーバーの差分を取り込む。取り込んだ行数を返す（通信できなければ 0）
+    @discardableResult
+    func pull() async -> Int {
+        guard !isSyncing else { return 0 }
+        isSyncing = true
+        defer { isSyncing = false }
+        do {
+            // items は inventory_master_id で引くので、マスターを先に入れる
+            let masters = try await pullTable(.inventoryMasters) { data, store in
+                let rows = try JSONDecoder().decode([InventoryMaster].self, from: data)
+                try store.upsert(masters: rows)
+                return (rows.count, rows.last.map { SyncCursor(updatedAt: $0.updatedAt, id: $0.id) })
+            }
+            // items は対象毎の初回ダウンロードで取るので、差分はその時点より後だけ
+            try await seedItemCursorIfNeeded()
+            let items = try await pullTable(.items) { data, store in
+                let payload = try ItemJoinDecoder.decode(data)
+                try store.upsert(items: payload.items)
+                // 捨てた行も含めた最後の行でカーソルを進める
+                guard let last = payload.lastRow else { return (0, nil) }
+                guard let id = last.id else { throw ItemJoinError.missingCursor("id") }
+                guard let updatedAt = last.updatedAt else { throw ItemJoinError.missingCursor("updated_at") }
+                return (payload.items.count + payload.skipped, SyncCursor(updatedAt: updatedAt, id: id))
+            }
+            lastSyncedAt = Date()
+            lastError = nil
+            refreshCounts()
+            Log.info(.sync, "[Sync] 差分取込: マスター \(masters) 件, アイテム \(items) 件")
+            return masters + items
+        } catch {
+            lastError = "同期エラー: \(error.localizedDescription)"
+            Log.warning(.sync, "[Sync] 差分取込失敗（端末のデータで続行）: \(error)")
+            return 0
+        }
+    }
+
+    /// 全件取り直し（サーバー側で削除された行を消す）
+    /// 送信待ちは先に送っておく（送れなかった分も outbox には残る）。端末の棚卸し済みはストアが残す
+    func fullResync() async {
+        requestUpload()
+        await waitForUploads()
+        do {
+            try store.resetCursors()
+        } catch {
+            lastError = "同期エラー: \(error.localizedDescription)"
+            return
+        }
+        await pull()
+    }
+
+    /// カーソルより後をページ毎に取り込み、ページ毎にカーソルを進める
+    /// apply はページの応答をデコードしてストアに入れ、行数と次のカーソルを返す（メインスレッド外で呼ぶ）
+    private func pullTable(_ table: LocalItemStore.Table,
+                           apply: @escaping (Data, LocalItemStore) throws -> (rows: Int, next: SyncCursor?)) async throws -> Int {
+        let store = self.store
+        var cursor = try store.cursor(for: table)
+        var total = 0
+        while true {
+            var query = supabase.from(table.rawValue).select()
+            if let cursor {
+                // 同じ updated_at の行が並ぶ（一括登録など）ので id でも区切る
+                let ts = "\"\(cursor.updatedAt)\""
+                query = query.or("updated_at.gt.\(ts),and(updated_at.eq.\(ts),id.gt.\(cursor.id))")
+            }
+            let data = try await query
+                .order("updated_at", ascending: true)
+                .order("id", ascending: true)
+                .limit(Self.pageSize)
+                .execute()
+                .data
+            let page = try await Task.detached(priority: .userInitiated) { try apply(data, store) }.value
+            guard page.rows > 0 else { break }
+            if let next = page.next {
+                try store.setCursor(next, for: table)
+                cursor = next
+            }
+            total += page.rows
+            if page.rows < Self.pageSize { break }
+        }
+        return total
+    }
+
+    // MARK: - Initial download -----------------------------------------------
+    /// 対象の items を id のキーセットで並列に取り込む。ページ毎にストアへ入れてから onPage を呼ぶ
+    /// 途中でキャンセル・失敗した対象は次回も最初から取り直す（取り込んだ行は upsert なので重複しない）
+    func downloadTarget(_ target: TargetType,
+                        onPage: @escaping @MainActor (ItemJoinPayload) async throws -> Void,
+                        onProgress: @escaping @MainActor (MasterDownloadProgress) -> Void) async throws {
+        // 差分のカーソルを先に取っておく（ダウンロード中の変更は後の pull() で拾う）
+        try await seedItemCursorIfNeeded()
+        let total = try? await supabase
+            .from("items")
+            .select("id, inventory_masters!inner(target)", head: true, count: .exact)
+            .eq("inventory_masters.target", value: target.rawValue)
+            .execute()
+            .count
+
+        let store = self.store
+        let downloader = MasterDownloader(policy: downloadPolicy) { range, afterId, limit in
+            var query = supabase
+                .from("items")
+                .select("*, inventory_masters!inner(*)")
+                .eq("inventory_masters.target", value: target.rawValue)
+            if let afterId {
+                query = query.gt("id", value: afterId)
+            } else {
+                query = query.gte("id", value: range.lower)
+            }
+            if let upper = range.upper {
+                query = query.lt("id", value: upper)
+            }
+            return try await query.order("id", ascending: true).limit(limit).execute().data
+        }
+        Log.info(.sync, "[Sync] 初回ダウンロード開始: \(target.rawValue) 約 \(total.map(String.init) ?? "?") 件")
+        try await downloader.run(totalRows: total, onPage: { page in
+            try await Task.detached(priority: .userInitiated) { try store.upsert(page: page) }.value
+            try await onPage(page)
+        }, onProgress: onProgress)
+        try store.markDownloaded(target)
+        refreshCounts()
+    }
+
+    /// items のカーソルが無ければ、いまの最新行をカーソルにする（全件を差分で取り直さないため）
+    private func seedItemCursorIfNeeded() async throws {
+        guard try store.cursor(for: .items) == nil else { return }
+        struct Latest: Decodable {
+            let id: String
+            let updatedAt: String
+            enum CodingKeys: String, CodingKey { case id, updatedAt = "updated_at" }
+        }
+        let latest: [Latest] = try await supabase
+            .from("items")
+            .select("id, updated_at")
+            .order("updated_at", ascending: false)
+            .order("id", ascending: false)
+            .limit(1)
+            .execute()
+            .value
+        if let latest = latest.first {
+            try store.setCursor(SyncCursor(updatedAt: latest.updatedAt, id: latest.id), for: .items)
+        }
+    }
+
+    // MARK: - Upload ---------------------------------------------------------
+    /// 送信待ちを送る（送信中なら何もしない。終わったときに残りも拾う）
+    func requestUpload() {
+        refreshCounts()
+        guard uploadTask == nil else { return }
+        retryTask?.cancel()
+        retryTask = nil
+        uploadTask = Task { [weak self] in
+            await self?.drainOutbox()
+            self?.uploadTask = nil
+        }
+    }
+
+    /// 送信待ちが無くなるまで待つ
+    func waitForUploads() async {
+        if let uploadTask { await uploadTask.value }
+    }
+
+    private func drainOutbox() async {
+        while true {
+            let entries: [OutboxEntry]
+            do {
+                entries = try store.pendingOutbox()
+            } catch {
+                lastError = "同期エラー: \(error.localizedDescription)"
+                return
+            }
+            guard !entries.isEmpty else { break }
+            for entry in entries {
+                do {
+                    try await HotPathMetrics.shared.interval("sync.upload") { try await Self.upload(entry.operation) }
+                    try store.completeOutbox(entry.seq)
+                } catch let error as PostgrestError where error.code?.hasPrefix("23") == true {
+                    // 制約違反（RFID 重複など）は再送しても通らないので捨てる
+                    try? store.completeOutbox(entry.seq)
+                    lastError = "送信できない変更を破棄しました: \(error.localizedDescription)"
+                    Log.error(.sync, "[Sync] 送信待ちを破棄: \(entry.operation), \(error)")
+                } catch {
+                    // 順序を保つため、失敗したらここで止めて後で最初からやり直す
+                    try? store.failOutbox(entry.seq)
+                    HotPathMetrics.shared.increment(.persistFailures)
+                    lastError = "送信待ち \(pendingUploads) 件: \(error.localizedDescription)"
+                    scheduleRetry(attempts: entry.attempts + 1)
+                    Log.warning(.sync, "[Sync] 送信失敗 (\(entry.attempts + 1)回目): \(error)")
+                    refreshCounts()
+                    return
+                }
+            }
+            refreshCounts()
+        }
+        lastError = nil
+    }
+
+    private func scheduleRetry(attempts: Int) {
+        let delay = min(pow(2, Double(attempts)), Self.maxUploadDelay)
+        retryTask = Task { [weak self] in
+            try? await Task.sleep(nanoseconds: UInt64(delay * 1_000_000_000))
+            guard !Task.isCancelled else { return }
+            self?.requestUpload()
+        }
+    }
+
+    nonisolated private static func upload(_ operation: OutboxOperation) async throws {
+        HotPathMetrics.shared.increment(.persistRequests)
+        switch operation {
+        case .setInventoried(let ids, let value):
+            _ = try await supabase
+                .from("items")
+                .update(["is_inventoried": value])
+                .in("id", values: ids)
+                .execute()
+        case .insertItem(let id, let rfid, let masterId):
+            // 再送で重複しないよう id を指定して upsert
+            _ = try await supabase
+                .from("items")
+                .upsert(CreateItemParams(id: id, rfid: rfid, inventoryMasterId: masterId, isInventoried: false),
+                        ignoreDuplicates: true)
+                .execute()
+        case .openSession(let id, let target):
+            _ = try await supabase
+                .from("inventory_sessions")
+                .upsert(CreateInventorySessionParams(id: id, target: target), ignoreDuplicates: true)
+                .execute()
+        case .appendScans(let sessionId, let rfids):
+            // 1 回の RPC でまとめて追記（サーバー側で重複は捨てる）
+            _ = try await supabase
+                .rpc("append_inventory_scans", params: AppendInventoryScansParams(sessionId: sessionId, rfids: rfids))
+                .execute()
+        case .closeSession(let id, let discard):
+            _ = try await supabase
+                .rpc("close_inventory_session", params: CloseInventorySessionParams(sessionId: id, discard: discard))
+                .execute()
+        }
+    }
+
+    private func refreshCounts() {
+        pendingUploads = (try? store.outboxCount()) ?? 0
+        localItemCount = (try? store.count(.items)) ?? 0
+        localMasterCount = (try? store.count(.inventoryMasters)) ?? 0
+    }
+}
@@ -74,7 +74,8 @@ struct Item: Codable, Identifiable {
     let rfid: String
     let inventoryMasterId: String
     let userId: String?
-    let isInventoried: Bool
+    /// 書き戻し結果をその場で反映するため var
+    var isInventoried: Bool
 
     enum CodingKeys: String, CodingKey {
         case id
@@ -88,17 +89,46 @@ struct Item: Codable, Identifiable {
 }
 
 struct CreateItemParams: Encodable {
+    /// 端末で採番した id（nil ならサーバーが採番）
+    var id: String? = nil
     let rfid: String
     let inventoryMasterId: String
     let isInventoried: Bool?
 
     enum CodingKeys: String, CodingKey {
+        case id
         case rfid
         case inventoryMasterId = "inventory_master_id"
         case isInventoried = "is_inventoried"
     }
 }
 
+struct CreateInventorySessionParams: Encodable {
+    /// 端末で採番した id（再送しても同じセッション）
+    let id: String
+    let target: String
+}
+
+struct AppendInventoryScansParams: Encodable {
+    let sessionId: String
+    let rfids: [String]
+
+    enum CodingKeys: String, CodingKey {
+        case sessionId = "p_session_id"
+        case rfids = "p_rfids"
+    }
+}
+
+struct CloseInventorySessionParams: Encodable {
+    let sessionId: String
+    let discard: Bool
+
+    enum CodingKeys: String, CodingKey {
+        case sessionId = "p_session_id"
+        case discard = "p_discard"
+    }
+}
+
 struct CreateInventoryMasterParams: Encodable {
     let col1: String
     let col2: String?
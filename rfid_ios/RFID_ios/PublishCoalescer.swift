@@ -0,0 +1,59 @@
+//
+//  PublishCoalescer.swift
+//  RFID_ios
+//
+//  Created on 2025/05/08.
+//
+//  新規要素を溜めて、最大 N 回/秒 だけまとめて通知するバッファ
+//  SwiftUI への @Published 反映頻度を画面更新レートに抑えるために使う
+//  ※ メインスレッドからのみ呼ぶこと
+//
+
+import Foundation
+
+final class PublishCoalescer<Element> {
+
+    /// 1 秒あたりの最大通知回数
+    var maxEmitsPerSecond: Double {
+        didSet { maxEmitsPerSecond = max(maxEmitsPerSecond, 1) }
+    }
+
+    private var pending: [Element] = []
+    private var isFlushScheduled = false
+    private var lastEmit: TimeInterval = -.infinity
+    private let emit: ([Element]) -> Void
+
+    init(maxEmitsPerSecond: Double = 10, emit: @escaping ([Element]) -> Void) {
+        self.maxEmitsPerSecond = max(maxEmitsPerSecond, 1)
+        self.emit = emit
+    }
+
+    var pendingCount: Int { pending.count }
+
+    /// 要素を溜める。前回通知から間隔が空いていれば次の runloop で通知
+    func append<S: Sequence>(contentsOf elements: S) where S.Element == Element {
+        pending.append(contentsOf: elements)
+        guard !pending.isEmpty, !isFlushScheduled else { return }
+        isFlushScheduled = true
+        let interval = 1.0 / maxEmitsPerSecond
+        let delay = max(0, lastEmit + interval - ProcessInfo.processInfo.systemUptime)
+        DispatchQueue.main.asyncAfter(deadline: .now() + delay) { [weak self] in
+            self?.flush()
+        }
+    }
+
+    /// 溜まっている要素を即時通知
+    func flush() {
+        isFlushScheduled = false
+        guard !pending.isEmpty else { return }
+        let batch = pending
+        pending.removeAll(keepingCapacity: true)
+        lastEmit = ProcessInfo.processInfo.systemUptime
+        emit(batch)
+    }
+
+    /// 通知前の要素を捨てる
+    func discardPending() {
+        pending.removeAll(keepingCapacity: true)
+    }
+}
@@ -21,6 +21,11 @@ struct DensoScannerApp: App {
                 .environmentObject(deps.itemRegistrationManager)
                 .environmentObject(deps.inventoryMasterManager)
                 .environmentObject(deps.itemSearchManager)
+                .environmentObject(deps.scanTuningManager)
+                .environmentObject(deps.dutyCycleManager)
+                .environmentObject(deps.locateManager)
+                .environmentObject(deps.huntManager)
+                .environmentObject(deps.syncManager)
 
         }
     }
@@ -0,0 +1,171 @@
+//
+//  RSSILocator.swift
+//  RFID_ios
+//
+//  Created on 2025/05/20.
+//
+//  1 タグを探すための RSSI 追跡
+//    • 対象 UII の読取だけを受け取り、One Euro Filter で平滑化（動かしている間は遅れを小さく）
+//    • 平滑化した RSSI を 0〜1 の近さに直す。staleAfter 読めなければ見失い扱い
+//    • 読取毎に onSample を呼ぶ（SDK スレッド上。音の更新はここから直接行う）
+//  SDK 型には触らないので Linux のベンチ / テストでも使える
+//
+
+import Foundation
+
+// MARK: - Filter ---------------------------------------------------------------
+
+/// One Euro Filter（Casiez et al. 2012）。変化が速いほどカットオフを上げて遅れを抑える
+struct OneEuroFilter {
+    /// 静止時のカットオフ (Hz)。小さいほど滑らか
+    var minCutoff = 1.0
+    /// 変化速度 (dB/s) に対するカットオフの上げ幅
+    var beta = 0.08
+    /// 変化速度そのものの平滑化 (Hz)
+    var derivativeCutoff = 1.0
+
+    private(set) var value: Double?
+    private var derivative = 0.0
+    private var lastTime: TimeInterval?
+
+    mutating func filter(_ x: Double, at t: TimeInterval) -> Double {
+        guard let previous = value, let lastTime else {
+            value = x
+            lastTime = t
+            return x
+        }
+        // 1 コールバック内の読取は受信時刻が同じなので 1ms 間隔として扱う
+        let dt = max(t - lastTime, 0.001)
+        let dx = (x - previous) / dt
+        derivative += OneEuroFilter.alpha(cutoff: derivativeCutoff, dt: dt) * (dx - derivative)
+        let cutoff = minCutoff + beta * abs(derivative)
+        let filtered = previous + OneEuroFilter.alpha(cutoff: cutoff, dt: dt) * (x - previous)
+        value = filtered
+        self.lastTime = max(t, lastTime)
+        return filtered
+    }
+
+    mutating func reset() {
+        value = nil
+        derivative = 0
+        lastTime = nil
+    }
+
+    private static func alpha(cutoff: Double, dt: TimeInterval) -> Double {
+        let tau = 1 / (2 * Double.pi * cutoff)
+        return 1 / (1 + tau / dt)
+    }
+}
+
+// MARK: - Locator --------------------------------------------------------------
+
+/// RSSI (dBm) と近さの対応
+struct LocateCalibration: Equatable {
+    /// これ以下は近さ 0
+    var floorRSSI = -75.0
+    /// これ以上は近さ 1
+    var ceilingRSSI = -35.0
+
+    func proximity(rssi: Double) -> Double {
+        guard ceilingRSSI > floorRSSI else { return 0 }
+        return min(max((rssi - floorRSSI) / (ceilingRSSI - floorRSSI), 0), 1)
+    }
+}
+
+final class RSSILocator: @unchecked Sendable {
+
+    struct Reading: Equatable {
+        /// 平滑化後の RSSI
+        var rssi: Double?
+        var rawRSSI: Int?
+        /// 今回の探索で最も強かった平滑化 RSSI
+        var peakRSSI: Double?
+        /// 0〜1（見失い中は 0）
+        var proximity = 0.0
+        var readsPerSecond = 0.0
+        var sampleCount = 0
+        var isLost = true
+
+        static let empty = Reading()
+    }
+
+    let target: EPC
+    let calibration: LocateCalibration
+    /// この時間読めなければ見失い扱い
+    let staleAfter: TimeInterval
+    /// 対象タグの読取毎（呼び出し元のスレッド、ロック外）
+    var onSample: ((Reading) -> Void)?
+
+    private let targetData: Data
+    private let lock = NSLock()
+    private var filter: OneEuroFilter
+    private var reading = Reading()
+    private var lastSeen: TimeInterval?
+    /// 直近の読取時刻（読取レート用）
+    private var recent = RingBuffer<TimeInterval>(capacity: 32)
+    private(set) var ignoredReads = 0
+
+    init(target: EPC,
+         calibration: LocateCalibration = LocateCalibration(),
+         filter: OneEuroFilter = OneEuroFilter(),
+         staleAfter: TimeInterval = 0.6) {
+        self.target = target
+        self.targetData = target.data
+        self.calibration = calibration
+        self.filter = filter
+        self.staleAfter = staleAfter
+    }
+
+    /// 読取 1 件。対象タグなら true
+    @discardableResult
+    func ingest(uii: Data, rssi: Int, at t: TimeInterval) -> Bool {
+        lock.lock()
+        guard uii == targetData else {
+            ignoredReads += 1
+            lock.unlock()
+            return false
+        }
+        // 見失っていた間の値は引きずらない
+        if let lastSeen, t - lastSeen > staleAfter {
+            filter.reset()
+            recent.removeAll()
+        }
+        let smoothed = filter.filter(Double(rssi), at: t)
+        lastSeen = t
+        recent.pushOverwriting(t)
+        reading.rawRSSI = rssi
+        reading.rssi = smoothed
+        reading.peakRSSI = max(reading.peakRSSI ?? smoothed, smoothed)
+        reading.proximity = calibration.proximity(rssi: smoothed)
+        reading.readsPerSecond = rate(now: t)
+        reading.sampleCount += 1
+        reading.isLost = false
+        let snapshot = reading
+        lock.unlock()
+
+        onSample?(snapshot)
+        return true
+    }
+
+    /// 現時点の値（UI の更新と見失いの判定用）
+    func reading(at now: TimeInterval) -> Reading {
+        lock.lock()
+        defer { lock.unlock() }
+        var current = reading
+        if let lastSeen, now - lastSeen <= staleAfter {
+            current.readsPerSecond = rate(now: now)
+        } else {
+            current.isLost = true
+            current.proximity = 0
+            current.readsPerSecond = 0
+        }
+        return current
+    }
+
+    /// lock 内で呼ぶ
+    private func rate(now: TimeInterval) -> Double {
+        let times = recent.elements
+        guard times.count >= 2, let first = times.first, now > first else { return 0 }
+        return Double(times.count - 1) / (now - first)
+    }
+}
@@ -0,0 +1,88 @@
+//
+//  ReadSessionStats.swift
+//  RFID_ios
+//
+//  Created on 2025/05/14.
+//
+//  読取モード（逐次通知 / スキャナ内バッファ一括取得）と、
+//  読取開始〜停止 1 回分の性能・電池消費の記録
+//
+
+import Foundation
+
+/// 読取結果の受け取り方
+enum ReadMode: String, CaseIterable, Identifiable {
+    /// openInventory: タグ毎に BLE 通知
+    case streaming
+    /// openInventory:index: スキャナ内に溜めて getCount / pullData で一括取得
+    case buffered
+
+    var id: String { rawValue }
+
+    var label: String {
+        switch self {
+        case .streaming: return "逐次通知"
+        case .buffered:  return "一括取得"
+        }
+    }
+
+    private static let defaultsKey = "readMode"
+
+    static var saved: ReadMode {
+        UserDefaults.standard.string(forKey: defaultsKey).flatMap(ReadMode.init(rawValue:)) ?? .streaming
+    }
+
+    func save() {
+        UserDefaults.standard.set(rawValue, forKey: ReadMode.defaultsKey)
+    }
+}
+
+/// 読取の累計（取り込み側の読取数・コールバック数と読取済みタグ数）。開始時と停止時の差を記録する
+struct ReadSessionCounters: Equatable {
+    var reads = 0
+    var callbacks = 0
+    var unique = 0
+}
+
+/// 読取 1 回分（開始〜停止）の記録
+struct ReadSessionStats {
+    let mode: ReadMode
+    let startedAt: Date
+    var duration: TimeInterval = 0
+    var uniqueTags = 0
+    var reads = 0
+    /// RFIDDataReceived コールバック回数
+    var callbacks = 0
+    /// pullData 回数（一括取得のみ）
+    var pulls = 0
+    /// 端末の電池残量 (0〜1, 不明なら nil)
+    var hostBatteryStart: Float?
+    var hostBatteryEnd: Float?
+    /// スキャナの電池残量（SDK は 3 段階でしか返さない）
+    var scannerBatteryStart = "-"
+    var scannerBatteryEnd = "-"
+
+    init(mode: ReadMode, startedAt: Date = Date()) {
+        self.mode = mode
+        self.startedAt = startedAt
+    }
+
+    /// 開始時 start から停止時 end までの差を記録する
+    /// 途中で読取済みをクリアすると件数が開始時を下回るので、負にはしない
+    mutating func record(from start: ReadSessionCounters, to end: ReadSessionCounters) {
+        reads = max(end.reads - start.reads, 0)
+        callbacks = max(end.callbacks - start.callbacks, 0)
+        uniqueTags = max(end.unique - start.unique, 0)
+    }
+
+    var tagsPerSecond: Double { duration > 0 ? Double(uniqueTags) / duration : 0 }
+
+    var readsPerCallback: Double { callbacks > 0 ? Double(reads) / Double(callbacks) : 0 }
+
+    /// 端末電池の消費 (%/時)。1 分未満や残量不明のときは nil
+    var hostDrainPerHour: Double? {
+        guard let start = hostBatteryStart, let end = hostBatteryEnd,
+              start >= 0, end >= 0, duration >= 60 else { return nil }
+        return Double(start - end) * 100 / (duration / 3600)
+    }
+}
@@ -0,0 +1,65 @@
+//
+//  RingBuffer.swift
+//  RFID_ios
+//
+//  Created on 2025/05/08.
+//
+//  固定長リングバッファ（初期化時に全スロットを確保し、以降は再確保しない）
+//  スレッド安全性は持たないので、利用側でロックすること
+//
+
+import Foundation
+
+struct RingBuffer<Element> {
+
+    private var storage: [Element?]
+    /// 次に取り出す位置
+    private var head = 0
+    private(set) var count = 0
+
+    let capacity: Int
+
+    init(capacity: Int) {
+        precondition(capacity > 0, "RingBuffer capacity must be positive")
+        self.capacity = capacity
+        storage = Array(repeating: nil, count: capacity)
+    }
+
+    var isEmpty: Bool { count == 0 }
+    var isFull: Bool { count == capacity }
+
+    /// 末尾に追加。満杯なら false（上書きはしない）
+    @discardableResult
+    mutating func push(_ element: Element) -> Bool {
+        guard !isFull else { return false }
+        storage[(head + count) % capacity] = element
+        count += 1
+        return true
+    }
+
+    /// 先頭を取り出す
+    mutating func pop() -> Element? {
+        guard !isEmpty else { return nil }
+        let element = storage[head]
+        storage[head] = nil
+        head = (head + 1) % capacity
+        count -= 1
+        return element
+    }
+
+    /// 満杯なら先頭を捨てて末尾に追加する
+    mutating func pushOverwriting(_ element: Element) {
+        if isFull { _ = pop() }
+        push(element)
+    }
+
+    /// 先頭から順に並べたコピー
+    var elements: [Element] {
+        (0..<count).compactMap { storage[(head + $0) % capacity] }
+    }
+
+    mutating func removeAll() {
+        while pop() != nil {}
+        head = 0
+    }
+}
@@ -0,0 +1,183 @@
+//
+//  SQLiteDatabase.swift
+//  RFID_ios
+//
+//  Created on 2025/05/24.
+//
+//  端末内ストア用の最小限の SQLite ラッパ（libsqlite3 を直接使う）
+//    • プリペアドステートメントは SQL 文字列毎にキャッシュして使い回す
+//    • 1 接続をロックで直列化する。呼び出しは同期なので、重いものはメインスレッド外から呼ぶこと
+//
+
+import Foundation
+import SQLite3
+
+enum SQLiteError: LocalizedError, Equatable {
+    case open(String)
+    case prepare(String)
+    case step(String)
+
+    var errorDescription: String? {
+        switch self {
+        case .open(let message):    return "ローカル DB を開けません: \(message)"
+        case .prepare(let message): return "SQL が不正です: \(message)"
+        case .step(let message):    return "ローカル DB の更新に失敗しました: \(message)"
+        }
+    }
+}
+
+/// bind 用の値
+enum SQLiteValue {
+    case text(String)
+    case int(Int64)
+    case blob(Data)
+    case null
+
+    static func optional(_ text: String?) -> SQLiteValue { text.map(SQLiteValue.text) ?? .null }
+    static func bool(_ value: Bool) -> SQLiteValue { .int(value ? 1 : 0) }
+}
+
+final class SQLiteDatabase: @unchecked Sendable {
+
+    /// SQLite に文字列をコピーさせる（Swift 側のバッファはすぐ解放される）
+    private static let transient = unsafeBitCast(-1, to: sqlite3_destructor_type.self)
+
+    private var handle: OpaquePointer?
+    private var statements: [String: OpaquePointer] = [:]
+    private let lock = NSRecursiveLock()
+    /// transaction() の入れ子の深さ（内側は外側のトランザクションに含める）
+    private var transactionDepth = 0
+
+    /// path に ":memory:" を渡すとメモリ上の DB（テスト用）
+    init(path: String) throws {
+        let flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX
+        guard sqlite3_open_v2(path, &handle, flags, nil) == SQLITE_OK else {
+            let message = handle.map { String(cString: sqlite3_errmsg($0)) } ?? "unknown"
+            sqlite3_close(handle)
+            throw SQLiteError.open(message)
+        }
+        try execute("PRAGMA journal_mode = WAL")
+        try execute("PRAGMA synchronous = NORMAL")
+    }
+
+    deinit {
+        for statement in statements.values { sqlite3_finalize(statement) }
+        sqlite3_close(handle)
+    }
+
+    // MARK: - Execute --------------------------------------------------------
+    /// 結果を読まない SQL（複数文可、bind なし）
+    func execute(_ sql: String) throws {
+        lock.lock(); defer { lock.unlock() }
+        var error: UnsafeMutablePointer<CChar>?
+        guard sqlite3_exec(handle, sql, nil, nil, &error) == SQLITE_OK else {
+            let message = error.map { String(cString: $0) } ?? lastMessage
+            sqlite3_free(error)
+            throw SQLiteError.step(message)
+        }
+    }
+
+    /// bind 付きの更新文
+    func run(_ sql: String, _ values: [SQLiteValue] = []) throws {
+        try withStatement(sql, values) { statement in
+            let rc = sqlite3_step(statement)
+            guard rc == SQLITE_DONE || rc == SQLITE_ROW else { throw SQLiteError.step(lastMessage) }
+        }
+    }
+
+    /// 行毎に row を呼んで結果を集める
+    func query<T>(_ sql: String, _ values: [SQLiteValue] = [], row: (Row) throws -> T) throws -> [T] {
+        try withStatement(sql, values) { statement in
+            var result: [T] = []
+            while true {
+                let rc = sqlite3_step(statement)
+                if rc == SQLITE_DONE { break }
+                guard rc == SQLITE_ROW else { throw SQLiteError.step(lastMessage) }
+                result.append(try row(Row(statement: statement)))
+            }
+            return result
+        }
+    }
+
+    /// body を 1 トランザクションで実行する（失敗したら巻き戻す）。入れ子なら外側にまとめる
+    func transaction<T>(_ body: () throws -> T) throws -> T {
+        lock.lock(); defer { lock.unlock() }
+        guard transactionDepth == 0 else {
+            transactionDepth += 1
+            defer { transactionDepth -= 1 }
+            return try body()
+        }
+        try execute("BEGIN IMMEDIATE")
+        transactionDepth = 1
+        defer { transactionDepth = 0 }
+        do {
+            let value = try body()
+            try execute("COMMIT")
+            return value
+        } catch {
+            try? execute("ROLLBACK")
+            throw error
+        }
+    }
+
+    var changes: Int {
+        lock.lock(); defer { lock.unlock() }
+        return Int(sqlite3_changes(handle))
+    }
+
+    // MARK: - Statement ------------------------------------------------------
+    private var lastMessage: String { String(cString: sqlite3_errmsg(handle)) }
+
+    private func withStatement<T>(_ sql: String, _ values: [SQLiteValue], _ body: (OpaquePointer) throws -> T) throws -> T {
+        lock.lock(); defer { lock.unlock() }
+        let statement: OpaquePointer
+        if let cached = statements[sql] {
+            statement = cached
+        } else {
+            var prepared: OpaquePointer?
+            guard sqlite3_prepare_v2(handle, sql, -1, &prepared, nil) == SQLITE_OK, let prepared else {
+                throw SQLiteError.prepare(lastMessage)
+            }
+            statements[sql] = prepared
+            statement = prepared
+        }
+        defer {
+            sqlite3_reset(statement)
+            sqlite3_clear_bindings(statement)
+        }
+        for (i, value) in values.enumerated() {
+            let index = Int32(i + 1)
+            switch value {
+            case .text(let text):  sqlite3_bind_text(statement, index, text, -1, Self.transient)
+            case .int(let int):    sqlite3_bind_int64(statement, index, int)
+            case .blob(let data):
+                _ = data.withUnsafeBytes { sqlite3_bind_blob(statement, index, $0.baseAddress, Int32(data.count), Self.transient) }
+            case .null:            sqlite3_bind_null(statement, index)
+            }
+        }
+        return try body(statement)
+    }
+
+    /// 結果の 1 行（列は 0 始まり）
+    struct Row {
+        fileprivate let statement: OpaquePointer
+
+        func text(_ column: Int32) -> String {
+            sqlite3_column_text(statement, column).map { String(cString: $0) } ?? ""
+        }
+
+        func optionalText(_ column: Int32) -> String? {
+            sqlite3_column_type(statement, column) == SQLITE_NULL ? nil : text(column)
+        }
+
+        func int(_ column: Int32) -> Int64 { sqlite3_column_int64(statement, column) }
+
+        func bool(_ column: Int32) -> Bool { int(column) != 0 }
+
+        func blob(_ column: Int32) -> Data {
+            let count = Int(sqlite3_column_bytes(statement, column))
+            guard count > 0, let bytes = sqlite3_column_blob(statement, column) else { return Data() }
+            return Data(bytes: bytes, count: count)
+        }
+    }
+}
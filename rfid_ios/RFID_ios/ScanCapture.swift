@@ -0,0 +1,216 @@
+//
+//  ScanCapture.swift
+//  RFID_ios
+//
+//  Created on 2025/05/10.
+//
+//  SDK から届いた RFID イベント列の記録フォーマット（.rfcap）
+//
+//  すべてリトルエンディアン
+//    ヘッダ (16 byte) : "RFCP" | version:u16 | flags:u16 | startedAt:f64 (UNIX 秒)
+//    バッチ           : offsetNanos:u64 (記録開始からの経過) | readCount:u16
+//    読取             : uiiLength:u8 | uii | pc:u16 | rssi:i16
+//
+
+import Foundation
+
+/// 記録済みの 1 読取
+struct CapturedRead: RawTagRead, Equatable {
+    let uii: Data
+    let pc: Int
+    let rssi: Int
+
+    var uiiData: Data? { uii }
+    var signal: SignalSample? {
+        SignalSample(rssi: rssi, antenna: 0, channel: 0, phase: 0, polarization: 0)
+    }
+}
+
+/// 記録済みの 1 イベント（RFIDDataReceivedEvent 1 回分）
+struct CapturedBatch: Equatable {
+    /// 記録開始からの経過時間
+    let offsetNanos: UInt64
+    let reads: [CapturedRead]
+}
+
+enum ScanCaptureError: LocalizedError, Equatable {
+    case badMagic
+    case unsupportedVersion(UInt16)
+    case truncated
+
+    var errorDescription: String? {
+        switch self {
+        case .badMagic:                  return "記録ファイルの形式が不正です"
+        case .unsupportedVersion(let v): return "未対応の記録バージョンです: \(v)"
+        case .truncated:                 return "記録ファイルが途中で切れています"
+        }
+    }
+}
+
+// MARK: - Capture (reader) ---------------------------------------------------
+
+struct ScanCapture: Equatable {
+
+    static let magic: [UInt8] = Array("RFCP".utf8)
+    static let version: UInt16 = 1
+
+    let startedAt: Date
+    let batches: [CapturedBatch]
+
+    var readCount: Int { batches.reduce(0) { $0 + $1.reads.count } }
+
+    init(startedAt: Date, batches: [CapturedBatch]) {
+        self.startedAt = startedAt
+        self.batches = batches
+    }
+
+    init(contentsOf url: URL) throws {
+        try self.init(data: Data(contentsOf: url))
+    }
+
+    init(data: Data) throws {
+        var reader = ByteReader(storage: [UInt8](data))
+        guard try reader.take(4) == ScanCapture.magic else { throw ScanCaptureError.badMagic }
+        let version = try reader.u16()
+        guard version == ScanCapture.version else { throw ScanCaptureError.unsupportedVersion(version) }
+        _ = try reader.u16() // flags（予約）
+        let startedBits = try reader.u64()
+        startedAt = Date(timeIntervalSince1970: Double(bitPattern: startedBits))
+
+        var batches: [CapturedBatch] = []
+        while !reader.isAtEnd {
+            let offset = try reader.u64()
+            let count = try reader.u16()
+            var reads: [CapturedRead] = []
+            reads.reserveCapacity(Int(count))
+            for _ in 0..<count {
+                let length = try reader.u8()
+                let uii = try reader.take(Int(length))
+                let pc = try reader.u16()
+                let rssi = try reader.u16()
+                reads.append(CapturedRead(uii: Data(uii), pc: Int(pc), rssi: Int(Int16(bitPattern: rssi))))
+            }
+            batches.append(CapturedBatch(offsetNanos: offset, reads: reads))
+        }
+        self.batches = batches
+    }
+
+    /// フォーマットに書き出したバイト列
+    func encoded() -> Data {
+        var out = ScanCaptureEncoder.header(startedAt: startedAt)
+        for batch in batches {
+            ScanCaptureEncoder.append(batch, to: &out)
+        }
+        return out
+    }
+}
+
+// MARK: - Writer (recorder) --------------------------------------------------
+
+/// SDK スレッドから逐次追記するレコーダ。一定量溜まったらファイルへ書き出す
+/// 符号化とファイル書き込みは専用のシリアルキューで行い、SDK のコールバックは時刻を取って渡すだけにする
+final class ScanCaptureWriter: @unchecked Sendable {
+
+    let url: URL
+    let startedAt: Date
+    private let handle: FileHandle
+    private let startUptime: UInt64
+    private let flushThreshold: Int
+    private let queue = DispatchQueue(label: "ScanCaptureWriter.io", qos: .utility)
+    // 以下は queue 上でのみ触る
+    private var buffer = Data()
+    private var writtenBatches = 0
+
+    init(url: URL, flushThreshold: Int = 64 * 1024) throws {
+        FileManager.default.createFile(atPath: url.path, contents: nil)
+        self.handle = try FileHandle(forWritingTo: url)
+        self.url = url
+        self.startedAt = Date()
+        self.startUptime = DispatchTime.now().uptimeNanoseconds
+        self.flushThreshold = flushThreshold
+        buffer.reserveCapacity(flushThreshold)
+        buffer.append(ScanCaptureEncoder.header(startedAt: startedAt))
+    }
+
+    /// 書き込み済み（キューに積んだ分を含む）のイベント数
+    var batchCount: Int { queue.sync { writtenBatches } }
+
+    func append(_ reads: [CapturedRead]) {
+        let offset = DispatchTime.now().uptimeNanoseconds - startUptime
+        queue.async {
+            ScanCaptureEncoder.append(CapturedBatch(offsetNanos: offset, reads: reads), to: &self.buffer)
+            self.writtenBatches += 1
+            if self.buffer.count >= self.flushThreshold { self.flushOnQueue() }
+        }
+    }
+
+    /// 積んだ分をすべて書き出してファイルを閉じる（書き終わるまで待つ）
+    func close() {
+        queue.sync {
+            flushOnQueue()
+            handle.closeFile()
+        }
+    }
+
+    private func flushOnQueue() {
+        guard !buffer.isEmpty else { return }
+        handle.write(buffer)
+        buffer.removeAll(keepingCapacity: true)
+    }
+}
+
+// MARK: - Encoding helpers ---------------------------------------------------
+
+private enum ScanCaptureEncoder {
+
+    static func header(startedAt: Date) -> Data {
+        var out = Data(ScanCapture.magic)
+        put(ScanCapture.version, into: &out)
+        put(UInt16(0), into: &out)
+        put(startedAt.timeIntervalSince1970.bitPattern, into: &out)
+        return out
+    }
+
+    static func append(_ batch: CapturedBatch, to out: inout Data) {
+        // 1 イベントは数百件程度なので u16 を超える分は切り捨てる
+        let reads = batch.reads.prefix(Int(UInt16.max))
+        put(batch.offsetNanos, into: &out)
+        put(UInt16(reads.count), into: &out)
+        for read in reads {
+            let uii = read.uii.prefix(Int(UInt8.max))
+            out.append(UInt8(uii.count))
+            out.append(uii)
+            put(UInt16(truncatingIfNeeded: read.pc), into: &out)
+            put(UInt16(bitPattern: Int16(clamping: read.rssi)), into: &out)
+        }
+    }
+
+    private static func put<T: FixedWidthInteger>(_ value: T, into out: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { out.append(contentsOf: $0) }
+    }
+}
+
+private struct ByteReader {
+    let storage: [UInt8]
+    var position = 0
+
+    var isAtEnd: Bool { position >= storage.count }
+
+    mutating func take(_ n: Int) throws -> [UInt8] {
+        guard position + n <= storage.count else { throw ScanCaptureError.truncated }
+        defer { position += n }
+        return Array(storage[position..<position + n])
+    }
+
+    mutating func u8() throws -> UInt8 { try take(1)[0] }
+
+    mutating func u16() throws -> UInt16 {
+        let b = try take(2)
+        return UInt16(b[0]) | UInt16(b[1]) << 8
+    }
+
+    mutating func u64() throws -> UInt64 {
+        let b = try take(8)
+        return b.enumerated().reduce(0) { $0 | UInt64($1.element) << (8 * UInt64($1.offset)) }
+    }
+}
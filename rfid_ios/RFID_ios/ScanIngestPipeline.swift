@@ -0,0 +1,235 @@
+//
+//  ScanIngestPipeline.swift
+//  RFID_ios
+//
+//  Created on 2025/05/08.
+//
+//  SDK コールバック → 重複排除 → 差分通知 の取り込みステージ
+//    • SDK スレッドは生のバッチをリングバッファへ積むだけ
+//    • デコード(EPC化)と重複排除は専用のシリアルキューで実行
+//    • 溢れた場合は OverflowPolicy に従って破棄し、カウンタに記録
+//    • SDK 型には依存しない（RawTagRead に準拠した型なら何でも流せる）
+//
+
+import Foundation
+
+/// 取り込みステージに流す 1 読取分の生データ
+protocol RawTagRead {
+    var uiiData: Data? { get }
+    /// 電波情報（取得していない場合は nil）
+    var signal: SignalSample? { get }
+}
+
+extension RawTagRead {
+    var signal: SignalSample? { nil }
+}
+
+final class ScanIngestPipeline<Read: RawTagRead>: @unchecked Sendable {
+
+    // MARK: - Types --------------------------------------------------------
+    /// リングバッファ満杯時の動作
+    enum OverflowPolicy {
+        /// 新しく届いたバッチを捨てる
+        case dropNewest
+        /// 最も古い未処理バッチを捨てて新しいバッチを積む
+        case dropOldest
+    }
+
+    struct Counters: Equatable {
+        var batchesPushed = 0
+        var batchesDropped = 0
+        var batchesConsumed = 0
+        var readsDecoded = 0
+        /// EPC として保持できなかった UII（16 byte 超 / 空）
+        var readsRejected = 0
+        /// リングバッファの最大滞留数
+        var highWatermark = 0
+    }
+
+    /// 1 回の drain で新たに見つかったタグ
+    struct Delta {
+        /// reset() 毎に進む世代番号。古い世代の差分は捨てること
+        let generation: Int
+        let added: [EPC]
+        let uniqueCount: Int
+        /// この差分に含まれる最も古いバッチの受信時刻（遅延計測用）
+        let oldestReceivedAt: Date
+        /// 重複排除を終えて通知した時刻
+        let dedupedAt: Date
+    }
+
+    private struct Batch {
+        let reads: [Read]
+        let receivedAt: Date
+        let generation: Int
+        let capturesSignal: Bool
+    }
+
+    // MARK: - Properties ---------------------------------------------------
+    /// 差分通知（取り込みキュー上で呼ばれる）
+    var onDelta: ((Delta) -> Void)?
+
+    let policy: OverflowPolicy
+    /// 区間計測の記録先（nil なら計測しない）
+    let metrics: HotPathMetrics?
+
+    /// 電波情報を統計に取り込むか（スキャナ側で setResponse 済みのときだけ true にする）
+    var capturesSignal: Bool {
+        get { lock.lock(); defer { lock.unlock() }; return signalEnabled }
+        set { lock.lock(); signalEnabled = newValue; lock.unlock() }
+    }
+
+    private let queue: DispatchQueue
+    private let lock = NSLock()
+
+    // lock で保護
+    private var ring: RingBuffer<Batch>
+    private var counters = Counters()
+    private var isDrainScheduled = false
+    private var generation = 0
+    private var signalEnabled = false
+
+    // queue 上でのみ触る
+    private var store: TagStore
+    private var storeGeneration = 0
+
+    // MARK: - Init ---------------------------------------------------------
+    init(capacity: Int = 256,
+         policy: OverflowPolicy = .dropOldest,
+         expectedTagCount: Int = 4096,
+         metrics: HotPathMetrics? = nil,
+         queue: DispatchQueue = DispatchQueue(label: "rfid.scan.ingest", qos: .userInitiated)) {
+        self.ring = RingBuffer(capacity: capacity)
+        self.policy = policy
+        self.metrics = metrics
+        self.store = TagStore(minimumCapacity: expectedTagCount)
+        self.queue = queue
+    }
+
+    // MARK: - Producer -----------------------------------------------------
+    /// SDK コールバックから呼ぶ。デコードはせずに積むだけ
+    func push(_ reads: [Read], receivedAt: Date = Date()) {
+        metrics?.increment(.sdkCallbacks)
+        lock.lock()
+        counters.batchesPushed += 1
+        if ring.isFull {
+            counters.batchesDropped += 1
+            switch policy {
+            case .dropNewest:
+                lock.unlock()
+                return
+            case .dropOldest:
+                _ = ring.pop()
+            }
+        }
+        ring.push(Batch(reads: reads, receivedAt: receivedAt,
+                        generation: generation, capturesSignal: signalEnabled))
+        counters.highWatermark = max(counters.highWatermark, ring.count)
+        let needsDrain = !isDrainScheduled
+        isDrainScheduled = true
+        lock.unlock()
+
+        if needsDrain {
+            queue.async { [self] in
+                if let metrics { metrics.interval("ingest.drain") { drain() } } else { drain() }
+            }
+        }
+    }
+
+    // MARK: - Consumer -----------------------------------------------------
+    private func drain() {
+        var added: [EPC] = []
+        var addedGeneration = -1
+        var oldestReceivedAt = Date.distantFuture
+
+        while let batch = popBatch() {
+            // 世代が変わったら、それまでの差分を先に流す
+            if batch.generation != addedGeneration {
+                publish(added, generation: addedGeneration, oldestReceivedAt: oldestReceivedAt)
+                added.removeAll(keepingCapacity: true)
+                addedGeneration = batch.generation
+                oldestReceivedAt = .distantFuture
+                advanceStore(to: batch.generation)
+            }
+            oldestReceivedAt = min(oldestReceivedAt, batch.receivedAt)
+            var decoded = 0
+            var rejected = 0
+            for read in batch.reads {
+                guard let data = read.uiiData, let epc = EPC(data: data) else {
+                    rejected += 1
+                    continue
+                }
+                decoded += 1
+                let signal = batch.capturesSignal ? read.signal : nil
+                if store.insert(epc, at: batch.receivedAt, signal: signal) { added.append(epc) }
+            }
+            lock.lock()
+            counters.batchesConsumed += 1
+            counters.readsDecoded += decoded
+            counters.readsRejected += rejected
+            lock.unlock()
+            if let metrics {
+                metrics.record(.callbackToDedup, since: batch.receivedAt)
+                metrics.increment(.readsDeduped, by: decoded)
+            }
+        }
+        publish(added, generation: addedGeneration, oldestReceivedAt: oldestReceivedAt)
+    }
+
+    private func popBatch() -> Batch? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let batch = ring.pop() else {
+            isDrainScheduled = false
+            return nil
+        }
+        return batch
+    }
+
+    /// 新しい世代に入ったら重複排除状態を捨てる
+    private func advanceStore(to newGeneration: Int) {
+        guard newGeneration > storeGeneration else { return }
+        store.removeAll()
+        storeGeneration = newGeneration
+    }
+
+    private func publish(_ added: [EPC], generation: Int, oldestReceivedAt: Date) {
+        guard !added.isEmpty else { return }
+        onDelta?(Delta(generation: generation, added: added, uniqueCount: store.count,
+                       oldestReceivedAt: oldestReceivedAt, dedupedAt: Date()))
+    }
+
+    // MARK: - Control ------------------------------------------------------
+    /// 未処理バッチと重複排除状態を破棄し、新しい世代番号を返す
+    @discardableResult
+    func reset() -> Int {
+        lock.lock()
+        ring.removeAll()
+        generation += 1
+        let newGeneration = generation
+        lock.unlock()
+        queue.async { [self] in advanceStore(to: newGeneration) }
+        return newGeneration
+    }
+
+    var currentCounters: Counters {
+        lock.lock()
+        defer { lock.unlock() }
+        return counters
+    }
+
+    /// タグ毎の読取記録（取り込みキューと同期して取得）
+    func record(for uii: EPC) -> TagRecord? {
+        queue.sync { store.record(for: uii) }
+    }
+
+    /// 指定タグの読取回数の合計（取り込みキューと同期して 1 回で集計）
+    func readCount<S: Sequence>(of uiis: S) -> Int where S.Element == EPC {
+        queue.sync { uiis.reduce(0) { $0 + (store.record(for: $1)?.readCount ?? 0) } }
+    }
+
+    /// 取り込みキューに積まれた処理が全て終わるまで待つ（テスト用）
+    func waitUntilIdle() {
+        queue.sync {}
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  ScanReplayer.swift
+//  RFID_ios
+//
+//  Created on 2025/05/10.
+//
+//  ScanCapture を記録時のタイミング（等倍 / N 倍 / 最速）で再生する
+//  再生したバッチは SDK コールバックと同じ取り込み経路へ流す想定
+//
+
+import Foundation
+
+enum ReplaySpeed: Equatable {
+    /// 記録時と同じ間隔
+    case realtime
+    /// 記録時の N 倍速
+    case multiplied(Double)
+    /// 待ち時間なし
+    case maximum
+
+    var factor: Double? {
+        switch self {
+        case .realtime:          return 1
+        case .multiplied(let x): return max(x, .ulpOfOne)
+        case .maximum:           return nil
+        }
+    }
+}
+
+final class ScanReplayer: @unchecked Sendable {
+
+    let capture: ScanCapture
+    let speed: ReplaySpeed
+
+    private let queue: DispatchQueue
+    private let lock = NSLock()
+    private var cancelled = false
+
+    init(capture: ScanCapture,
+         speed: ReplaySpeed = .realtime,
+         queue: DispatchQueue = DispatchQueue(label: "rfid.scan.replay", qos: .userInitiated)) {
+        self.capture = capture
+        self.speed = speed
+        self.queue = queue
+    }
+
+    /// 再生キュー上で再生を開始する
+    func start(deliver: @escaping ([CapturedRead]) -> Void,
+               completion: (() -> Void)? = nil) {
+        queue.async { [self] in
+            run(deliver: deliver)
+            completion?()
+        }
+    }
+
+    /// 呼び出しスレッドでそのまま再生する（ベンチマーク用）
+    func run(deliver: ([CapturedRead]) -> Void) {
+        let start = DispatchTime.now().uptimeNanoseconds
+        for batch in capture.batches {
+            if isCancelled { return }
+            if let factor = speed.factor {
+                let due = start + UInt64(Double(batch.offsetNanos) / factor)
+                let now = DispatchTime.now().uptimeNanoseconds
+                if due > now { Thread.sleep(forTimeInterval: Double(due - now) / 1e9) }
+            }
+            deliver(batch.reads)
+        }
+    }
+
+    func cancel() {
+        lock.lock()
+        cancelled = true
+        lock.unlock()
+    }
+
+    private var isCancelled: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return cancelled
+    }
+}
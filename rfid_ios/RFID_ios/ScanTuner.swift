@@ -0,0 +1,183 @@
+//
+//  ScanTuner.swift
+//  RFID_ios
+//
+//  Created on 2025/05/13.
+//
+//  新規ユニークタグ数/秒 を見ながら Q値・セッション・リンクプロファイルを調整する
+//    • 一定時間のウィンドウ毎に、現行設定か近傍の候補設定を 1 つ試す
+//    • 候補が現行より improvement 以上良ければ採用し、その近傍を探し直す
+//    • 現行設定の発見レートがピークの plateauFraction を下回り続けたら終了
+//  発見レートは棚の読み残しが減るほど下がるので、後から試す候補ほど不利になる
+//  （＝採用は保守的に働く）。SDK には依存しない
+//
+
+import Foundation
+
+// MARK: - Profile ------------------------------------------------------------
+
+/// 自動調整の対象になる読取設定
+struct ScanProfile: Codable, Hashable {
+    enum Session: Int, Codable, CaseIterable {
+        case s0, s1, s2, s3
+    }
+
+    var qParam: Int
+    var session: Session
+    var linkProfile: Int
+
+    /// SDK の許容範囲（Q値 0〜7、リンクプロファイル 1/4/5）
+    static let qRange = 0...7
+    static let linkProfiles = [1, 4, 5]
+    /// S3 は S2 と同じ動作なので探索しない
+    static let tunableSessions: [Session] = [.s0, .s1, .s2]
+
+    static let `default` = ScanProfile(qParam: 4, session: .s0, linkProfile: 1)
+
+    /// 範囲外の値を安全側へ丸めたもの
+    var clamped: ScanProfile {
+        ScanProfile(qParam: min(max(qParam, ScanProfile.qRange.lowerBound), ScanProfile.qRange.upperBound),
+                    session: session,
+                    linkProfile: ScanProfile.linkProfiles.contains(linkProfile) ? linkProfile : 1)
+    }
+}
+
+// MARK: - Tuner --------------------------------------------------------------
+
+final class ScanTuner {
+
+    struct Configuration {
+        /// 1 設定を測る時間
+        var window: TimeInterval = 3
+        /// 候補を採用するのに必要な改善率
+        var improvement = 0.1
+        /// ピーク比でこれを下回ったら頭打ちとみなす
+        var plateauFraction = 0.05
+        /// 頭打ちが何ウィンドウ続いたら終了するか
+        var plateauWindows = 2
+        /// 試す候補の上限
+        var maxTrials = 12
+        /// 何も読めない場合も含めた総ウィンドウ数の上限
+        var maxWindows = 30
+    }
+
+    enum Step: Equatable {
+        /// 次のウィンドウはこの設定で測る
+        case measure(ScanProfile)
+        /// 調整終了（採用した設定）
+        case finished(ScanProfile)
+    }
+
+    let configuration: Configuration
+    private(set) var best: ScanProfile
+    /// 現行設定の直近の発見レート（件/秒）
+    private(set) var bestRate = 0.0
+    private(set) var peakRate = 0.0
+    private(set) var trials = 0
+    private(set) var windows = 0
+
+    private var trying: ScanProfile?
+    private var candidates: [ScanProfile] = []
+    private var tried: Set<ScanProfile> = []
+    private var plateauCount = 0
+
+    init(start: ScanProfile, configuration: Configuration = Configuration()) {
+        self.best = start.clamped
+        self.configuration = configuration
+        tried.insert(best)
+        candidates = neighbors(of: best)
+    }
+
+    /// 今のウィンドウで使っている設定
+    var current: ScanProfile { trying ?? best }
+
+    /// 1 ウィンドウ分の新規ユニーク数を渡し、次の動作を受け取る
+    func windowCompleted(newUniqueTags: Int, duration: TimeInterval) -> Step {
+        windows += 1
+        let rate = duration > 0 ? Double(newUniqueTags) / duration : 0
+        peakRate = max(peakRate, rate)
+
+        if let candidate = trying {
+            trying = nil
+            if rate > bestRate * (1 + configuration.improvement), rate > 0 {
+                best = candidate
+                bestRate = rate
+                plateauCount = 0
+                candidates = neighbors(of: candidate)
+            }
+        } else {
+            bestRate = rate
+            if peakRate > 0, rate < peakRate * configuration.plateauFraction {
+                plateauCount += 1
+            } else {
+                plateauCount = 0
+            }
+        }
+
+        if plateauCount >= configuration.plateauWindows || windows >= configuration.maxWindows {
+            return .finished(best)
+        }
+        // 候補の次は必ず現行設定で測り直し、比較の基準を最新にする
+        if windows % 2 == 1, trials < configuration.maxTrials, let next = nextCandidate() {
+            trials += 1
+            trying = next
+            return .measure(next)
+        }
+        return .measure(best)
+    }
+
+    private func nextCandidate() -> ScanProfile? {
+        while !candidates.isEmpty {
+            let candidate = candidates.removeFirst()
+            if tried.insert(candidate).inserted { return candidate }
+        }
+        return nil
+    }
+
+    /// 近傍: Q±1 → セッション → リンクプロファイル の順
+    private func neighbors(of profile: ScanProfile) -> [ScanProfile] {
+        var list: [ScanProfile] = []
+        for dq in [1, -1] where ScanProfile.qRange.contains(profile.qParam + dq) {
+            var p = profile
+            p.qParam += dq
+            list.append(p)
+        }
+        for session in ScanProfile.tunableSessions where session != profile.session {
+            var p = profile
+            p.session = session
+            list.append(p)
+        }
+        for link in ScanProfile.linkProfiles where link != profile.linkProfile {
+            var p = profile
+            p.linkProfile = link
+            list.append(p)
+        }
+        return list
+    }
+}
+
+// MARK: - Persistence --------------------------------------------------------
+
+/// 対象（TargetType など）毎に採用した設定を保存する
+struct ScanProfileStore {
+    private let defaults: UserDefaults
+    private static let keyPrefix = "scanProfile."
+
+    init(defaults: UserDefaults = .standard) {
+        self.defaults = defaults
+    }
+
+    func profile(for target: String) -> ScanProfile? {
+        guard let data = defaults.data(forKey: ScanProfileStore.keyPrefix + target) else { return nil }
+        return try? JSONDecoder().decode(ScanProfile.self, from: data)
+    }
+
+    func save(_ profile: ScanProfile, for target: String) {
+        guard let data = try? JSONEncoder().encode(profile) else { return }
+        defaults.set(data, forKey: ScanProfileStore.keyPrefix + target)
+    }
+
+    func remove(for target: String) {
+        defaults.removeObject(forKey: ScanProfileStore.keyPrefix + target)
+    }
+}
@@ -0,0 +1,155 @@
+//
+//  ScanTuningManager.swift
+//  RFID_ios
+//
+//  Created on 2025/05/13.
+//
+//  ScanTuner をスキャナに接続し、決まった設定を TargetType 毎に保存する
+//  対象を切り替えると保存済みの設定をスキャナへ反映する
+//
+
+import Foundation
+import Combine
+
+@MainActor
+final class ScanTuningManager: ObservableObject {
+
+    // MARK: - Published -----------------------------------------------------
+    @Published private(set) var isTuning = false
+    @Published private(set) var currentProfile: ScanProfile?
+    /// 直近ウィンドウの新規ユニークタグ数/秒
+    @Published private(set) var discoveryRate = 0.0
+    @Published private(set) var statusMessage = "未実行"
+
+    // MARK: - Dependencies --------------------------------------------------
+    private let scanner: ScannerManager
+    private let compare: CompareMasterManager
+    private let store: ScanProfileStore
+    private var cancellables = Set<AnyCancellable>()
+
+    // MARK: - Tuning State --------------------------------------------------
+    private var tuner: ScanTuner?
+    private var windowTask: Task<Void, Never>?
+    private var newUniqueInWindow = 0
+    private var windowStartedAt = Date()
+    /// 調整のために読取を始めた（終わったら止める）
+    private var startedScan = false
+
+    init(scannerManager: ScannerManager,
+         compareManager: CompareMasterManager,
+         store: ScanProfileStore = ScanProfileStore()) {
+        self.scanner = scannerManager
+        self.compare = compareManager
+        self.store = store
+
+        scannerManager.scannedDelta
+            .sink { [weak self] added in self?.newUniqueInWindow += added.count }
+            .store(in: &cancellables)
+
+        // 対象の切り替え / 接続時に保存済みの設定を反映
+        compareManager.$selectedTarget
+            .combineLatest(scannerManager.$isConnected)
+            .sink { [weak self] target, connected in
+                guard connected else { return }
+                Task { await self?.applySavedProfile(for: target) }
+            }
+            .store(in: &cancellables)
+    }
+
+    /// 調整結果を保存する対象（棚卸し画面で選択中のもの）
+    var target: TargetType { compare.selectedTarget }
+
+    func savedProfile(for target: TargetType) -> ScanProfile? {
+        store.profile(for: target.rawValue)
+    }
+
+    // MARK: - Public Controls -----------------------------------------------
+    func startTuning() async {
+        guard !isTuning else { return }
+        guard scanner.isConnected, let start = await scanner.currentScanProfile() else {
+            statusMessage = "スキャナが接続されていません"
+            return
+        }
+        let tuner = ScanTuner(start: start)
+        self.tuner = tuner
+        isTuning = true
+        currentProfile = tuner.current
+        statusMessage = "調整中…"
+        // 読取結果は消さない（進行中の棚卸しと照合結果を壊さないため）
+        // scannedDelta は読取済みのタグを流さないので、開始時点の読取済みを基準に新規ユニークだけを数える
+        Log.info(.scanner, "[Tuner] 開始: \(compare.selectedTarget.rawValue) 初期設定=\(start) 基準=\(scanner.scannedCount)件")
+
+        startedScan = scanner.readState == .standby
+        if startedScan { scanner.startScan() }
+        beginWindow(tuner.configuration.window)
+    }
+
+    func stopTuning() async {
+        guard isTuning else { return }
+        await finish(with: tuner?.best, saving: false)
+        statusMessage = "中断しました"
+    }
+
+    // MARK: - Window Loop ---------------------------------------------------
+    private func beginWindow(_ duration: TimeInterval) {
+        newUniqueInWindow = 0
+        windowStartedAt = Date()
+        windowTask = Task { [weak self] in
+            try? await Task.sleep(nanoseconds: UInt64(duration * 1_000_000_000))
+            guard !Task.isCancelled else { return }
+            await self?.windowElapsed()
+        }
+    }
+
+    private func windowElapsed() async {
+        guard let tuner, isTuning else { return }
+        // 自分自身（windowTask）を finish でキャンセルしないよう切り離す
+        windowTask = nil
+        let elapsed = Date().timeIntervalSince(windowStartedAt)
+        discoveryRate = Double(newUniqueInWindow) / max(elapsed, 0.001)
+        Log.info(.scanner, String(format: "[Tuner] %@ → %.1f tags/s", "\(tuner.current)", discoveryRate))
+
+        switch tuner.windowCompleted(newUniqueTags: newUniqueInWindow, duration: elapsed) {
+        case .measure(let profile):
+            var applied = profile == currentProfile
+            if !applied { applied = await scanner.applyScanProfile(profile) }
+            if applied {
+                currentProfile = profile
+            } else {
+                // 反映できなくてもウィンドウは進める（この間の結果は元の設定で読んだもの）
+                Log.warning(.scanner, "[Tuner] 設定反映失敗: \(profile)")
+            }
+            beginWindow(tuner.configuration.window)
+        case .finished(let best):
+            await finish(with: best, saving: true)
+            statusMessage = String(format: "完了 (ピーク %.1f tags/s)", tuner.peakRate)
+        }
+    }
+
+    private func finish(with best: ScanProfile?, saving: Bool) async {
+        windowTask?.cancel()
+        windowTask = nil
+        isTuning = false
+        tuner = nil
+        // 調整のために始めた読取は止める（読み続けると電池を使い、棚卸しにも流れ込む）
+        if startedScan {
+            startedScan = false
+            await scanner.setReading(false)
+        }
+        guard let best else { return }
+        if best != currentProfile { await scanner.applyScanProfile(best) }
+        currentProfile = best
+        if saving {
+            store.save(best, for: compare.selectedTarget.rawValue)
+            Log.info(.scanner, "[Tuner] 保存: \(compare.selectedTarget.rawValue) → \(best)")
+        }
+    }
+
+    private func applySavedProfile(for target: TargetType) async {
+        guard !isTuning, let profile = store.profile(for: target.rawValue) else { return }
+        if await scanner.applyScanProfile(profile) {
+            currentProfile = profile
+            Log.info(.scanner, "[Tuner] 保存済み設定を反映: \(target.rawValue) → \(profile)")
+        }
+    }
+}
@@ -0,0 +1,216 @@
+//
+//  ScannerCommandQueue.swift
+//  RFID_ios
+//
+//  Created on 2025/05/15.
+//
+//  スキャナへの同期 SDK 呼び出し（BLE 往復）を専用シリアルキューで実行する
+//    • 呼び出し側は async/await で結果を受け取り、MainActor を塞がない
+//    • コマンド毎のタイムアウト（待ち時間込み）とキャンセル
+//    • coalescing 指定のコマンドは、未実行の古い同種コマンドを superseded で捨てる
+//    • 種類毎に待ち時間 / 実行時間を記録
+//  SDK 呼び出し自体は中断できないため、タイムアウトしても実行は最後まで続く
+//  （後続コマンドはその完了を待つ）。SDK には依存しない
+//
+
+import Foundation
+
+enum ScannerCommandError: LocalizedError, Equatable {
+    /// 待ち時間込みで timeout を超えた
+    case timedOut(String)
+    /// 後から積まれた同種コマンドに置き換えられた
+    case superseded
+    /// スキャナ（RFIDScanner）が取得できない
+    case notReady
+
+    var errorDescription: String? {
+        switch self {
+        case .timedOut(let kind): return "スキャナ応答タイムアウト: \(kind)"
+        case .superseded:         return "新しい操作に置き換えられました"
+        case .notReady:           return "スキャナが準備できていません"
+        }
+    }
+}
+
+/// SDK の NSError 出力引数を throws に変換する
+@discardableResult
+func sdkCall<T>(_ body: (inout NSError?) -> T) throws -> T {
+    var err: NSError?
+    let value = body(&err)
+    if let err { throw err }
+    return value
+}
+
+final class ScannerCommandQueue: @unchecked Sendable {
+
+    /// コマンド種類毎の計測値
+    struct Latency: Equatable {
+        var completed = 0
+        var failed = 0
+        var timedOut = 0
+        var superseded = 0
+        var cancelled = 0
+        /// キューで待った時間の平均 (ms)
+        var meanWaitMillis = 0.0
+        var maxExecMillis = 0.0
+        /// 直近 sampleLimit 件の実行時間 (ms)
+        fileprivate(set) var recentExecMillis: [Double] = []
+
+        static let sampleLimit = 64
+
+        var p50ExecMillis: Double { percentile(0.5) }
+        var p95ExecMillis: Double { percentile(0.95) }
+
+        private func percentile(_ p: Double) -> Double {
+            guard !recentExecMillis.isEmpty else { return 0 }
+            let sorted = recentExecMillis.sorted()
+            return sorted[min(sorted.count - 1, Int(Double(sorted.count) * p))]
+        }
+    }
+
+    let defaultTimeout: TimeInterval
+
+    private let queue: DispatchQueue
+    private let lock = NSLock()
+    // lock で保護
+    private var nextTicket: UInt64 = 0
+    private var latestTicket: [String: UInt64] = [:]
+    private var latencies: [String: Latency] = [:]
+
+    init(label: String = "rfid.scanner.command", defaultTimeout: TimeInterval = 5) {
+        self.queue = DispatchQueue(label: label, qos: .userInitiated)
+        self.defaultTimeout = defaultTimeout
+    }
+
+    // MARK: - Run ----------------------------------------------------------
+    /// body をコマンドキューで実行して結果を返す
+    /// - Parameters:
+    ///   - kind: 計測と coalescing に使う種類名
+    ///   - coalescing: true なら、実行前に同じ kind が積まれた時点で superseded になる
+    func run<T>(_ kind: String,
+                timeout: TimeInterval? = nil,
+                coalescing: Bool = false,
+                _ body: @escaping () throws -> T) async throws -> T {
+        let ticket = register(kind)
+        let enqueuedAt = DispatchTime.now().uptimeNanoseconds
+        let once = ResumeOnce<T>()
+
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                once.set(continuation)
+                queue.async { [self] in
+                    if coalescing, isSuperseded(kind, ticket) {
+                        if once.resume(.failure(ScannerCommandError.superseded)) { record(kind) { $0.superseded += 1 } }
+                        return
+                    }
+                    // タイムアウト / キャンセル済みなら実行しない
+                    guard !once.isFinished else { return }
+                    let startedAt = DispatchTime.now().uptimeNanoseconds
+                    let result = Result { try body() }
+                    let finishedAt = DispatchTime.now().uptimeNanoseconds
+                    record(kind) { latency in
+                        let wait = Double(startedAt - enqueuedAt) / 1e6
+                        let exec = Double(finishedAt - startedAt) / 1e6
+                        let n = Double(latency.completed + latency.failed)
+                        latency.meanWaitMillis += (wait - latency.meanWaitMillis) / (n + 1)
+                        latency.maxExecMillis = max(latency.maxExecMillis, exec)
+                        latency.recentExecMillis.append(exec)
+                        if latency.recentExecMillis.count > Latency.sampleLimit {
+                            latency.recentExecMillis.removeFirst()
+                        }
+                        if case .failure = result { latency.failed += 1 } else { latency.completed += 1 }
+                    }
+                    once.resume(result)
+                }
+                let limit = timeout ?? defaultTimeout
+                DispatchQueue.global().asyncAfter(deadline: .now() + limit) { [self] in
+                    if once.resume(.failure(ScannerCommandError.timedOut(kind))) {
+                        record(kind) { $0.timedOut += 1 }
+                    }
+                }
+            }
+        } onCancel: {
+            if once.resume(.failure(CancellationError())) {
+                record(kind) { $0.cancelled += 1 }
+            }
+        }
+    }
+
+    /// 積まれているコマンドが全て終わるまで待つ（テスト用）
+    func waitUntilIdle() {
+        queue.sync {}
+    }
+
+    // MARK: - Metrics ------------------------------------------------------
+    func latencySnapshot() -> [String: Latency] {
+        lock.lock()
+        defer { lock.unlock() }
+        return latencies
+    }
+
+    private func record(_ kind: String, _ update: (inout Latency) -> Void) {
+        lock.lock()
+        update(&latencies[kind, default: Latency()])
+        lock.unlock()
+    }
+
+    // MARK: - Coalescing ---------------------------------------------------
+    private func register(_ kind: String) -> UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+        nextTicket += 1
+        latestTicket[kind] = nextTicket
+        return nextTicket
+    }
+
+    private func isSuperseded(_ kind: String, _ ticket: UInt64) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return latestTicket[kind] != ticket
+    }
+}
+
+// MARK: - One-shot continuation ----------------------------------------------
+
+/// 実行完了 / タイムアウト / キャンセルのうち最初の 1 回だけ continuation を再開する
+private final class ResumeOnce<T>: @unchecked Sendable {
+    private let lock = NSLock()
+    private var continuation: CheckedContinuation<T, Error>?
+    private var pending: Result<T, Error>?
+    private var finished = false
+
+    var isFinished: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return finished
+    }
+
+    func set(_ continuation: CheckedContinuation<T, Error>) {
+        lock.lock()
+        // continuation を受け取る前にキャンセルされていた場合
+        if let pending {
+            lock.unlock()
+            continuation.resume(with: pending)
+            return
+        }
+        self.continuation = continuation
+        lock.unlock()
+    }
+
+    /// 最初の呼び出しなら true
+    @discardableResult
+    func resume(_ result: Result<T, Error>) -> Bool {
+        lock.lock()
+        guard !finished else { lock.unlock(); return false }
+        finished = true
+        guard let continuation else {
+            pending = result
+            lock.unlock()
+            return true
+        }
+        self.continuation = nil
+        lock.unlock()
+        continuation.resume(with: result)
+        return true
+    }
+}
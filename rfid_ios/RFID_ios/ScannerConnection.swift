@@ -0,0 +1,272 @@
+//
+//  ScannerConnection.swift
+//  RFID_ios
+//
+//  Created on 2025/05/16.
+//
+//  スキャナ接続の状態遷移（検出 → CLAIM → RFID 使用可 → 切断 → 再接続）
+//    • CommManager / CommScanner のイベントをそのまま入力にする
+//    • CLAIM 失敗・RFIDScanner 未取得・切断はそれぞれバックオフ付きで再試行
+//    • 検出から CLAIM 完了 / 使用可能までの時間と切断時間を記録
+//  SDK 型には ScannerLink 越しにしか触らないので、偽スキャナでテストできる
+//
+
+import Foundation
+
+/// 状態遷移が使う CommScanner の操作（テストでは偽物に差し替える）
+protocol ScannerLink: AnyObject {
+    var modelName: String { get }
+    /// CLAIM（コマンドキュー上で呼ばれる）
+    func claimLink() throws
+    /// RFIDScanner が取得できる状態か
+    var isRFIDAvailable: Bool { get }
+}
+
+enum ScannerConnectionState: Equatable {
+    /// スキャナの検出待ち
+    case idle
+    case claiming(attempt: Int)
+    /// CLAIM 済み、RFIDScanner の取得待ち
+    case waitingReady
+    case ready
+    /// 切断後の再検出待ち（バックオフ中）
+    case reconnecting(attempt: Int)
+    /// 再試行を使い切った。手動の再接続待ち
+    case failed(String)
+
+    var label: String {
+        switch self {
+        case .idle:                     return "検出待ち"
+        case .claiming(let attempt):    return attempt > 1 ? "CLAIM 中 (\(attempt)回目)" : "CLAIM 中"
+        case .waitingReady:             return "RFID 準備中"
+        case .ready:                    return "使用可能"
+        case .reconnecting(let attempt): return "再接続中 (\(attempt)回目)"
+        case .failed(let reason):       return "接続失敗: \(reason)"
+        }
+    }
+}
+
+/// 接続の計測値（時間は秒）
+struct ConnectionMetrics: Equatable {
+    /// 検出 → CLAIM 完了
+    var timeToClaim: TimeInterval?
+    /// 検出 → RFIDScanner 取得
+    var timeToReady: TimeInterval?
+    /// 切断 → 再び使用可能
+    var lastOutage: TimeInterval?
+    /// 直近の接続で RFIDScanner の有無を確認した回数
+    var readyChecks = 0
+    var connects = 0
+    var reconnects = 0
+    var claimFailures = 0
+}
+
+/// 再試行の間隔と回数
+struct ConnectionPolicy {
+    var claimAttempts = 3
+    var claimTimeout: TimeInterval = 5
+    /// CLAIM 後の RFIDScanner 確認間隔（initial から倍々で maxReadyCheckDelay まで）
+    var initialReadyCheckDelay: TimeInterval = 0.02
+    var maxReadyCheckDelay: TimeInterval = 0.4
+    var readyTimeout: TimeInterval = 3
+    /// 切断後の再検出間隔（倍々で maxReconnectDelay まで）
+    var initialReconnectDelay: TimeInterval = 0.25
+    var maxReconnectDelay: TimeInterval = 8
+    var reconnectAttempts = 10
+
+    func reconnectDelay(attempt: Int) -> TimeInterval {
+        min(initialReconnectDelay * pow(2, Double(max(attempt - 1, 0))), maxReconnectDelay)
+    }
+}
+
+@MainActor
+final class ScannerConnection {
+
+    // MARK: - Callbacks ------------------------------------------------------
+    /// CommManager.startAccept
+    var startDiscovery: (() -> Void)?
+    /// CLAIM 完了（ステータスリスナー登録など）
+    var onClaimed: ((ScannerLink) -> Void)?
+    /// 使用可能になった。restored は切断からの復帰
+    var onReady: ((ScannerLink, _ restored: Bool) -> Void)?
+    /// 接続中だったスキャナを手放す
+    var onLost: ((ScannerLink) -> Void)?
+    var onStateChanged: ((ScannerConnectionState) -> Void)?
+    var onMetricsChanged: ((ConnectionMetrics) -> Void)?
+
+    // MARK: - State ----------------------------------------------------------
+    private(set) var state: ScannerConnectionState = .idle {
+        didSet { if state != oldValue { onStateChanged?(state) } }
+    }
+    private(set) var metrics = ConnectionMetrics() {
+        didSet { if metrics != oldValue { onMetricsChanged?(metrics) } }
+    }
+    private(set) var link: ScannerLink?
+
+    let policy: ConnectionPolicy
+    private let commands: ScannerCommandQueue
+    private let now: () -> TimeInterval
+
+    /// 切断・手動再接続で進める。古い待機処理はこれで自分が無効だと分かる
+    private var epoch = 0
+    private var appearedAt: TimeInterval = 0
+    private var lostAt: TimeInterval?
+    private var hasBeenReady = false
+    private var reconnectAttempt = 0
+    private var retryTask: Task<Void, Never>?
+
+    nonisolated init(policy: ConnectionPolicy = ConnectionPolicy(),
+                     commands: ScannerCommandQueue,
+                     now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) {
+        self.policy = policy
+        self.commands = commands
+        self.now = now
+    }
+
+    // MARK: - Events ---------------------------------------------------------
+    func start() {
+        state = .idle
+        startDiscovery?()
+    }
+
+    /// OnScannerAppeared
+    func scannerAppeared(_ link: ScannerLink) async {
+        switch state {
+        case .claiming, .waitingReady, .ready:
+            // 1 台ずつ扱う。同じスキャナの重複通知もここで捨てる
+            Log.warning(.connection, "[Conn] 接続処理中のため検出を無視: \(link.modelName)")
+            return
+        case .idle, .reconnecting, .failed:
+            break
+        }
+        retryTask?.cancel()
+        retryTask = nil
+        epoch += 1
+        let myEpoch = epoch
+        self.link = link
+        appearedAt = now()
+
+        for attempt in 1...max(policy.claimAttempts, 1) {
+            state = .claiming(attempt: attempt)
+            do {
+                try await commands.run("claim", timeout: policy.claimTimeout) { try link.claimLink() }
+                guard epoch == myEpoch else { return }
+                metrics.timeToClaim = now() - appearedAt
+                Log.info(.connection, String(format: "[Conn] CLAIM 成功 (%.0fms)", (metrics.timeToClaim ?? 0) * 1000))
+                state = .waitingReady
+                onClaimed?(link)
+                await waitReady(link, epoch: myEpoch)
+                return
+            } catch {
+                guard epoch == myEpoch else { return }
+                metrics.claimFailures += 1
+                Log.warning(.connection, "[Conn] CLAIM 失敗 (\(attempt)回目): \(error.localizedDescription)")
+                guard attempt < policy.claimAttempts else { break }
+                try? await Task.sleep(nanoseconds: nanoseconds(policy.reconnectDelay(attempt: attempt)))
+                guard epoch == myEpoch else { return }
+            }
+        }
+        // CLAIM できなかったスキャナは手放して検出からやり直す
+        self.link = nil
+        lostAt = lostAt ?? now()
+        scheduleReconnect()
+    }
+
+    /// SCANNER_STATUS_CLAIMED。RFIDScanner が取れるようになった合図なので待たずに確認する
+    func statusClaimed(_ link: ScannerLink) {
+        guard state == .waitingReady, link === self.link else { return }
+        checkReady(link)
+    }
+
+    /// OnScannerDisappeared / CLOSE 系ステータス
+    func scannerLost(_ link: ScannerLink) {
+        guard link === self.link else { return }
+        Log.warning(.connection, "[Conn] 切断: \(link.modelName)")
+        release()
+        scheduleReconnect()
+    }
+
+    /// 手動の再接続。バックオフをリセットしてすぐに検出し直す
+    func reconnect() {
+        release()
+        reconnectAttempt = 0
+        state = .idle
+        startDiscovery?()
+    }
+
+    // MARK: - Ready ----------------------------------------------------------
+    private func waitReady(_ link: ScannerLink, epoch myEpoch: Int) async {
+        metrics.readyChecks = 0
+        var delay = policy.initialReadyCheckDelay
+        let deadline = appearedAt + policy.readyTimeout
+        while epoch == myEpoch, state == .waitingReady {
+            if checkReady(link) { return }
+            guard now() < deadline else {
+                Log.error(.connection, "[Conn] RFIDScanner 取得タイムアウト")
+                release()
+                scheduleReconnect()
+                return
+            }
+            try? await Task.sleep(nanoseconds: nanoseconds(delay))
+            delay = min(delay * 2, policy.maxReadyCheckDelay)
+        }
+    }
+
+    @discardableResult
+    private func checkReady(_ link: ScannerLink) -> Bool {
+        metrics.readyChecks += 1
+        guard link.isRFIDAvailable else { return false }
+
+        let readyAt = now()
+        let restored = hasBeenReady
+        metrics.timeToReady = readyAt - appearedAt
+        metrics.connects += 1
+        if restored {
+            metrics.reconnects += 1
+            metrics.lastOutage = lostAt.map { readyAt - $0 }
+        }
+        hasBeenReady = true
+        lostAt = nil
+        reconnectAttempt = 0
+        state = .ready
+        Log.info(.connection, String(format: "[Conn] 使用可能 (%.0fms, 確認 %ld 回)%@",
+                     (metrics.timeToReady ?? 0) * 1000, metrics.readyChecks, restored ? " — 復帰" : ""))
+        onReady?(link, restored)
+        return true
+    }
+
+    // MARK: - Retry ----------------------------------------------------------
+    private func release() {
+        epoch += 1
+        retryTask?.cancel()
+        retryTask = nil
+        guard let old = link else { return }
+        link = nil
+        if hasBeenReady, lostAt == nil { lostAt = now() }
+        onLost?(old)
+    }
+
+    private func scheduleReconnect() {
+        reconnectAttempt += 1
+        guard reconnectAttempt <= policy.reconnectAttempts else {
+            state = .failed("再試行回数の上限")
+            Log.error(.connection, "[Conn] 再接続を断念（\(policy.reconnectAttempts)回）")
+            return
+        }
+        let attempt = reconnectAttempt
+        let myEpoch = epoch
+        state = .reconnecting(attempt: attempt)
+        retryTask = Task { [weak self] in
+            try? await Task.sleep(nanoseconds: nanoseconds((self?.policy.reconnectDelay(attempt: attempt)) ?? 0))
+            guard let self, !Task.isCancelled, self.epoch == myEpoch else { return }
+            Log.info(.connection, "[Conn] 再検出 (\(attempt)回目)")
+            self.startDiscovery?()
+            // 検出されなければ間隔を延ばして続ける
+            self.scheduleReconnect()
+        }
+    }
+}
+
+private func nanoseconds(_ seconds: TimeInterval) -> UInt64 {
+    UInt64(max(seconds, 0) * 1_000_000_000)
+}
@@ -25,8 +25,32 @@ final class ScannerManager: NSObject,
     // MARK: - Published -----------------------------------------------------
     @Published private(set) var isConnected   = false
     @Published private(set) var statusMessage = "スキャナを待機中…"
-    @Published private(set) var scannedUII: [String] = []
+    /// 読取済みタグ（挿入のみ）。@Published にしない（一覧は scannedCount の変化で描き直し、
+    /// 0..<scannedCount の添字で参照するので、全件の差分を取らずに末尾の追加分だけ描く）
+    private(set) var scannedUII: [EPC] = []
+    /// 読取済みタグ数（scannedUII と同じタイミングで更新）
+    @Published private(set) var scannedCount = 0
     @Published private(set) var readState: ReadState = .standby
+    @Published private(set) var isRecording = false
+    @Published private(set) var isReplaying = false
+    @Published private(set) var isSimulating = false
+    /// 読取モード（次回の読取開始から有効）
+    @Published var readMode: ReadMode = .saved {
+        didSet { readMode.save() }
+    }
+    /// モード毎の直近の読取記録（比較表示用）
+    @Published private(set) var sessionStats: [ReadMode: ReadSessionStats] = [:]
+    @Published private(set) var connectionState: ScannerConnectionState = .idle
+    @Published private(set) var connectionMetrics = ConnectionMetrics()
+
+    /// 新規タグの差分（挿入のみ）。scannedUII と同じく最大 maxPublishRate 回/秒
+    let scannedDelta = PassthroughSubject<[EPC], Never>()
+
+    /// UI への読取結果反映の上限（回/秒）
+    var maxPublishRate: Double {
+        get { publishCoalescer.maxEmitsPerSecond }
+        set { publishCoalescer.maxEmitsPerSecond = newValue }
+    }
 
     // MARK: - Callbacks ------------------------------------------------------
     var onConnected:        ((RFIDScanner, CommScanner) -> Void)?
@@ -38,16 +62,79 @@ final class ScannerManager: NSObject,
     private(set) var commScanner:  CommScanner?
 
     // MARK: - Internal State -------------------------------------------------
-    private var isOperatingScanner = false
+    /// SDK 呼び出しはすべてこのキューで直列に実行する（SettingManager からも使う）
+    let commands = ScannerCommandQueue()
+    /// 検出 / CLAIM / 切断の状態遷移
+    private lazy var connection = ScannerConnection(commands: commands)
+    /// 使用可能になる度に順に実行する処理（restored は切断からの復帰）
+    private var readySteps: [@MainActor (_ restored: Bool) async -> Void] = []
+    /// 切断時に読取中だったら復帰後に読取を再開する
+    private var resumeReadingOnRestore = false
+    /// 最後に反映した読取設定（復帰時に送り直す）
+    private var lastScanProfile: ScanProfile?
+    /// 積んだ読取コマンドが全て成功した後の状態（連打の判定用、MainActor 上でのみ更新）
+    private var intendedReadState: ReadState = .standby
+    /// SDK コールバック → 重複排除の取り込みステージ（メインスレッド外）
+    private let ingest = ScanIngestPipeline<ScanRead>(capacity: 256, policy: .dropOldest, metrics: .shared)
+    /// 現在受け付けている取り込み世代（MainActor 上でのみ更新）
+    private var ingestGeneration = 0
+    /// 新規タグをまとめて UI へ流す（MainActor 上でのみ使用）
+    private lazy var publishCoalescer = PublishCoalescer<EPC>(maxEmitsPerSecond: 10) { [weak self] added in
+        guard let self else { return }
+        if let since = self.pendingDedupedAt {
+            HotPathMetrics.shared.record(.dedupToPublish, since: since)
+            self.pendingDedupedAt = nil
+        }
+        HotPathMetrics.shared.increment(.tagsPublished, by: added.count)
+        self.lastPublishedAt = Date()
+        self.scannedUII.append(contentsOf: added)
+        self.scannedCount = self.scannedUII.count
+        self.scannedDelta.send(added)
+    }
+    /// 反映待ちの差分のうち最も古い重複排除完了時刻（区間計測用、MainActor 上でのみ使用）
+    private var pendingDedupedAt: Date?
+    /// 直近に scannedUII へ新規タグを反映した時刻（照合側の区間計測用）
+    private(set) var lastPublishedAt: Date?
     private var bgObserverToken: NSObjectProtocol?
+    /// 受信イベントの記録（SDK スレッドからも参照するので recorderLock で保護）
+    private let recorderLock = NSLock()
+    private var recorder: ScanCaptureWriter?
+    private var replayer: ScanReplayer?
+    private var simulator: SimulatedScanner?
+    /// 読取開始前に反映する Select フィルタ（空なら解除）。メインスレッドで触る
+    private var selectMasks: [SelectMask] = []
+    private var selectFilterDirty = false
+    /// 重複排除前の読取を 1 件ずつ受け取る（探索用。SDK スレッドから呼ぶので rssiTapLock で保護）
+    private let rssiTapLock = NSLock()
+    private var rssiTap: RSSITap?
+    /// 一括取得モードで使うスキャナ内バッファ番号と取得間隔
+    static let bufferIndex: Int32 = 0
+    var bufferedPullInterval: TimeInterval = 1.0
+    private var pullTask: Task<Void, Never>?
+    private var activeSession: ReadSessionStats?
+    private var sessionBaseline = ReadSessionCounters()
 
     // MARK: - Initialization -------------------------------------------------
+    override init() {
+        super.init()
+        ingest.onDelta = { [weak self] delta in
+            Task { @MainActor in
+                guard let self, delta.generation == self.ingestGeneration else { return }
+                if self.pendingDedupedAt == nil { self.pendingDedupedAt = delta.dedupedAt }
+                self.publishCoalescer.append(contentsOf: delta.added)
+            }
+        }
+    }
+
     func initializeScanner() {
-        print("🇯🇵 [Init] スキャナ初期化開始")
+        Log.info(.scanner, "[Init] スキャナ初期化開始")
         if CommManager.sharedInstance() == nil { CommManager.initialize() }
         let mgr = CommManager.sharedInstance()!
         mgr.addAcceptStatusListener(listener: self)
-        mgr.startAccept()
+        Task { @MainActor in
+            self.bindConnection()
+            self.connection.start()
+        }
 
         // バックグラウンド移行時に読み取り停止
         bgObserverToken = NotificationCenter.default.addObserver(
@@ -56,8 +143,8 @@ final class ScannerManager: NSObject,
             queue: .main
         ) { [weak self] _ in
             guard let self else { return }
-            print("🇯🇵 [BG] アプリバックグラウンド → 読み取り停止")
-            Task { @MainActor in self.runRead(action: .stop) }
+            Log.info(.scanner, "[BG] アプリバックグラウンド → 読み取り停止")
+            Task { @MainActor in await self.runRead(action: .stop) }
         }
 
         Task { @MainActor in self.statusMessage = "スキャナ待機中…" }
@@ -65,161 +152,621 @@ final class ScannerManager: NSObject,
 
     deinit {
         if let t = bgObserverToken { NotificationCenter.default.removeObserver(t) }
-        print("🇯🇵 [Deinit] ScannerManager 解放")
+        Log.debug(.scanner, "[Deinit] ScannerManager 解放")
     }
 
     // MARK: - Public Controls ----------------------------------------------
-    func startScan() { Task { @MainActor in self.runRead(action: .start) } }
-    func stopScan()  { Task { @MainActor in self.runRead(action: .stop ) } }
+    func startScan() { Task { @MainActor in await self.runRead(action: .start) } }
+    func stopScan()  { Task { @MainActor in await self.runRead(action: .stop ) } }
 
-    func reconnect() {
-        print("🇯🇵 [Reconnect] 再接続要求")
-        releaseScanner()
-        CommManager.sharedInstance()?.startAccept()
-        Task { @MainActor in self.statusMessage = "再接続を試行中…" }
+    /// 読取の開始 / 停止を完了まで待つ（間欠読取などアプリ側から制御する用）
+    @MainActor
+    func setReading(_ reading: Bool) async {
+        await runRead(action: reading ? .start : .stop)
     }
 
-    func clearScannedData() {
+    func reconnect() {
+        Log.info(.scanner, "[Reconnect] 再接続要求")
         Task { @MainActor in
-            self.scannedUII.removeAll()
-            self.statusMessage = "スキャンデータをクリアしました"
+            self.connection.reconnect()
+            self.statusMessage = "再接続を試行中…"
         }
     }
 
-    // MARK: - SDK Callbacks --------------------------------------------------
-    func OnScannerAppeared(scanner: CommScanner!) {
-        print("🇯🇵 [Detect] スキャナ検出 → \(scanner.getModel() ?? "unknown")")
-        var err: NSError?
-        scanner.claim(&err)
-        if let e = err {
-            print("🛑 [Detect] CLAIM 失敗: \(e.localizedDescription)")
-            updateUI(message: "接続失敗: \(e.localizedDescription)")
-            return
-        }
-        print("✅ [Detect] CLAIM 成功")
-        commScanner = scanner
-        commScanner?.addStatusListener(self)
-        rfidScanner = commScanner?.getRFIDScanner()
-        rfidScanner?.setDataDelegate(delegate: self)
+    /// 使用可能になる度に（初回接続・復帰とも）実行する処理を登録する
+    @MainActor
+    func addReadyStep(_ step: @escaping @MainActor (_ restored: Bool) async -> Void) {
+        readySteps.append(step)
+    }
 
-        if let r = rfidScanner, let c = commScanner {
-            print("🔔 [Callback] onConnected 発火")
-            onConnected?(r, c)
-        }
+    func clearScannedData() {
+        Task { @MainActor in self.resetScannedData() }
+    }
 
-        updateUI(connected: true, message: "接続完了: \(scanner.getModel() ?? "Unknown")")
+    /// clearScannedData の同期版。続けて読取を流し込む場合は先にこれで世代を進めておく
+    @MainActor
+    func resetScannedData() {
+        ingestGeneration = ingest.reset()
+        publishCoalescer.discardPending()
+        pendingDedupedAt = nil
+        lastPublishedAt = nil
+        scannedUII.removeAll()
+        scannedCount = 0
+        statusMessage = "スキャンデータをクリアしました"
+    }
+
+    // MARK: - SDK Callbacks --------------------------------------------------
+    // 接続まわりのイベントは ScannerConnection に渡すだけ
+    func OnScannerAppeared(scanner: CommScanner!) {
+        Log.info(.scanner, "[Detect] スキャナ検出 → \(scanner.getModel() ?? "unknown")")
+        Task { @MainActor in await self.connection.scannerAppeared(scanner) }
     }
 
     func OnScannerDisappeared(scanner: CommScanner!) {
-        print("🇯🇵 [Disconnect] スキャナ切断検出")
-        releaseScanner()
-        updateUI(connected: false, message: "スキャナが切断されました")
+        Log.info(.scanner, "[Disconnect] スキャナ切断検出")
+        Task { @MainActor in self.connection.scannerLost(scanner) }
     }
 
     func OnScannerStatusChanged(scanner: CommScanner!, state: CommStatusChangedEvent!) {
         let st = state.getStatus()
-        print("🇯🇵 [Status] 状態変化 → raw=\(st.rawValue)")
+        Log.debug(.scanner, "[Status] 状態変化 → raw=\(st.rawValue)")
         switch st {
         case .SCANNER_STATUS_CLAIMED:
-            waitRFIDReady(scanner)
+            Task { @MainActor in self.connection.statusClaimed(scanner) }
         case .SCANNER_STATUS_CLOSE_WAIT, .SCANNER_STATUS_CLOSED:
-            print("🛑 [Status] CLOSE 系ステータス検出")
-            releaseScanner()
-            updateUI(connected: false, message: "スキャナ切断")
+            Log.error(.scanner, "[Status] CLOSE 系ステータス検出")
+            Task { @MainActor in self.connection.scannerLost(scanner) }
         default:
-            print("⚠️ [Status] 不明ステータス: raw=\(st.rawValue)")
+            Log.warning(.scanner, "[Status] 不明ステータス: raw=\(st.rawValue)")
         }
     }
 
-    // MARK: - RFIDScanner Ready Polling -------------------------------------
-    private func waitRFIDReady(_ scanner: CommScanner, retry: Int = 10) {
-        if let r = scanner.getRFIDScanner() {
-            print("✅ [RFID] RFIDScanner 取得成功 — 残リトライ \(retry)")
-            attachAndNotify(rfid: r, comm: scanner)
-            return
+    // MARK: - Connection -----------------------------------------------------
+    @MainActor
+    private func bindConnection() {
+        connection.startDiscovery = {
+            CommManager.sharedInstance()?.startAccept()
         }
-        guard retry > 0 else {
-            print("🛑 [RFID] 取得タイムアウト — 初期化失敗")
-            updateUI(message: "RFID 初期化失敗")
-            return
+        connection.onClaimed = { [weak self] link in
+            guard let self, let comm = link as? CommScanner else { return }
+            self.commScanner = comm
+            comm.addStatusListener(self)
+        }
+        connection.onReady = { [weak self] link, restored in
+            guard let self, let comm = link as? CommScanner, let rfid = comm.getRFIDScanner() else { return }
+            self.attachAndNotify(rfid: rfid, comm: comm, restored: restored)
+        }
+        connection.onLost = { [weak self] _ in
+            self?.scannerLost()
+        }
+        connection.onStateChanged = { [weak self] state in
+            guard let self else { return }
+            self.connectionState = state
+            switch state {
+            case .reconnecting, .failed: self.statusMessage = state.label
+            default: break
+            }
         }
-        print("… [RFID] まだ nil — 残リトライ \(retry)")
-        DispatchQueue.main.asyncAfter(deadline: .now() + 0.1) { [weak self] in
-            self?.waitRFIDReady(scanner, retry: retry - 1)
+        connection.onMetricsChanged = { [weak self] metrics in
+            self?.connectionMetrics = metrics
         }
     }
 
-    private func attachAndNotify(rfid: RFIDScanner, comm: CommScanner) {
-        print("🇯🇵 [Attach] attachAndNotify 実行")
+    @MainActor
+    private func attachAndNotify(rfid: RFIDScanner, comm: CommScanner, restored: Bool) {
+        Log.debug(.scanner, "[Attach] attachAndNotify 実行\(restored ? "（復帰）" : "")")
         rfidScanner = rfid
         commScanner = comm
         rfidScanner?.setDataDelegate(delegate: self)
-        updateUI(connected: true, message: "使用可能です")
-        print("🔔 [Callback] onScannerReady 発火")
+        enableSignalResponse(rfid)
+        // 再接続後はスキャナ側のフィルタ状態が不明なので次の読取開始で送り直す
+        selectFilterDirty = true
+        isConnected = true
+        statusMessage = restored ? "再接続しました: \(comm.getModel() ?? "Unknown")" : "使用可能です"
+        if !restored {
+            Log.debug(.scanner, "[Callback] onConnected 発火")
+            onConnected?(rfid, comm)
+        }
+        Log.debug(.scanner, "[Callback] onScannerReady 発火")
         onScannerReady?(rfid, comm)
+        Task { await self.runReadySteps(restored: restored) }
+    }
+
+    /// 設定 → 登録された処理 → 読取再開 の順に、コマンドキューへ積みながら進める
+    @MainActor
+    private func runReadySteps(restored: Bool) async {
+        if restored, let profile = lastScanProfile {
+            await applyScanProfile(profile)
+        }
+        for step in readySteps {
+            await step(restored)
+        }
+        if restored, resumeReadingOnRestore {
+            resumeReadingOnRestore = false
+            Log.info(.scanner, "[Conn] 切断前の読取を再開")
+            await runRead(action: .start)
+        }
+    }
+
+    /// 接続中のスキャナを失った
+    @MainActor
+    private func scannerLost() {
+        // 手動の再接続でも読取中なら再開する
+        if intendedReadState == .reading || readState == .reading { resumeReadingOnRestore = true }
+        stopPullLoop()
+        endReadSession()
+        releaseScanner()
+        statusMessage = "スキャナが切断されました"
+    }
+
+    /// 読取データに RSSI / アンテナ / 偏波 / ch / 位相 を付加させる
+    private func enableSignalResponse(_ rfid: RFIDScanner) {
+        Task {
+            do {
+                try await commands.run("setResponse", coalescing: true) {
+                    guard let response = try sdkCall({ rfid.getResponse(&$0) }) else {
+                        throw ScannerCommandError.notReady
+                    }
+                    response.pc = true
+                    response.rssi = true
+                    response.antenna = true
+                    response.polarization = true
+                    response.ch = true
+                    response.phase = true
+                    try sdkCall { rfid.setResponse(response, error: &$0) }
+                }
+                ingest.capturesSignal = true
+            } catch ScannerCommandError.superseded {
+                return
+            } catch {
+                Log.warning(.scanner, "[RFID] setResponse 失敗: \(error.localizedDescription)")
+                ingest.capturesSignal = false
+            }
+        }
     }
 
     // MARK: - RFID Data Receive --------------------------------------------
     func OnRFIDDataReceived(scanner: CommScanner!, rfidEvent: RFIDDataReceivedEvent!) {
-        let tags = rfidEvent.getRFIDData()
-            .compactMap { $0.getUII() }
-            .map { $0.map { String(format: "%02X", $0) }.joined() }
-        print("📦 [RFID] データ受信 → 件数 \(tags.count)")
-        Task { @MainActor in
-            for tag in tags where !self.scannedUII.contains(tag) {
-                self.scannedUII.append(tag)
+        // デコード・重複排除は取り込みキュー側で行う
+        guard let reads = rfidEvent.getRFIDData(), !reads.isEmpty else { return }
+        recorderLock.lock()
+        let activeRecorder = recorder
+        recorderLock.unlock()
+        activeRecorder?.append(reads.map(CapturedRead.init(sdk:)))
+        forwardToTap(reads)
+        ingest.push(reads.map(ScanRead.sdk))
+    }
+
+    // MARK: - RSSI Tap -------------------------------------------------------
+    /// 読取 1 件毎の UII / RSSI / 受信時刻（systemUptime）
+    typealias RSSITap = (_ uii: Data, _ rssi: Int, _ receivedAt: TimeInterval) -> Void
+
+    /// 重複排除を通さずに全読取を受け取る（nil で解除）。tap は SDK スレッドで呼ばれる
+    func setRSSITap(_ tap: RSSITap?) {
+        rssiTapLock.lock()
+        rssiTap = tap
+        rssiTapLock.unlock()
+    }
+
+    private func forwardToTap<R: RawTagRead>(_ reads: [R]) {
+        rssiTapLock.lock()
+        let tap = rssiTap
+        rssiTapLock.unlock()
+        guard let tap else { return }
+        let receivedAt = ProcessInfo.processInfo.systemUptime
+        for read in reads {
+            guard let uii = read.uiiData, let rssi = read.signal?.rssi else { continue }
+            tap(uii, rssi, receivedAt)
+        }
+    }
+
+    /// タグ毎の読取記録（初回/最終読取時刻・読取回数）
+    func tagRecord(for uii: EPC) -> TagRecord? { ingest.record(for: uii) }
+
+    /// 取り込みステージの統計（投入/破棄/処理バッチ数など）
+    var ingestCounters: ScanIngestPipeline<ScanRead>.Counters { ingest.currentCounters }
+
+    /// 現在のスキャン結果における指定タグの読取回数合計
+    func readCount<S: Sequence>(of uiis: S) -> Int where S.Element == EPC { ingest.readCount(of: uiis) }
+
+    // MARK: - Scan Profile ---------------------------------------------------
+    /// スキャナの現在の Q値 / セッション / リンクプロファイル
+    func currentScanProfile() async -> ScanProfile? {
+        guard let rfid = rfidScanner else { return nil }
+        return try? await commands.run("getSettings") {
+            guard let settings = try sdkCall({ rfid.getSettings(&$0) }) else { throw ScannerCommandError.notReady }
+            return ScanProfile(qParam: Int(settings.scan.qParam),
+                               session: ScanProfile.Session(settings.scan.sessionFlag),
+                               linkProfile: Int(settings.scan.linkProfile))
+        }
+    }
+
+    /// Q値 / セッション / リンクプロファイルを書き換える
+    @MainActor
+    @discardableResult
+    func applyScanProfile(_ profile: ScanProfile) async -> Bool {
+        let profile = profile.clamped
+        let applied = await reconfigure("applyScanProfile") { scan in
+            scan.qParam = Int16(profile.qParam)
+            scan.sessionFlag = profile.session.sdkValue
+            scan.linkProfile = Int16(profile.linkProfile)
+        }
+        if applied {
+            lastScanProfile = profile
+            Log.info(.scanner, "[Profile] Q=\(profile.qParam) \(profile.session) LP=\(profile.linkProfile)")
+        }
+        return applied
+    }
+
+    /// 読取出力と拡張省電力モードを書き換える（間欠読取用。SettingManager の選択値は変えない）
+    @MainActor
+    @discardableResult
+    func applyPowerPlan(readPower: Int, powerSave: PowerSaveLevel) async -> Bool {
+        let applied = await reconfigure("applyPowerPlan") { scan in
+            scan.powerLevelRead = Int32(readPower)
+            scan.powerSaveExt = powerSave.sdkValue
+        }
+        if applied { Log.info(.scanner, "[Power] \(readPower)dBm / 省電力 \(powerSave)") }
+        return applied
+    }
+
+    /// 現在の読取出力 (dBm) と拡張省電力モード（applyPowerPlan で書き換える前の値を残す用）
+    func currentPowerPlan() async -> (readPower: Int, powerSave: PowerSaveLevel)? {
+        guard let rfid = rfidScanner else { return nil }
+        return try? await commands.run("getSettings") {
+            guard let settings = try sdkCall({ rfid.getSettings(&$0) }) else { throw ScannerCommandError.notReady }
+            return (Int(settings.scan.powerLevelRead), PowerSaveLevel(settings.scan.powerSaveExt))
+        }
+    }
+
+    /// RFID 設定を書き換える。読取中なら一旦閉じて同じ状態で開き直す
+    /// 設定の失敗は false、開き直しの失敗は読取停止として扱う
+    @MainActor
+    private func reconfigure(_ kind: String, _ mutate: @escaping (RFIDScannerScan) -> Void) async -> Bool {
+        guard let rfid = rfidScanner else { return false }
+        let wasReading = intendedReadState == .reading
+        let mode = activeSession?.mode ?? readMode
+
+        do {
+            return try await commands.run(kind, timeout: 10, coalescing: true) { () -> Bool in
+                if wasReading { try sdkCall { rfid.close(&$0) } }
+                var applied = false
+                do {
+                    guard let settings = try sdkCall({ rfid.getSettings(&$0) }) else { throw ScannerCommandError.notReady }
+                    mutate(settings.scan)
+                    try sdkCall { rfid.setSettings(settings, error: &$0) }
+                    applied = true
+                } catch {
+                    Log.warning(.scanner, "[Settings] \(kind) 失敗: \(error.localizedDescription)")
+                }
+                if wasReading { try Self.openInventory(rfid, mode: mode) }
+                return applied
+            }
+        } catch ScannerCommandError.superseded {
+            return false
+        } catch {
+            Log.error(.scanner, "[Settings] 読取再開失敗: \(error.localizedDescription)")
+            if wasReading { readStopped(message: "通信エラー: \(error.localizedDescription)") }
+            return false
+        }
+    }
+
+    // MARK: - Select Filter --------------------------------------------------
+    /// UII プレフィックスの Select フィルタを設定する（OR 条件、空配列で解除）
+    /// 読取中は停止後の次回開始時に反映する
+    func setSelectFilter(_ masks: [SelectMask]) {
+        Task { @MainActor in await self.applySelectFilter(masks) }
+    }
+
+    /// setSelectFilter の完了待ち版（続けて読取を開始する場合用）
+    @MainActor
+    func applySelectFilter(_ masks: [SelectMask]) async {
+        guard masks != selectMasks || selectFilterDirty else { return }
+        selectMasks = masks
+        selectFilterDirty = true
+        if intendedReadState == .standby, let rfid = rfidScanner {
+            await flushSelectFilter(rfid)
+        }
+    }
+
+    /// 現在の（次回読取開始時に使う）Select フィルタ
+    @MainActor
+    var selectFilter: [SelectMask] { selectMasks }
+
+    /// 未送信のフィルタがあればコマンドキューで送る
+    @MainActor
+    private func flushSelectFilter(_ rfid: RFIDScanner) async {
+        guard selectFilterDirty else { return }
+        let masks = selectMasks
+        do {
+            try await commands.run("setFilter", coalescing: true) {
+                if masks.isEmpty {
+                    try sdkCall { rfid.clearFilter(&$0) }
+                } else {
+                    let filters = masks.map(RFIDScannerFilter.init(mask:))
+                    try sdkCall { rfid.setFilter(filters, l_ope: .RFID_LOGICAL_OPE_OR, error: &$0) }
+                }
             }
+            // 送信中に差し替えられていたら dirty のまま残す
+            if masks == selectMasks { selectFilterDirty = false }
+            Log.info(.scanner, masks.isEmpty ? "[Filter] フィルタ解除" : "[Filter] マスク \(masks.count) 件を設定")
+        } catch ScannerCommandError.superseded {
+            return
+        } catch {
+            // dirty のまま残して次回の読取開始で再送する
+            Log.warning(.scanner, "[Filter] フィルタ設定失敗: \(error.localizedDescription)")
         }
     }
 
+    // MARK: - Record / Replay ------------------------------------------------
+    /// 記録ファイルの保存先（Documents/captures）
+    static var captureDirectory: URL {
+        FileManager.default.urls(for: .documentDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("captures", isDirectory: true)
+    }
+
+    /// 受信イベントの記録を開始し、記録先を返す
+    @discardableResult
+    func startRecording() -> URL? {
+        let formatter = DateFormatter()
+        formatter.dateFormat = "yyyyMMdd-HHmmss"
+        let dir = ScannerManager.captureDirectory
+        let url = dir.appendingPathComponent("\(formatter.string(from: Date())).rfcap")
+        do {
+            try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+            let writer = try ScanCaptureWriter(url: url)
+            recorderLock.lock()
+            recorder?.close()
+            recorder = writer
+            recorderLock.unlock()
+            Log.info(.scanner, "[Capture] 記録開始 → \(url.lastPathComponent)")
+            updateRecording(true)
+            return url
+        } catch {
+            Log.error(.scanner, "[Capture] 記録開始失敗: \(error.localizedDescription)")
+            updateUI(message: "記録開始失敗: \(error.localizedDescription)")
+            return nil
+        }
+    }
+
+    /// 記録を終了し、記録ファイルを返す
+    @discardableResult
+    func stopRecording() -> URL? {
+        recorderLock.lock()
+        let writer = recorder
+        recorder = nil
+        recorderLock.unlock()
+        guard let writer else { return nil }
+        writer.close()
+        Log.info(.scanner, "[Capture] 記録終了 → \(writer.url.lastPathComponent) (\(writer.batchCount) イベント)")
+        updateRecording(false)
+        return writer.url
+    }
+
+    /// 記録ファイルを SDK 受信と同じ取り込み経路で再生する
+    /// 読取結果は再生を始める前に同期でクリアする（古い世代で流して捨てられないように）
+    @MainActor
+    func replayCapture(at url: URL, speed: ReplaySpeed = .realtime) throws {
+        let capture = try ScanCapture(contentsOf: url)
+        replayer?.cancel()
+        resetScannedData()
+        let player = ScanReplayer(capture: capture, speed: speed)
+        replayer = player
+        Log.info(.scanner, "[Replay] 再生開始 → \(url.lastPathComponent) (\(capture.batches.count) イベント)")
+        isReplaying = true
+        player.start(deliver: { [weak self] reads in
+            self?.forwardToTap(reads)
+            self?.ingest.push(reads.map(ScanRead.captured))
+        }, completion: { [weak self] in
+            Log.info(.scanner, "[Replay] 再生終了")
+            Task { @MainActor in self?.isReplaying = false }
+        })
+    }
+
+    func stopReplay() {
+        replayer?.cancel()
+        replayer = nil
+    }
+
+    // MARK: - Simulation ---------------------------------------------------
+    /// 仮想スキャナの読取を実機と同じ取り込み経路へ流す（実機なしの負荷試験用）
+    func startSimulation(population: TagPopulation,
+                         settings: SimulatedScanSettings = SimulatedScanSettings()) {
+        simulator?.stop()
+        let sim = SimulatedScanner(population: population, settings: settings)
+        simulator = sim
+        Log.info(.scanner, "[Simulator] 開始 — \(population.count)件, \(settings.powerLevelRead)dBm, Q=\(settings.qParam), \(settings.session)")
+        Task { @MainActor in self.isSimulating = true }
+        sim.start { [weak self] reads in
+            self?.forwardToTap(reads)
+            self?.ingest.push(reads.map(ScanRead.captured))
+        }
+    }
+
+    func stopSimulation() {
+        guard let sim = simulator else { return }
+        sim.stop()
+        simulator = nil
+        Log.info(.scanner, "[Simulator] 停止")
+        Task { @MainActor in self.isSimulating = false }
+    }
+
+    private func updateRecording(_ recording: Bool) {
+        Task { @MainActor in self.isRecording = recording }
+    }
+
     // MARK: - Read Control ---------------------------------------------------
+    /// 読取開始 / 停止をコマンドキューに積む。連打は積んだ後の状態で判定する
     @MainActor
-    private func runRead(action: ReadAction) {
-        print("🇯🇵 [Read] runRead → \(action == .start ? "開始" : "停止")")
-        guard !isOperatingScanner else { print("⚠️ [Read] 他操作中"); return }
-        guard readState.runnable(action: action) else { print("⚠️ [Read] 無効アクション"); return }
+    private func runRead(action: ReadAction) async {
+        Log.debug(.scanner, "[Read] runRead → \(action == .start ? "開始" : "停止")")
+        guard intendedReadState.runnable(action: action) else { Log.warning(.scanner, "[Read] 無効アクション"); return }
         guard let rfid = rfidScanner else {
-            print("🛑 [Read] rfidScanner == nil")
+            Log.error(.scanner, "[Read] rfidScanner == nil")
             statusMessage = "スキャナが接続されていません"
             return
         }
 
-        isOperatingScanner = true
-        var err: NSError?
+        intendedReadState = ReadState.nextState(action: action)
+        let mode = activeSession?.mode ?? readMode
+        do {
+            switch action {
+            case .start:
+                await flushSelectFilter(rfid)
+                try await commands.run("openInventory") { try Self.openInventory(rfid, mode: mode) }
+            case .stop:
+                stopPullLoop()
+                try await commands.run("close") { try sdkCall { rfid.close(&$0) } }
+                // 停止までにスキャナ内に溜まった分を回収
+                if mode == .buffered { await pullBuffered(rfid) }
+            }
+        } catch {
+            Log.error(.scanner, "[Read] エラー: \(error.localizedDescription)")
+            intendedReadState = readState
+            statusMessage = "通信エラー: \(error.localizedDescription)"
+            return
+        }
+
+        Log.debug(.scanner, "[Read] 正常終了")
+        readState = ReadState.nextState(action: action)
+        onReadStateChanged?(readState)
+        statusMessage = action == .start ? "スキャン中…" : "スキャン停止"
         switch action {
-        case .start: rfid.openInventory(&err)
-        case .stop : rfid.close(&err)
+        case .start:
+            await beginReadSession()
+            if mode == .buffered { startPullLoop() }
+        case .stop:
+            endReadSession()
+        }
+    }
+
+    /// 読取が意図せず止まったときの状態合わせ
+    @MainActor
+    private func readStopped(message: String) {
+        stopPullLoop()
+        intendedReadState = .standby
+        readState = .standby
+        onReadStateChanged?(readState)
+        statusMessage = message
+        endReadSession()
+    }
+
+    // MARK: - Buffered Read --------------------------------------------------
+    /// コマンドキュー上で呼ぶこと
+    private static func openInventory(_ rfid: RFIDScanner, mode: ReadMode) throws {
+        switch mode {
+        case .streaming: try sdkCall { rfid.openInventory(&$0) }
+        case .buffered:  try sdkCall { rfid.openInventory(ScannerManager.bufferIndex, error: &$0) }
+        }
+    }
+
+    /// 一定間隔でスキャナ内バッファの件数を見て、溜まっていれば一括取得
+    @MainActor
+    private func startPullLoop() {
+        pullTask?.cancel()
+        pullTask = Task { @MainActor [weak self] in
+            while let self, !Task.isCancelled {
+                try? await Task.sleep(nanoseconds: UInt64(self.bufferedPullInterval * 1_000_000_000))
+                guard !Task.isCancelled, let rfid = self.rfidScanner else { continue }
+                await self.pullBuffered(rfid)
+            }
+        }
+    }
+
+    @MainActor
+    private func stopPullLoop() {
+        pullTask?.cancel()
+        pullTask = nil
+    }
+
+    /// 溜まっている読取を RFIDDataReceived で受け取る
+    @MainActor
+    private func pullBuffered(_ rfid: RFIDScanner) async {
+        do {
+            let count = try await commands.run("pullData", coalescing: true) { () -> Int32 in
+                let count = try sdkCall { rfid.getCount(ScannerManager.bufferIndex, error: &$0) }
+                if count > 0 { try sdkCall { rfid.pullData(ScannerManager.bufferIndex, error: &$0) } }
+                return count
+            }
+            guard count > 0 else { return }
+            activeSession?.pulls += 1
+            Log.debug(.scanner, "[Buffer] \(count)件を取得")
+        } catch ScannerCommandError.superseded {
+            return
+        } catch {
+            Log.warning(.scanner, "[Buffer] 一括取得失敗: \(error.localizedDescription)")
         }
-        isOperatingScanner = false
+    }
 
-        if let e = err {
-            print("🛑 [Read] エラー: \(e.localizedDescription)")
-            statusMessage = "通信エラー: \(e.localizedDescription)"
-        } else {
-            print("✅ [Read] 正常終了")
-            readState = ReadState.nextState(action: action)
-            onReadStateChanged?(readState)
-            statusMessage = action == .start ? "スキャン中…" : "スキャン停止"
+    // MARK: - Read Session Stats -------------------------------------------
+    @MainActor
+    private func beginReadSession() async {
+        UIDevice.current.isBatteryMonitoringEnabled = true
+        var session = ReadSessionStats(mode: readMode)
+        session.hostBatteryStart = UIDevice.current.batteryLevel
+        sessionBaseline = currentSessionCounters()
+        activeSession = session
+        activeSession?.scannerBatteryStart = await scannerBatteryLabel()
+    }
+
+    @MainActor
+    private func endReadSession() {
+        guard var session = activeSession else { return }
+        activeSession = nil
+        session.duration = Date().timeIntervalSince(session.startedAt)
+        // 待っている間に次の読取が始まると sessionBaseline が上書きされるので、この回の基準を取っておく
+        let baseline = sessionBaseline
+        // 停止直前の取得分が取り込み終わるのを待ってから集計
+        Task { @MainActor [weak self] in
+            try? await Task.sleep(nanoseconds: 500_000_000)
+            guard let self else { return }
+            session.record(from: baseline, to: self.currentSessionCounters())
+            session.hostBatteryEnd = UIDevice.current.batteryLevel
+            session.scannerBatteryEnd = await self.scannerBatteryLabel()
+            self.sessionStats[session.mode] = session
+            Log.info(.scanner, String(format: "[Session] %@: %.1f tags/s, %ld reads / %ld callbacks (%ld pulls)",
+                         session.mode.label, session.tagsPerSecond,
+                         session.reads, session.callbacks, session.pulls))
         }
     }
 
+    @MainActor
+    private func currentSessionCounters() -> ReadSessionCounters {
+        let counters = ingest.currentCounters
+        return ReadSessionCounters(reads: counters.readsDecoded, callbacks: counters.batchesPushed, unique: scannedCount)
+    }
+
+    /// スキャナの電池残量（SDK は 3 段階でしか返さない）
+    func scannerBatteryBand() async -> BatteryBand? {
+        guard let comm = commScanner,
+              let level = try? await commands.run("getRemainingBattery", coalescing: true, { try sdkCall { comm.getRemainingBattery(&$0) } })
+        else { return nil }
+        return BatteryBand(level)
+    }
+
+    private func scannerBatteryLabel() async -> String {
+        await scannerBatteryBand()?.label ?? "-"
+    }
+
     // MARK: - Release --------------------------------------------------------
+    @MainActor
     private func releaseScanner() {
-        print("🇯🇵 [Release] リソース解放開始")
-        var e: NSError?
-        rfidScanner?.setDataDelegate(delegate: nil)
-        rfidScanner?.close(&e)
-        commScanner?.getParams(&e)
+        Log.debug(.scanner, "[Release] リソース解放開始")
+        // 切断済みのスキャナへの close は応答が返らないことがあるので短いタイムアウトで流す
+        if let rfid = rfidScanner {
+            rfid.setDataDelegate(delegate: nil)
+            Task { try? await commands.run("release", timeout: 1) { try sdkCall { rfid.close(&$0) } } }
+        }
         rfidScanner = nil
         commScanner = nil
         readState   = .standby
+        intendedReadState = .standby
         isConnected = false
     }
 
     // MARK: - UI Utility -----------------------------------------------------
-    private func updateUI(connected: Bool? = nil, message: String) {
+    private func updateUI(message: String) {
         Task { @MainActor in
-            if let c = connected { self.isConnected = c }
             self.statusMessage = message
         }
     }
@@ -230,25 +777,111 @@ final class ScannerManager: NSObject,
     @discardableResult
     func sendCommScannerParams(settingDataSet: SettingDataSet,
                                commScanner: CommScanner) -> Bool {
-        print("📨 [Stub] sendCommScannerParams — 呼び出し確認 OK")
+        Log.debug(.scanner, "[Stub] sendCommScannerParams — 呼び出し確認 OK")
         return true
     }
 
     @discardableResult
     func sendRFIDScannerSettings(settingDataSet: SettingDataSet,
                                  commScanner: CommScanner) -> Bool {
-        print("📨 [Stub] sendRFIDScannerSettings — 呼び出し確認 OK")
+        Log.debug(.scanner, "[Stub] sendRFIDScannerSettings — 呼び出し確認 OK")
         return true
     }
 
     @discardableResult
     func sendBarcodeScannerSettings(settingDataSet: SettingDataSet,
                                     commScanner: CommScanner) -> Bool {
-        print("📨 [Stub] sendBarcodeScannerSettings — 呼び出し確認 OK")
+        Log.debug(.scanner, "[Stub] sendBarcodeScannerSettings — 呼び出し確認 OK")
         return true
     }
 }
 
+// MARK: - SDK 型の取り込み対応 --------------------------------------------------
+/// 取り込みステージに流す読取（実機 / 記録再生）
+enum ScanRead: RawTagRead {
+    case sdk(RFIDData)
+    case captured(CapturedRead)
+
+    var uiiData: Data? {
+        switch self {
+        case .sdk(let read):      return read.uiiData
+        case .captured(let read): return read.uiiData
+        }
+    }
+
+    var signal: SignalSample? {
+        switch self {
+        case .sdk(let read):      return read.signal
+        case .captured(let read): return read.signal
+        }
+    }
+}
+
+extension CapturedRead {
+    init(sdk read: RFIDData) {
+        self.init(uii: read.getUII() ?? Data(), pc: read.getPC(), rssi: read.getRSSI())
+    }
+}
+
+extension SimulatedScanSettings {
+    /// 実機の読取設定を写す（設定比較のたたき台にする）
+    init(scan: RFIDScannerScan) {
+        self.init()
+        powerLevelRead = Int(scan.powerLevelRead)
+        qParam = Int(scan.qParam)
+        switch scan.sessionFlag {
+        case .SESSION_FLAG_S1: session = .s1
+        case .SESSION_FLAG_S2: session = .s2
+        case .SESSION_FLAG_S3: session = .s3
+        default:               session = .s0
+        }
+    }
+}
+
+extension ScanProfile.Session {
+    init(_ flag: SessionFlag) {
+        switch flag {
+        case .SESSION_FLAG_S1: self = .s1
+        case .SESSION_FLAG_S2: self = .s2
+        case .SESSION_FLAG_S3: self = .s3
+        default:               self = .s0
+        }
+    }
+
+    var sdkValue: SessionFlag {
+        switch self {
+        case .s0: return .SESSION_FLAG_S0
+        case .s1: return .SESSION_FLAG_S1
+        case .s2: return .SESSION_FLAG_S2
+        case .s3: return .SESSION_FLAG_S3
+        }
+    }
+}
+
+extension RFIDScannerFilter {
+    /// UII バンクは CRC(16bit) + PC(16bit) の後ろから EPC が始まる
+    static let epcBitOffset = 0x20
+
+    convenience init(mask: SelectMask) {
+        self.init()
+        bank = .BANK_UII
+        bitOffset = RFIDScannerFilter.epcBitOffset
+        bitLength = Int16(mask.bitLength)
+        filterData = mask.bytes.map { NSNumber(value: $0) }
+    }
+}
+
+extension RFIDData: RawTagRead {
+    var uiiData: Data? { getUII() }
+    var signal: SignalSample? {
+        SignalSample(rssi: getRSSI(),
+                     antenna: getAntenna(),
+                     channel: Int(getCh()),
+                     phase: Int(getPhase()),
+                     polarization: Int(getPolarization()))
+    }
+}
+
 // MARK: - Read enums --------------------------------------------------------
 enum ReadAction { case start, stop }
 
@@ -260,3 +893,41 @@ enum ReadState {
         action == .start ? .reading : .standby
     }
 }
+
+extension CommScanner: ScannerLink {
+    var modelName: String { getModel() ?? "unknown" }
+
+    func claimLink() throws {
+        try sdkCall { claim(&$0) }
+    }
+
+    var isRFIDAvailable: Bool { getRFIDScanner() != nil }
+}
+
+extension BatteryBand {
+    init(_ level: CommBattery) {
+        switch level {
+        case .COMM_BATTERY_UNDER10: self = .under10
+        case .COMM_BATTERY_UNDER40: self = .under40
+        default:                    self = .over40
+        }
+    }
+}
+
+extension PowerSaveLevel {
+    init(_ sdk: PowerSaveExt) {
+        switch sdk {
+        case .POWERSAVE_EXT_MODE1: self = .mode1
+        case .POWERSAVE_EXT_MODE2: self = .mode2
+        default:                   self = .off
+        }
+    }
+
+    var sdkValue: PowerSaveExt {
+        switch self {
+        case .off:   return .POWERSAVE_EXT_DISABLE
+        case .mode1: return .POWERSAVE_EXT_MODE1
+        case .mode2: return .POWERSAVE_EXT_MODE2
+        }
+    }
+}
@@ -0,0 +1,78 @@
+//
+//  SelectMaskPlanner.swift
+//  RFID_ios
+//
+//  Created on 2025/05/12.
+//
+//  マスター UII 一覧を覆うプレフィックスマスク（Gen2 Select）を求める
+//    • UII を辞書順に並べ、隣同士の共通プレフィックス長で単連結クラスタリング
+//    • 共通プレフィックスが最も短い境界から順に maxMasks 個のグループへ分割
+//    • 各グループの共通プレフィックスがそのままマスクになる
+//  マスター外のタグもプレフィックスが一致すれば通るので、漏れ量は matches で確認する
+//
+
+import Foundation
+
+/// UII バンク上のプレフィックスマスク 1 件
+struct SelectMask: Hashable {
+    /// 先頭 bitLength ビット以外は 0
+    let prefix: EPC
+    /// 有効ビット長（1〜128）
+    let bitLength: Int
+
+    /// マスクデータ（左詰め、bitLength を切り上げたバイト数）
+    var bytes: [UInt8] { prefix.bytes }
+
+    func matches(_ uii: EPC) -> Bool {
+        uii.count * 8 >= bitLength && uii.commonPrefixBitLength(with: prefix) >= bitLength
+    }
+}
+
+enum SelectMaskPlanner {
+
+    /// 1 マスク以上の絞り込みにならない（全タグが通る）場合は空配列
+    static func plan<S: Sequence>(covering uiis: S, maxMasks: Int = 8) -> [SelectMask] where S.Element == EPC {
+        let sorted = Array(Set(uiis)).sorted()
+        guard !sorted.isEmpty, maxMasks > 0 else { return [] }
+
+        // 隣接する UII の共通プレフィックス長
+        let lcps = zip(sorted, sorted.dropFirst()).map { $0.commonPrefixBitLength(with: $1) }
+
+        // 共通プレフィックスが短い境界ほど先に切る（同値は前方優先）
+        let cutCount = min(maxMasks - 1, lcps.count)
+        let cuts = Set(lcps.indices
+            .sorted { lcps[$0] != lcps[$1] ? lcps[$0] < lcps[$1] : $0 < $1 }
+            .prefix(cutCount))
+
+        var masks: [SelectMask] = []
+        var groupLength = sorted[0].count * 8
+        var groupHead = sorted[0]
+        for i in 0..<sorted.count {
+            let isLast = i == sorted.count - 1
+            if isLast || cuts.contains(i) {
+                append(SelectMask(prefix: groupHead.prefix(bitLength: groupLength), bitLength: groupLength),
+                       to: &masks)
+                if !isLast {
+                    groupHead = sorted[i + 1]
+                    groupLength = groupHead.count * 8
+                }
+            } else {
+                groupLength = min(groupLength, lcps[i], sorted[i + 1].count * 8)
+            }
+        }
+        // 長さ 0 のマスクは全タグを通すのでフィルタにならない
+        return masks.contains { $0.bitLength == 0 } ? [] : masks
+    }
+
+    /// 直前のマスクと包含関係にあれば短い方だけ残す
+    private static func append(_ mask: SelectMask, to masks: inout [SelectMask]) {
+        guard let last = masks.last else { masks.append(mask); return }
+        let shorter = last.bitLength <= mask.bitLength ? last : mask
+        let longer = last.bitLength <= mask.bitLength ? mask : last
+        if shorter.matches(longer.prefix) {
+            masks[masks.count - 1] = shorter
+        } else {
+            masks.append(mask)
+        }
+    }
+}
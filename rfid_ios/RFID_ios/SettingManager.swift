@@ -14,22 +14,22 @@ final class SettingManager: ObservableObject {
 
     // MARK: - 公開プロパティ --------------------------------------------------
     @Published private(set) var batteryLevel: CommBattery = .COMM_BATTERY_UNDER10 {
-        didSet { print("🟢 batteryLevel 変更 → \(batteryLevel)") }
+        didSet { Log.debug(.settings, "batteryLevel 変更 → \(batteryLevel)") }
     }
     @Published private(set) var isConnected: Bool = false {
-        didSet { print("🟢 isConnected 変更 → \(isConnected)") }
+        didSet { Log.debug(.settings, "isConnected 変更 → \(isConnected)") }
     }
 
     /// 選択中ブザータイプ (B1/B2/B3)
     @Published var selectedBuzzer: CommBuzzerType = .COMM_BUZZER_B1 {
-        didSet { print("🟢 selectedBuzzer 変更 → \(selectedBuzzer)") }
+        didSet { Log.debug(.settings, "selectedBuzzer 変更 → \(selectedBuzzer)") }
     }
 
     /// ブザー有効/無効スイッチ (UI で ON/OFF)
     @Published var isBuzzerOn: Bool = true {
         didSet {
-            print("🟢 isBuzzerOn 変更 → \(isBuzzerOn)")
-            toggleBuzzer(on: isBuzzerOn)
+            Log.debug(.settings, "isBuzzerOn 変更 → \(isBuzzerOn)")
+            Task { await toggleBuzzer(on: isBuzzerOn) }
         }
     }
 
@@ -41,8 +41,11 @@ final class SettingManager: ObservableObject {
     /// 選択中の読み取りパワーレベル
     @Published var selectedReadPower: Int = 30 {
         didSet {
-            print("🟢 selectedReadPower 変更 → \(selectedReadPower)dBm")
-            _ = updateReadPower()
+            Log.debug(.settings, "selectedReadPower 変更 → \(selectedReadPower)dBm")
+            // スキャナから読んだ値を UI に反映しただけなら送り返さない
+            guard !isSyncingReadPower else { return }
+            // 連続で変えた場合は最後の値だけが送られる（coalescing）
+            Task { await updateReadPower() }
         }
     }
     // ↑ ここまで追加部分 ↑
@@ -52,46 +55,63 @@ final class SettingManager: ObservableObject {
     private weak var scannerManager: ScannerManager?
     private var cancellables = Set<AnyCancellable>()
     private var commScanner: CommScanner? { scannerManager?.commScanner }
+    private var commands: ScannerCommandQueue? { scannerManager?.commands }
+    /// 公開用の isConnected は main キュー経由で遅れて変わるので、判定は ScannerManager を直接見る
+    private var isScannerReady: Bool { scannerManager?.isConnected ?? false }
+    /// loadCurrentReadPower で UI を合わせるときは送り返さない
+    private var isSyncingReadPower = false
 
     // MARK: - 初期化 ----------------------------------------------------------
     init(scannerManager: ScannerManager) {
         self.scannerManager = scannerManager
-        print("🔸 SettingManager 初期化 — scannerManager: \(scannerManager)")
+        Log.debug(.settings, "SettingManager 初期化 — scannerManager: \(scannerManager)")
         observeScannerConnection()
-        updateBatteryLevel()
+        refreshBatteryLevel()
+        // 初回接続ではスキャナの値を UI に読み、切断からの復帰では UI の値を送り直す
+        scannerManager.addReadyStep { [weak self] restored in
+            guard let self else { return }
+            if restored {
+                await self.toggleBuzzer(on: self.isBuzzerOn)
+                await self.updateReadPower()
+            } else {
+                await self.loadCurrentReadPower()
+            }
+        }
     }
-    deinit { print("🔴 SettingManager 解放") }
+    deinit { Log.debug(.settings, "SettingManager 解放") }
 
     // MARK: - パブリック API ---------------------------------------------------
     func refreshBatteryLevel() {
-        print("🔸 refreshBatteryLevel() 呼び出し")
-        updateBatteryLevel()
+        Log.debug(.settings, "refreshBatteryLevel() 呼び出し")
+        Task { await updateBatteryLevel() }
     }
 
     func playSelectedBuzzer() {
         guard isBuzzerOn else {
-            print("⚠️ ブザーOFF設定のため鳴動スキップ")
+            Log.warning(.settings, "ブザーOFF設定のため鳴動スキップ")
             return
         }
-        guard let scanner = commScanner, isConnected else {
-            print("⚠️ ブザー鳴動失敗: スキャナ未接続")
+        guard let scanner = commScanner, let commands, isScannerReady else {
+            Log.warning(.settings, "ブザー鳴動失敗: スキャナ未接続")
             return
         }
-        print("🔸 playSelectedBuzzer() – type: \(selectedBuzzer)")
-        var error: NSError?
-        scanner.buzzer(selectedBuzzer, error: &error)
-        if let error = error {
-            print("⚠️ ブザー鳴動失敗: \(error.localizedDescription)")
-        } else {
-            print("✅ ブザー鳴動成功: \(selectedBuzzer)")
+        let type = selectedBuzzer
+        Log.debug(.settings, "playSelectedBuzzer() – type: \(type)")
+        Task {
+            do {
+                try await commands.run("buzzer") { try sdkCall { scanner.buzzer(type, error: &$0) } }
+                Log.info(.settings, "ブザー鳴動成功: \(type)")
+            } catch {
+                Log.warning(.settings, "ブザー鳴動失敗: \(error.localizedDescription)")
+            }
         }
     }
 
     /// 設定一括保存 (UI の[保存]ボタンから呼ぶ想定)
-    func saveAllSettings() {
-        print("🔸 saveAllSettings() 開始")
-        guard let scanner = commScanner, isConnected else {
-            print("⚠️ saveAllSettings(): スキャナ未接続")
+    func saveAllSettings() async {
+        Log.info(.settings, "saveAllSettings() 開始")
+        guard let scanner = commScanner, isScannerReady else {
+            Log.warning(.settings, "saveAllSettings(): スキャナ未接続")
             return
         }
 
@@ -105,25 +125,25 @@ final class SettingManager: ObservableObject {
             result = sendBarcodeScannerSettings(settingDataSet: dataSetStruct, commScanner: scanner)
         }
         if result {
-            result = toggleBuzzer(on: isBuzzerOn)
+            result = await toggleBuzzer(on: isBuzzerOn)
         }
         // ────────────────────────────────────────────────
 
         // 読み取り強度を最後に反映
         if result {
-            _ = updateReadPower()
+            await updateReadPower()
         }
     }
 
     /// 現在のパワーレベルをスキャナから再取得して UI へ反映
     func fetchCurrentReadPower() {
-        loadCurrentReadPower()
+        Task { await loadCurrentReadPower() }
     }
 
     /// Picker で選択したパワーレベルをスキャナへ保存
     @discardableResult
-    func saveReadPower() -> Bool {
-        updateReadPower()
+    func saveReadPower() async -> Bool {
+        await updateReadPower()
     }
 
     // MARK: - 内部処理 --------------------------------------------------------
@@ -133,73 +153,69 @@ final class SettingManager: ObservableObject {
             .sink { [weak self] connected in
                 guard let self = self else { return }
                 self.isConnected = connected
-                updateBatteryLevel()
-                if connected {
-                    loadCurrentReadPower()
-                }
+                Task { await self.updateBatteryLevel() }
             }
             .store(in: &cancellables)
     }
 
-    private func updateBatteryLevel() {
-        guard let scanner = commScanner, isConnected else {
+    private func updateBatteryLevel() async {
+        guard let scanner = commScanner, let commands, isScannerReady else {
             batteryLevel = .COMM_BATTERY_UNDER10
             return
         }
-        var error: NSError?
-        let level = scanner.getRemainingBattery(&error)
-        batteryLevel = (error == nil) ? level : .COMM_BATTERY_UNDER10
+        let level = try? await commands.run("getRemainingBattery", coalescing: true) {
+            try sdkCall { scanner.getRemainingBattery(&$0) }
+        }
+        batteryLevel = level ?? .COMM_BATTERY_UNDER10
     }
 
     @discardableResult
-    private func toggleBuzzer(on enabled: Bool) -> Bool {
-        guard let scanner = commScanner, isConnected else { return false }
-        var error: NSError?
-        guard let params = scanner.getParams(&error) else {
-            print("⚠️ getParams 失敗: \(error?.localizedDescription ?? "")")
-            return false
-        }
-        params.notification.sound.buzzer = enabled ? .BUZZER_ENABLE : .BUZZER_DISABLE
-        scanner.setParams(params, error: &error)
-        if let error = error {
-            print("⚠️ setParams 失敗: \(error.localizedDescription)")
+    private func toggleBuzzer(on enabled: Bool) async -> Bool {
+        guard let scanner = commScanner, let commands, isScannerReady else { return false }
+        do {
+            try await commands.run("setBuzzerParams", coalescing: true) {
+                guard let params = try sdkCall({ scanner.getParams(&$0) }) else { throw ScannerCommandError.notReady }
+                params.notification.sound.buzzer = enabled ? .BUZZER_ENABLE : .BUZZER_DISABLE
+                try sdkCall { scanner.setParams(params, error: &$0) }
+                try sdkCall { scanner.saveParams(&$0) }
+            }
+            return true
+        } catch ScannerCommandError.superseded {
             return false
-        }
-        scanner.saveParams(&error)
-        if let error = error {
-            print("⚠️ saveParams 失敗: \(error.localizedDescription)")
+        } catch {
+            Log.warning(.settings, "ブザー設定失敗: \(error.localizedDescription)")
             return false
         }
-        return true
     }
 
     // ──────────────────────────────────────────────────────────
     // ↓ 修正: 読み取り強度反映メソッド ↓
     @discardableResult
-    private func updateReadPower() -> Bool {
-        guard let scanner = commScanner, isConnected else {
-            print("⚠️ updateReadPower(): スキャナ未接続")
-            return false
-        }
-        var error: NSError?
-        guard let rfidScanner = scanner.getRFIDScanner() else {
-            print("⚠️ getRFIDScanner() 失敗")
-            return false
-        }
-        guard var settings = rfidScanner.getSettings(&error) else {
-            print("⚠️ getSettings 失敗: \(error?.localizedDescription ?? "")")
+    private func updateReadPower() async -> Bool {
+        guard let scanner = commScanner, let commands, isScannerReady else {
+            Log.warning(.settings, "updateReadPower(): スキャナ未接続")
             return false
         }
         let sdkValue = Int32(selectedReadPower)
-        settings.scan.powerLevelRead = sdkValue
-        settings.scan.powerLevelWrite = sdkValue
-        rfidScanner.setSettings(settings, error: &error)
-        if let error = error {
-            print("⚠️ setSettings 失敗: \(error.localizedDescription)")
+        do {
+            try await commands.run("setReadPower", coalescing: true) {
+                guard let rfidScanner = scanner.getRFIDScanner(),
+                      let settings = try sdkCall({ rfidScanner.getSettings(&$0) }) else {
+                    throw ScannerCommandError.notReady
+                }
+                settings.scan.powerLevelRead = sdkValue
+                settings.scan.powerLevelWrite = sdkValue
+                try sdkCall { rfidScanner.setSettings(settings, error: &$0) }
+            }
+            Log.info(.settings, "PowerLevelRead 更新完了 → \(sdkValue)dBm (sdkValue(raw)=\(sdkValue))")
+            return true
+        } catch ScannerCommandError.superseded {
+            Log.info(.settings, "PowerLevelRead \(sdkValue)dBm は後の変更に置き換え")
+            return false
+        } catch {
+            Log.warning(.settings, "setSettings 失敗: \(error.localizedDescription)")
             return false
         }
-        print("✅ PowerLevelRead 更新完了 → \(selectedReadPower)dBm (sdkValue(raw)=\(sdkValue))")
-        return true
     }
     // ↑ ここまで修正部分 ↑
     // ──────────────────────────────────────────────────────────
@@ -216,20 +232,28 @@ final class SettingManager: ObservableObject {
     }
 
     // MARK: - 現在のパワーレベル取得 --------------------------------------
-    private func loadCurrentReadPower() {
-        guard let scanner = commScanner, isConnected else { return }
-        var error: NSError?
-        guard let rfidScanner = scanner.getRFIDScanner(),
-              let settings = rfidScanner.getSettings(&error) else {
-            print("⚠️ loadCurrentReadPower(): 設定取得失敗 → \(error?.localizedDescription ?? "")")
+    private func loadCurrentReadPower() async {
+        guard let scanner = commScanner, let commands, isScannerReady else { return }
+        let currentSdkValue: Int
+        do {
+            currentSdkValue = try await commands.run("getReadPower") {
+                guard let rfidScanner = scanner.getRFIDScanner(),
+                      let settings = try sdkCall({ rfidScanner.getSettings(&$0) }) else {
+                    throw ScannerCommandError.notReady
+                }
+                return Int(settings.scan.powerLevelRead)
+            }
+        } catch {
+            Log.warning(.settings, "loadCurrentReadPower(): 設定取得失敗 → \(error.localizedDescription)")
             return
         }
-        let currentSdkValue = Int(settings.scan.powerLevelRead)
         let currentDbm      = currentSdkValue // SDK は dBm そのまま返す
-        print("🔸 取得したパワーレベル = \(currentSdkValue)dBm")
+        Log.debug(.settings, "取得したパワーレベル = \(currentSdkValue)dBm")
         if readPowerRange.contains(currentDbm) {
-            // プロパティ更新 (UI反映)。同値なら didSet は発火しない
+            // プロパティ更新 (UI反映)。スキャナの値なので送り返さない
+            isSyncingReadPower = true
             selectedReadPower = currentDbm
+            isSyncingReadPower = false
         }
     }
 }
@@ -10,6 +10,12 @@ import DENSOScannerSDK   // CommBattery 型参照
 struct SettingsView: View {
 
     @EnvironmentObject var settingManager: SettingManager
+    @EnvironmentObject var tuningManager: ScanTuningManager
+    @EnvironmentObject var scanner: ScannerManager
+    @EnvironmentObject var dutyCycle: DutyCycleManager
+    @EnvironmentObject var sync: MasterSyncManager
+    @EnvironmentObject var compare: CompareMasterManager
+    @State private var commandLatency: [(kind: String, latency: ScannerCommandQueue.Latency)] = []
 
     var body: some View {
         NavigationView {
@@ -42,6 +48,81 @@ struct SettingsView: View {
 
                 }
 
+                // 読取モード（逐次通知 / スキャナ内バッファ一括取得）
+                Section(header: Text("Read Mode")) {
+                    Picker("Mode", selection: $scanner.readMode) {
+                        ForEach(ReadMode.allCases) { Text($0.label).tag($0) }
+                    }
+                    .pickerStyle(SegmentedPickerStyle())
+                    .disabled(scanner.readState != .standby)
+
+                    ForEach(ReadMode.allCases) { mode in
+                        if let stats = scanner.sessionStats[mode] {
+                            VStack(alignment: .leading, spacing: 2) {
+                                Text("\(mode.label): \(String(format: "%.1f", stats.tagsPerSecond)) tags/s")
+                                Text("\(stats.reads) reads / \(stats.callbacks) callbacks / \(Int(stats.duration))s")
+                                    .font(.caption)
+                                    .foregroundColor(.secondary)
+                                Text("Battery: \(batteryDrainText(stats)) / Scanner \(stats.scannerBatteryStart) → \(stats.scannerBatteryEnd)")
+                                    .font(.caption)
+                                    .foregroundColor(.secondary)
+                            }
+                        }
+                    }
+                }
+
+                // 読取設定の自動調整（対象毎に保存）
+                Section(header: Text("Auto Tuning (\(tuningManager.target.rawValue))")) {
+                    if let profile = tuningManager.currentProfile {
+                        Text("Q=\(profile.qParam) / Session \(String(describing: profile.session).uppercased()) / Link Profile \(profile.linkProfile)")
+                    }
+                    HStack {
+                        Text(tuningManager.statusMessage)
+                        Spacer()
+                        if tuningManager.isTuning {
+                            Text(String(format: "%.1f tags/s", tuningManager.discoveryRate))
+                                .foregroundColor(.secondary)
+                        }
+                    }
+                    Button(tuningManager.isTuning ? "Stop Tuning" : "Start Tuning") {
+                        Task {
+                            if tuningManager.isTuning {
+                                await tuningManager.stopTuning()
+                            } else {
+                                await tuningManager.startTuning()
+                            }
+                        }
+                    }
+                    .disabled(!settingManager.isConnected)
+                }
+
+                // 長時間の棚卸し向け間欠読取
+                Section(header: Text("Duty Cycle")) {
+                    if let step = dutyCycle.step {
+                        Text(String(format: "%.1f tags/s → 休止 %.0fs / %lddBm / 省電力 %@",
+                                    dutyCycle.discoveryRate, step.idle, step.readPower, "\(step.powerSave)"))
+                            .font(.caption.monospacedDigit())
+                        Text("Scanner Battery \(dutyCycle.battery?.label ?? "-")")
+                            .font(.caption)
+                            .foregroundColor(.secondary)
+                    }
+                    if let report = dutyCycle.lastReport {
+                        Text(dutyCycleReportText(report))
+                            .font(.caption)
+                            .foregroundColor(.secondary)
+                    }
+                    Button(dutyCycle.isRunning ? "Stop Duty Cycle" : "Start Duty Cycle") {
+                        Task {
+                            if dutyCycle.isRunning {
+                                await dutyCycle.stop()
+                            } else {
+                                await dutyCycle.start()
+                            }
+                        }
+                    }
+                    .disabled(!settingManager.isConnected || tuningManager.isTuning)
+                }
+
                 Section(header: Text("Scanner Info")) {
                     HStack {
                         Text("Battery Status")
@@ -55,14 +136,142 @@ struct SettingsView: View {
                         settingManager.refreshBatteryLevel()
                     }
                     .disabled(!settingManager.isConnected)
+                    HStack {
+                        Text("Connection")
+                        Spacer()
+                        Text(scanner.connectionState.label).foregroundColor(.secondary)
+                    }
+                    HStack {
+                        Text("Claim / Ready")
+                        Spacer()
+                        Text("\(millisText(scanner.connectionMetrics.timeToClaim)) / \(millisText(scanner.connectionMetrics.timeToReady))")
+                            .font(.caption.monospacedDigit())
+                            .foregroundColor(.secondary)
+                    }
+                    if scanner.connectionMetrics.reconnects > 0 {
+                        HStack {
+                            Text("Reconnects")
+                            Spacer()
+                            Text("\(scanner.connectionMetrics.reconnects)回 (直近の切断 \(millisText(scanner.connectionMetrics.lastOutage)))")
+                                .font(.caption.monospacedDigit())
+                                .foregroundColor(.secondary)
+                        }
+                    }
+                }
+
+                Section(header: Text("Command Latency")) {
+                    ForEach(commandLatency, id: \.kind) { entry in
+                        HStack {
+                            Text(entry.kind)
+                            Spacer()
+                            Text(latencyText(entry.latency))
+                                .font(.caption.monospacedDigit())
+                                .foregroundColor(.secondary)
+                        }
+                    }
+                    Button("Refresh Latency") { refreshCommandLatency() }
+                }
+
+                // 端末のストアと送信待ち
+                Section(header: Text("Local Store")) {
+                    HStack {
+                        Text("Items / Masters")
+                        Spacer()
+                        Text("\(sync.localItemCount) / \(sync.localMasterCount)")
+                            .font(.caption.monospacedDigit())
+                            .foregroundColor(.secondary)
+                    }
+                    HStack {
+                        Text("Pending Uploads")
+                        Spacer()
+                        Text("\(sync.pendingUploads)")
+                            .font(.caption.monospacedDigit())
+                            .foregroundColor(.secondary)
+                    }
+                    if let last = sync.lastSyncedAt {
+                        Text("Last Sync \(last.formatted(date: .omitted, time: .standard))")
+                            .font(.caption)
+                            .foregroundColor(.secondary)
+                    }
+                    if let error = sync.lastError {
+                        Text(error).font(.caption).foregroundColor(.red)
+                    }
+                    Button("Sync Now") { Task { await sync.pull(); sync.requestUpload() } }
+                        .disabled(sync.isSyncing)
+                    Button("Full Resync") { Task { await compare.fullResync() } }
+                        .disabled(sync.isSyncing || sync.pendingUploads > 0)
+                }
+
+                // 照合の前段フィルタ（Bloom）
+                Section(header: Text("Master Prefilter")) {
+                    Toggle("Bloom Prefilter", isOn: $compare.usesMasterPrefilter)
+                    if let report = compare.prefilterReport {
+                        Text(prefilterMemoryText(report))
+                            .font(.caption.monospacedDigit())
+                            .foregroundColor(.secondary)
+                        Text(prefilterRateText(report))
+                            .font(.caption.monospacedDigit())
+                            .foregroundColor(.secondary)
+                    }
+                }
+                .onReceive(Timer.publish(every: 1, on: .main, in: .common).autoconnect()) { _ in
+                    compare.refreshFilterReport()
+                }
+
+                Section(header: Text("Debug")) {
+                    NavigationLink("Hot Path Metrics") { HotPathMetricsView() }
+                    NavigationLink("Log") { LogView() }
                 }
             }
             .navigationTitle("Settings")
+            .onAppear { refreshCommandLatency() }
         }
     }
 
+    private func refreshCommandLatency() {
+        commandLatency = scanner.commands.latencySnapshot()
+            .sorted { $0.key < $1.key }
+            .map { (kind: $0.key, latency: $0.value) }
+    }
+
     // MARK: - 表示ヘルパー -----------------------------------------------------
 
+    private func dutyCycleReportText(_ report: DutyCycleReport) -> String {
+        let perPercent = report.tagsPerHostPercent.map { String(format: "%.0f tags/%%", $0) } ?? "- tags/%"
+        return String(format: "前回 %ld tags / %.0f分 / 読取 %.0f%% / iPhone %@",
+                      report.uniqueTags, report.duration / 60, report.dutyRatio * 100, perPercent)
+    }
+
+    private func prefilterMemoryText(_ report: MasterPrefilterReport) -> String {
+        let bytes = { ByteCountFormatter.string(fromByteCount: Int64($0), countStyle: .memory) }
+        return "\(report.keys) keys / \(bytes(report.memoryBytes)) (k=\(report.hashCount)) / exact ≈ \(bytes(report.exactSetBytes))"
+    }
+
+    private func prefilterRateText(_ report: MasterPrefilterReport) -> String {
+        let observed = report.observedFalsePositiveRate.map { String(format: "%.2f%%", $0 * 100) } ?? "-"
+        return String(format: "FPR 期待 %.2f%% / 実測 %@  落とした %ld / 確認 %ld / 偽陽性 %ld",
+                      report.expectedFalsePositiveRate * 100, observed,
+                      report.rejected, report.confirmed, report.falsePositives)
+    }
+
+    private func millisText(_ seconds: TimeInterval?) -> String {
+        guard let seconds else { return "-" }
+        return String(format: "%.0fms", seconds * 1000)
+    }
+
+    private func latencyText(_ latency: ScannerCommandQueue.Latency) -> String {
+        var text = String(format: "p50 %.0fms / p95 %.0fms  ×%ld",
+                          latency.p50ExecMillis, latency.p95ExecMillis, latency.completed)
+        let dropped = latency.failed + latency.timedOut + latency.superseded + latency.cancelled
+        if dropped > 0 { text += String(format: " (失敗/破棄 %ld)", dropped) }
+        return text
+    }
+
+    private func batteryDrainText(_ stats: ReadSessionStats) -> String {
+        guard let drain = stats.hostDrainPerHour else { return "iPhone -" }
+        return String(format: "iPhone %.1f%%/h", drain)
+    }
+
     @ViewBuilder
     private func batteryStatusView(for level: CommBattery,
                                    isConnected: Bool) -> some View {
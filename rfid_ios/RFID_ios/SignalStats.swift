@@ -0,0 +1,47 @@
+//
+//  SignalStats.swift
+//  RFID_ios
+//
+//  Created on 2025/05/09.
+//
+//  読取毎の電波情報（RSSI / アンテナ / 周波数ch / 位相 / 偏波）と
+//  タグ毎の累積統計。統計は固定長の値型なので読取毎のヒープ確保は発生しない
+//
+
+import Foundation
+
+/// 1 読取分の電波情報（値は SDK の RFIDData から取得したまま）
+struct SignalSample {
+    var rssi: Int
+    var antenna: Int
+    var channel: Int
+    var phase: Int
+    var polarization: Int
+}
+
+/// タグ毎の電波統計（逐次更新）
+struct SignalStats {
+    /// RSSI を含む読取の件数
+    private(set) var sampleCount = 0
+    /// RSSI の平均（全読取の逐次平均）
+    private(set) var rssiMean = 0.0
+    private(set) var rssiMax = Int.min
+    private(set) var lastRSSI: Int?
+    private(set) var lastAntenna: Int?
+    private(set) var lastChannel: Int?
+    private(set) var lastPhase: Int?
+    private(set) var lastPolarization: Int?
+
+    var hasSamples: Bool { sampleCount > 0 }
+
+    mutating func add(_ sample: SignalSample) {
+        sampleCount += 1
+        rssiMean += (Double(sample.rssi) - rssiMean) / Double(sampleCount)
+        rssiMax = max(rssiMax, sample.rssi)
+        lastRSSI = sample.rssi
+        lastAntenna = sample.antenna
+        lastChannel = sample.channel
+        lastPhase = sample.phase
+        lastPolarization = sample.polarization
+    }
+}
@@ -0,0 +1,291 @@
+//
+//  SimulatedScanner.swift
+//  RFID_ios
+//
+//  Created on 2025/05/11.
+//
+//  実機（SP1）の代わりに読取イベントを生成する仮想スキャナ
+//    • タグ母集団（件数 / 距離 / 向きによる損失）をモデル化
+//    • 読取出力(dBm)・Q値・セッションフラグで読取確率と重複を変える
+//    • 一定間隔のバースト（BLE 通知相当）で [CapturedRead] を渡す
+//  仮想時間で回せるので、10 万件規模の負荷試験や設定比較を実時間より速く行える
+//  SDK には依存しない（ScannerManager 側で取り込み経路に接続する）
+//
+
+import Foundation
+
+// MARK: - Settings -----------------------------------------------------------
+
+/// RFIDScannerScan のうち読取に効く項目だけを写したもの
+struct SimulatedScanSettings: Equatable {
+    enum Session: Equatable {
+        /// 毎ラウンド応答する（同じタグを何度も読む）
+        case s0
+        /// 読取後 persistence 秒は応答しない
+        case s1
+        /// 読取後はインベントリをやり直すまで応答しない
+        case s2
+        case s3
+    }
+
+    /// 読取出力 (dBm, 4〜30)
+    var powerLevelRead = 30
+    /// Q値 (0〜7)。1 ラウンドのスロット数は 2^Q（adaptiveQ 時は初期値）
+    var qParam = 4
+    /// Gen2 の Q アルゴリズムで衝突 / 空きに応じて Q を 0〜15 で調整する
+    var adaptiveQ = true
+    var session: Session = .s0
+    /// S1 で再応答するまでの時間
+    var s1Persistence: TimeInterval = 2.0
+    /// 読取結果をまとめて通知する間隔（BLE 通知相当）
+    var burstInterval: TimeInterval = 0.02
+}
+
+// MARK: - Population ---------------------------------------------------------
+
+struct SimulatedTag {
+    let uii: Data
+    /// リーダ → タグの伝搬損失 (dB)
+    let pathLoss: Double
+}
+
+struct TagPopulation {
+
+    private(set) var tags: [SimulatedTag]
+
+    var count: Int { tags.count }
+
+    init(tags: [SimulatedTag]) {
+        self.tags = tags
+    }
+
+    /// 指定 UII を 0.3〜maxDistance(m) にランダム配置した母集団
+    init(uiis: [EPC], maxDistance: Double = 6, seed: UInt64 = 1) {
+        var rng = SplitMix64(seed: seed)
+        tags = uiis.map { SimulatedTag(uii: $0.data, pathLoss: TagPopulation.randomPathLoss(maxDistance, &rng)) }
+    }
+
+    /// 96bit の連番 UII を持つ count 件の母集団
+    static func random(count: Int, maxDistance: Double = 6, seed: UInt64 = 1) -> TagPopulation {
+        let uiis = (0..<count).map { i -> EPC in
+            var bytes: [UInt8] = [0x30, 0x00]
+            withUnsafeBytes(of: UInt64(i).bigEndian) { bytes.append(contentsOf: $0) }
+            bytes.append(contentsOf: [0, 0])
+            return EPC(bytes: bytes)!
+        }
+        return TagPopulation(uiis: uiis, maxDistance: maxDistance, seed: seed)
+    }
+
+    /// 920MHz 帯の自由空間損失 + 向き・材質による 0〜10dB の損失
+    private static func randomPathLoss(_ maxDistance: Double, _ rng: inout SplitMix64) -> Double {
+        let distance = Double.random(in: 0.3...max(maxDistance, 0.3), using: &rng)
+        return 31.7 + 20 * log10(distance) + Double.random(in: 0...10, using: &rng)
+    }
+}
+
+// MARK: - Scanner ------------------------------------------------------------
+
+final class SimulatedScanner: @unchecked Sendable {
+
+    struct Stats: Equatable {
+        var rounds = 0
+        var slots = 0
+        var emptySlots = 0
+        var collidedSlots = 0
+        var reads = 0
+        var bursts = 0
+        /// 1 回以上読めたタグ数
+        var uniqueTags = 0
+        /// 経過した仮想時間
+        var elapsed: TimeInterval = 0
+    }
+
+    /// タグの起動感度 (dBm)
+    static let tagSensitivity = -18.0
+    /// ラウンド毎のフェージング幅 (±dB)
+    static let fadingRange = 3.0
+
+    // スロット所要時間（Gen2 の典型値を丸めたもの）
+    private static let roundOverhead:   TimeInterval = 0.0010
+    private static let emptySlotTime:   TimeInterval = 0.0002
+    private static let collidedSlotTime: TimeInterval = 0.0006
+    private static let successSlotTime: TimeInterval = 0.0015
+    /// Q アルゴリズムの調整幅（Gen2 推奨 0.1〜0.5）
+    private static let qStep = 0.3
+
+    let population: TagPopulation
+    /// start() 中は仮想スキャナのキューから参照するので変更しないこと
+    var settings: SimulatedScanSettings
+
+    private var rng: SplitMix64
+    /// タグ毎の最終読取時刻（仮想時間, 未読は -inf）
+    private var lastRead: [TimeInterval]
+    private var everRead: [Bool]
+    private var clock: TimeInterval = 0
+    /// Q アルゴリズムの浮動小数 Q（Qfp）
+    private var qfp: Double
+    private var nextBurstAt: TimeInterval
+    private var pending: [CapturedRead] = []
+    private var slotCount: [Int32] = []
+    private var slotOwner: [Int] = []
+    private(set) var stats = Stats()
+
+    private let queue: DispatchQueue
+    private let lock = NSLock()
+    private var cancelled = false
+
+    init(population: TagPopulation,
+         settings: SimulatedScanSettings = SimulatedScanSettings(),
+         seed: UInt64 = 1,
+         queue: DispatchQueue = DispatchQueue(label: "rfid.scan.simulator", qos: .userInitiated)) {
+        self.population = population
+        self.settings = settings
+        self.rng = SplitMix64(seed: seed)
+        self.lastRead = Array(repeating: -.infinity, count: population.count)
+        self.everRead = Array(repeating: false, count: population.count)
+        self.nextBurstAt = settings.burstInterval
+        self.qfp = Double(min(max(settings.qParam, 0), 7))
+        self.queue = queue
+    }
+
+    /// セッションフラグを A に戻す（読取停止 → 再開に相当）
+    func resetInventory() {
+        for i in lastRead.indices { lastRead[i] = -.infinity }
+    }
+
+    // MARK: Virtual time
+    /// 仮想時間で duration 秒分のインベントリを回す（待ち合わせなし）
+    @discardableResult
+    func run(duration: TimeInterval, deliver: ([CapturedRead]) -> Void) -> Stats {
+        let end = clock + duration
+        while clock < end {
+            runRound(deliver)
+        }
+        flushBurst(deliver)
+        stats.elapsed = clock
+        return stats
+    }
+
+    // MARK: Realtime
+    /// 実時間に合わせてバーストを通知する（SDK の受信コールバック相当）
+    func start(deliver: @escaping ([CapturedRead]) -> Void) {
+        lock.lock()
+        cancelled = false
+        lock.unlock()
+        queue.async { [self] in
+            let origin = DispatchTime.now().uptimeNanoseconds
+            let base = clock
+            while !isCancelled {
+                run(duration: settings.burstInterval, deliver: deliver)
+                let due = origin + UInt64((clock - base) * 1e9)
+                let now = DispatchTime.now().uptimeNanoseconds
+                if due > now { Thread.sleep(forTimeInterval: Double(due - now) / 1e9) }
+            }
+        }
+    }
+
+    func stop() {
+        lock.lock()
+        cancelled = true
+        lock.unlock()
+    }
+
+    private var isCancelled: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return cancelled
+    }
+
+    // MARK: Inventory round
+    /// フレームドスロット ALOHA 1 ラウンド分
+    private func runRound(_ deliver: ([CapturedRead]) -> Void) {
+        let q = settings.adaptiveQ ? Int(qfp.rounded()) : min(max(settings.qParam, 0), 7)
+        let slots = 1 << q
+        if slotCount.count != slots {
+            slotCount = Array(repeating: 0, count: slots)
+            slotOwner = Array(repeating: 0, count: slots)
+        } else {
+            for i in 0..<slots { slotCount[i] = 0 }
+        }
+
+        // 起動電力が足りて、フラグが A のタグだけがスロットを選ぶ
+        let power = Double(settings.powerLevelRead)
+        let fading = SimulatedScanner.fadingRange
+        for (i, tag) in population.tags.enumerated() where isResponsive(i) {
+            let margin = power - tag.pathLoss - SimulatedScanner.tagSensitivity
+            guard margin + Double.random(in: -fading...fading, using: &rng) >= 0 else { continue }
+            let slot = Int(rng.next() & UInt64(slots - 1))
+            slotCount[slot] += 1
+            slotOwner[slot] = i
+        }
+
+        clock += SimulatedScanner.roundOverhead
+        stats.rounds += 1
+        stats.slots += slots
+        for slot in 0..<slots {
+            switch slotCount[slot] {
+            case 0:
+                stats.emptySlots += 1
+                clock += SimulatedScanner.emptySlotTime
+                qfp = max(0, qfp - SimulatedScanner.qStep)
+            case 1:
+                clock += SimulatedScanner.successSlotTime
+                singulate(slotOwner[slot], power: power)
+            default:
+                stats.collidedSlots += 1
+                clock += SimulatedScanner.collidedSlotTime
+                qfp = min(15, qfp + SimulatedScanner.qStep)
+            }
+            // 大きな Q のラウンドは長いので、スロット単位でバースト境界を見る
+            while clock >= nextBurstAt {
+                flushBurst(deliver)
+                nextBurstAt += settings.burstInterval
+            }
+        }
+    }
+
+    private func isResponsive(_ index: Int) -> Bool {
+        switch settings.session {
+        case .s0:       return true
+        case .s1:       return clock - lastRead[index] >= settings.s1Persistence
+        case .s2, .s3:  return lastRead[index] == -.infinity
+        }
+    }
+
+    private func singulate(_ index: Int, power: Double) {
+        let tag = population.tags[index]
+        lastRead[index] = clock
+        if !everRead[index] {
+            everRead[index] = true
+            stats.uniqueTags += 1
+        }
+        stats.reads += 1
+        // 後方散乱の受信強度 ≒ 出力 - 往復損失 - タグ変調損失
+        let rssi = power - 2 * tag.pathLoss - 5 + Double.random(in: -2...2, using: &rng)
+        pending.append(CapturedRead(uii: tag.uii, pc: 0x3000, rssi: Int(rssi.rounded())))
+    }
+
+    private func flushBurst(_ deliver: ([CapturedRead]) -> Void) {
+        guard !pending.isEmpty else { return }
+        stats.bursts += 1
+        deliver(pending)
+        pending.removeAll(keepingCapacity: true)
+    }
+}
+
+// MARK: - RNG ----------------------------------------------------------------
+
+/// 再現性のある乱数（シード固定で同じ読取列になる）
+struct SplitMix64: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) { state = seed }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  TagStore.swift
+//  RFID_ios
+//
+//  Created on 2025/05/07.
+//
+//  読取タグの重複排除ストア
+//    • ハッシュ索引 + 挿入順配列で contains / insert を O(1) に
+//    • タグ毎に初回/最終読取時刻・読取回数・電波統計を保持
+//
+
+import Foundation
+
+/// 1 タグ分の読取記録
+struct TagRecord {
+    let uii: EPC
+    let firstSeen: Date
+    var lastSeen: Date
+    var readCount: Int
+    var signal = SignalStats()
+
+    /// 初回〜最終読取間の平均読取レート（回/秒）
+    var readsPerSecond: Double {
+        let span = lastSeen.timeIntervalSince(firstSeen)
+        return span > 0 ? Double(readCount) / span : 0
+    }
+}
+
+/// 挿入順を保ったまま O(1) で重複排除するタグストア
+struct TagStore {
+
+    // MARK: - Storage ------------------------------------------------------
+    /// UII → records のインデックス
+    private var index: [EPC: Int] = [:]
+    /// 初回読取順に並んだ記録
+    private(set) var records: [TagRecord] = []
+
+    init(minimumCapacity: Int = 0) {
+        index.reserveCapacity(minimumCapacity)
+        records.reserveCapacity(minimumCapacity)
+    }
+
+    // MARK: - Query --------------------------------------------------------
+    var count: Int { records.count }
+    var isEmpty: Bool { records.isEmpty }
+
+    /// 初回読取順の UII 一覧
+    var uiis: [EPC] { records.map(\.uii) }
+
+    func contains(_ uii: EPC) -> Bool { index[uii] != nil }
+
+    func record(for uii: EPC) -> TagRecord? {
+        guard let i = index[uii] else { return nil }
+        return records[i]
+    }
+
+    // MARK: - Update -------------------------------------------------------
+    /// 読取を 1 件記録する。新規タグなら true を返す
+    @discardableResult
+    mutating func insert(_ uii: EPC, at time: Date = Date(), signal: SignalSample? = nil) -> Bool {
+        if let i = index[uii] {
+            records[i].lastSeen = time
+            records[i].readCount += 1
+            if let signal { records[i].signal.add(signal) }
+            return false
+        }
+        var record = TagRecord(uii: uii, firstSeen: time, lastSeen: time, readCount: 1)
+        if let signal { record.signal.add(signal) }
+        index[uii] = records.count
+        records.append(record)
+        return true
+    }
+
+    /// まとめて記録し、新規タグだけを読取順で返す
+    @discardableResult
+    mutating func insert<S: Sequence>(contentsOf uiis: S, at time: Date = Date()) -> [EPC]
+    where S.Element == EPC {
+        var added: [EPC] = []
+        for uii in uiis where insert(uii, at: time) {
+            added.append(uii)
+        }
+        return added
+    }
+
+    mutating func removeAll(keepingCapacity: Bool = true) {
+        index.removeAll(keepingCapacity: keepingCapacity)
+        records.removeAll(keepingCapacity: keepingCapacity)
+    }
+}
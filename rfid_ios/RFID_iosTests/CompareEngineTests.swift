@@ -0,0 +1,74 @@
+//
+//  CompareEngineTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/22.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class CompareEngineTests: XCTestCase {
+
+    private func uii(_ i: Int) -> EPC { EPC(hex: String(format: "E2801170000002000000%04lX", i))! }
+
+    func testConsumeUpdatesMembershipAndCounts() {
+        let engine = CompareEngine()
+        engine.loadMaster((0..<10).map(uii))
+
+        let first = engine.consume([uii(3), uii(100), uii(3), uii(7)])
+        XCTAssertEqual(first, [uii(3), uii(7)])
+        // 既に読めたタグは 2 回目以降は一致として返さない
+        XCTAssertEqual(engine.consume([uii(3), uii(101)]), [])
+
+        XCTAssertEqual(engine.counts, CompareCounts(master: 10, actual: 4, matched: 2, uncounted: 8, outer: 2))
+        XCTAssertEqual(engine.uncounted, [0, 1, 2, 4, 5, 6, 8, 9].map(uii))
+        XCTAssertEqual(engine.outer, [uii(100), uii(101)])
+        XCTAssertTrue(engine.isMatched(uii(7)))
+        XCTAssertFalse(engine.isMatched(uii(8)))
+    }
+
+    /// 一覧を読んだ後（詰めた後）に読めたタグも正しく外れること
+    func testUncountedStaysOrderedAcrossCompaction() {
+        let engine = CompareEngine()
+        engine.loadMaster((0..<100).map(uii).shuffled())
+        var expected = (0..<100).map(uii)
+
+        for round in 0..<10 {
+            let picked = (0..<5).map { uii(round * 10 + $0 * 2) }
+            engine.consume(picked)
+            expected.removeAll { picked.contains($0) }
+            XCTAssertEqual(engine.uncounted, expected)
+        }
+        XCTAssertEqual(engine.counts.uncounted, 50)
+    }
+
+    /// マスター読込み前に読めていたタグも、読込み時に一致として返す
+    func testLoadMasterAfterScan() {
+        let engine = CompareEngine()
+        engine.consume([uii(1), uii(2), uii(50)])
+        let matched = engine.loadMaster((0..<10).map(uii))
+
+        XCTAssertEqual(Set(matched), [uii(1), uii(2)])
+        XCTAssertEqual(engine.counts, CompareCounts(master: 10, actual: 3, matched: 2, uncounted: 8, outer: 1))
+
+        engine.resetScan()
+        XCTAssertEqual(engine.counts, CompareCounts(master: 10, actual: 0, matched: 0, uncounted: 10, outer: 0))
+        XCTAssertEqual(engine.uncounted.count, 10)
+    }
+
+    /// ページ毎に届くマスターを足しても、一括読込みと同じ結果になること
+    func testAddMasterIncrementally() {
+        let engine = CompareEngine()
+        engine.loadMaster([])
+        engine.consume([uii(5), uii(40), uii(200)])
+
+        XCTAssertEqual(engine.addMaster((30..<60).map(uii)), [uii(40)])
+        XCTAssertEqual(engine.addMaster((0..<30).map(uii) + [uii(40)]), [uii(5)])
+        engine.consume([uii(10)])
+
+        XCTAssertEqual(engine.counts, CompareCounts(master: 60, actual: 4, matched: 3, uncounted: 57, outer: 1))
+        XCTAssertEqual(engine.uncounted, (0..<60).filter { ![5, 10, 40].contains($0) }.map(uii))
+        XCTAssertEqual(engine.outer, [uii(200)])
+    }
+}
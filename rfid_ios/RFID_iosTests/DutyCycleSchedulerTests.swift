@@ -0,0 +1,71 @@
+//
+//  DutyCycleSchedulerTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/17.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class DutyCycleSchedulerTests: XCTestCase {
+
+    func testReadsContinuouslyWhileDiscovering() {
+        let scheduler = DutyCycleScheduler(fullPower: 30)
+        let step = scheduler.burstCompleted(newUniqueTags: 200, duration: 4, battery: .over40)
+
+        XCTAssertEqual(step.idle, 0)
+        XCTAssertEqual(step.readPower, 30)
+        XCTAssertEqual(step.powerSave, .off)
+    }
+
+    func testBacksOffAndLowersPowerWhenSaturated() {
+        let policy = DutyCyclePolicy()
+        let scheduler = DutyCycleScheduler(policy: policy, fullPower: 30)
+        var idles: [TimeInterval] = []
+        var powers: [Int] = []
+        for _ in 0..<8 {
+            let step = scheduler.burstCompleted(newUniqueTags: 0, duration: 4, battery: nil)
+            idles.append(step.idle)
+            powers.append(step.readPower)
+        }
+
+        XCTAssertEqual(Array(idles.prefix(4)), [1, 2, 4, 8])
+        XCTAssertEqual(idles.last, policy.maxIdle)
+        XCTAssertEqual(Array(powers.prefix(3)), [26, 22, 18])
+        XCTAssertEqual(powers.last, policy.minPower)
+    }
+
+    func testReturnsToFullPowerOnNewShelf() {
+        let scheduler = DutyCycleScheduler(fullPower: 30)
+        for _ in 0..<5 { scheduler.burstCompleted(newUniqueTags: 0, duration: 4, battery: nil) }
+        let step = scheduler.burstCompleted(newUniqueTags: 100, duration: 4, battery: nil)
+
+        XCTAssertEqual(step.idle, 0)
+        XCTAssertEqual(step.readPower, 30)
+    }
+
+    func testPowerSaveFollowsBattery() {
+        let scheduler = DutyCycleScheduler(fullPower: 30)
+        XCTAssertEqual(scheduler.burstCompleted(newUniqueTags: 10, duration: 4, battery: .under40).powerSave, .mode1)
+        XCTAssertEqual(scheduler.burstCompleted(newUniqueTags: 10, duration: 4, battery: nil).powerSave, .mode1)
+        XCTAssertEqual(scheduler.burstCompleted(newUniqueTags: 10, duration: 4, battery: .under10).powerSave, .mode2)
+    }
+
+    func testReportRatesPerBatteryBand() {
+        var report = DutyCycleReport(policy: DutyCyclePolicy())
+        report.record(band: .over40, at: 0)
+        report.uniqueTags = 600
+        report.record(band: .under40, at: 1800)
+        report.record(band: .under40, at: 2000)
+        report.uniqueTags = 700
+        report.duration = 3600
+        report.hostBatteryStart = 0.9
+        report.hostBatteryEnd = 0.8
+
+        XCTAssertEqual(report.scannerBattery.count, 2)
+        XCTAssertEqual(report.tagsPerHourByBand[.over40] ?? 0, 1200, accuracy: 0.001)
+        XCTAssertEqual(report.tagsPerHourByBand[.under40] ?? 0, 200, accuracy: 0.001)
+        XCTAssertEqual(report.tagsPerHostPercent ?? 0, 70, accuracy: 0.5)
+    }
+}
@@ -0,0 +1,39 @@
+//
+//  EPCTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/07.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class EPCTests: XCTestCase {
+
+    func testHexRoundTrip() {
+        let epc96  = "3000E2801160600002090A1B"
+        let epc128 = "E28011606000020900FF00AA5566CCDD"
+        XCTAssertEqual(EPC(hex: epc96)?.hex, epc96)
+        XCTAssertEqual(EPC(hex: epc128)?.hex, epc128)
+        XCTAssertEqual(EPC(hex: epc96.lowercased()), EPC(hex: epc96))
+        XCTAssertEqual(EPC(hex: epc96)?.count, 12)
+    }
+
+    func testBytesMatchHex() {
+        let bytes: [UInt8] = [0x30, 0x00, 0xE2, 0x80, 0x11, 0x60, 0x60, 0x00, 0x02, 0x09, 0x0A, 0x1B]
+        let epc = EPC(data: Data(bytes))
+        XCTAssertEqual(epc?.bytes, bytes)
+        XCTAssertEqual(epc, EPC(hex: "3000E2801160600002090A1B"))
+    }
+
+    func testRejectsInvalidInput() {
+        XCTAssertNil(EPC(hex: "ABC"))
+        XCTAssertNil(EPC(hex: "ZZ"))
+        XCTAssertNil(EPC(bytes: [UInt8](repeating: 0, count: EPC.maxByteCount + 1)))
+    }
+
+    /// 長さだけ異なる UII は別物として扱う
+    func testLengthIsPartOfIdentity() {
+        XCTAssertNotEqual(EPC(hex: "AB"), EPC(hex: "AB00"))
+    }
+}
@@ -0,0 +1,73 @@
+//
+//  HotPathMetricsTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/18.
+//
+
+import XCTest
+@testable import RFID_ios
+
+private struct FakeRead: RawTagRead {
+    let uiiData: Data?
+    init(_ hex: String) { uiiData = EPC(hex: hex)?.data }
+}
+
+final class HotPathMetricsTests: XCTestCase {
+
+    func testHistogramBucketsAndPercentiles() {
+        var histogram = LatencyHistogram()
+        for micros in [10, 60, 60, 400, 3_000, 3_000, 3_000, 3_000, 40_000, 9_000_000] {
+            histogram.record(micros: micros)
+        }
+
+        XCTAssertEqual(histogram.count, 10)
+        XCTAssertEqual(histogram.maxMicros, 9_000_000)
+        XCTAssertEqual(histogram.percentileMicros(0.1), 50)
+        XCTAssertEqual(histogram.percentileMicros(0.5), 5_000)
+        XCTAssertEqual(histogram.percentileMicros(0.9), 50_000)
+        // 超過バケットは最大値
+        XCTAssertEqual(histogram.percentileMicros(1), 9_000_000)
+    }
+
+    func testBucketUpperBoundIsInclusive() {
+        var histogram = LatencyHistogram()
+        histogram.record(micros: 1_000)
+        XCTAssertEqual(histogram.percentileMicros(0.5), 1_000)
+    }
+
+    func testSnapshotRoundTripsThroughJSON() throws {
+        let metrics = HotPathMetrics()
+        metrics.record(.matchToPersist, seconds: 0.120)
+        metrics.increment(.persistRequests, by: 3)
+
+        let data = try metrics.exportJSON()
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .iso8601
+        let snapshot = try decoder.decode(HotPathMetrics.Snapshot.self, from: data)
+
+        XCTAssertEqual(snapshot.counter(.persistRequests), 3)
+        XCTAssertEqual(snapshot.histogram(.matchToPersist).count, 1)
+        XCTAssertEqual(snapshot.histogram(.matchToPersist).percentileMicros(0.5), 120_000)
+
+        metrics.reset()
+        XCTAssertEqual(metrics.snapshot().counter(.persistRequests), 0)
+    }
+
+    /// 取り込みステージの区間をテストから予算と比べられること
+    func testIngestRecordsCallbackToDedup() {
+        let metrics = HotPathMetrics()
+        let pipeline = ScanIngestPipeline<FakeRead>(capacity: 64, metrics: metrics)
+        for i in 0..<20 {
+            pipeline.push((0..<50).map { FakeRead(String(format: "%04lX", i * 50 + $0)) })
+        }
+        pipeline.waitUntilIdle()
+
+        let snapshot = metrics.snapshot()
+        let histogram = snapshot.histogram(.callbackToDedup)
+        XCTAssertEqual(snapshot.counter(.sdkCallbacks), 20)
+        XCTAssertEqual(snapshot.counter(.readsDeduped), 1_000)
+        XCTAssertEqual(histogram.count, 20)
+        XCTAssertLessThan(histogram.percentileMicros(0.95), 250_000)
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  HuntListTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/21.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class HuntListTests: XCTestCase {
+
+    private func uii(_ i: Int) -> EPC { EPC(hex: String(format: "E2801170000002000000%04lX", i))! }
+
+    func testFoundOncePerTarget() {
+        let hunt = HuntList(targets: (0..<5).map(uii))
+        var found: [EPC] = []
+        hunt.onFound = { found.append($0) }
+
+        for t in 0..<10 { hunt.ingest(uii: uii(2).data, rssi: -60, at: Double(t) * 0.01) }
+        XCTAssertFalse(hunt.ingest(uii: uii(99).data, rssi: -40, at: 0.2))
+
+        XCTAssertEqual(found, [uii(2)])
+        XCTAssertEqual(hunt.foundCount, 1)
+        XCTAssertEqual(hunt.ignoredReads, 1)
+        XCTAssertEqual(Set(hunt.undetected()), Set([0, 1, 3, 4].map(uii)))
+    }
+
+    /// 1 件ずつ位置を直した結果が全件ソートと一致すること
+    func testIncrementalOrderMatchesFullSort() {
+        let targets = (0..<200).map(uii)
+        let hunt = HuntList(targets: targets, decayPerSecond: 6)
+        var rng = SystemRandomNumberGenerator()
+        var t = 0.0
+        for _ in 0..<5_000 {
+            t += 0.002
+            let i = Int.random(in: 0..<targets.count, using: &rng)
+            hunt.ingest(uii: targets[i].data, rssi: Int.random(in: -80 ... -30, using: &rng), at: t)
+        }
+
+        let ranked = hunt.ranked(at: t)
+        let keys = ranked.map { ($0.rssi ?? 0) + 6 * ($0.lastSeen ?? 0) }
+        XCTAssertEqual(keys, keys.sorted(by: >))
+        XCTAssertEqual(ranked.count, hunt.foundCount)
+    }
+
+    /// 読めなくなったタグは近さが下がり、後から強く読めたタグが上に来る
+    func testStaleTagSinks() {
+        let hunt = HuntList(targets: [uii(1), uii(2)],
+                            calibration: LocateCalibration(floorRSSI: -80, ceilingRSSI: -40),
+                            decayPerSecond: 6, staleAfter: 3)
+        for k in 0..<20 { hunt.ingest(uii: uii(1).data, rssi: -45, at: Double(k) * 0.01) }
+        for k in 0..<20 { hunt.ingest(uii: uii(2).data, rssi: -55, at: 5 + Double(k) * 0.01) }
+
+        let ranked = hunt.ranked(at: 5.2)
+        XCTAssertEqual(ranked.map(\.uii), [uii(2), uii(1)])
+        XCTAssertTrue(ranked[1].isLost)
+        XCTAssertLessThan(ranked[1].proximity, ranked[0].proximity)
+    }
+
+    func testTrendFollowsApproach() {
+        let hunt = HuntList(targets: [uii(1)])
+        var t = 0.0
+        for _ in 0..<200 { t += 0.01; hunt.ingest(uii: uii(1).data, rssi: -70, at: t) }
+        for step in 0..<50 { t += 0.01; hunt.ingest(uii: uii(1).data, rssi: -70 + step / 2, at: t) }
+        XCTAssertEqual(hunt.ranked(at: t).first?.trend, .approaching)
+    }
+}
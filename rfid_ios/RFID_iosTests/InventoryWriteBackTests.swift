@@ -0,0 +1,164 @@
+//
+//  InventoryWriteBackTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/23.
+//
+
+import XCTest
+@testable import RFID_ios
+
+@MainActor
+final class InventoryWriteBackTests: XCTestCase {
+
+    private struct Offline: Error {}
+
+    /// 送られたバッチを記録する偽の送信先（先頭 failures 回は失敗）
+    private final class FakeServer {
+        var batches: [[Int]] = []
+        var failures = 0
+        func send(_ batch: [Int]) throws {
+            if failures > 0 { failures -= 1; throw Offline() }
+            batches.append(batch)
+        }
+    }
+
+    private func makeWriteBack(_ server: FakeServer, policy: WriteBackPolicy) -> InventoryWriteBack<Int> {
+        InventoryWriteBack(policy: policy) { batch in
+            try await MainActor.run { try server.send(batch) }
+        }
+    }
+
+    func testSendsEachKeyOnceInBatches() async {
+        let server = FakeServer()
+        var policy = WriteBackPolicy()
+        policy.maxBatchSize = 4
+        policy.flushInterval = 60
+        let writeBack = makeWriteBack(server, policy: policy)
+        var committed: [Int] = []
+        writeBack.onCommitted = { committed += $0 }
+
+        // 照合が再発火しても同じキーは受け付けない
+        XCTAssertEqual(writeBack.enqueue([1, 2, 3]), 3)
+        XCTAssertEqual(writeBack.enqueue([2, 3]), 0)
+        XCTAssertEqual(writeBack.enqueue([4, 5, 6, 7, 8, 9]), 6)
+        await writeBack.flush()
+        XCTAssertEqual(writeBack.enqueue([1, 9]), 0)
+
+        XCTAssertEqual(server.batches.flatMap { $0 }.sorted(), Array(1...9))
+        XCTAssertTrue(server.batches.allSatisfy { $0.count <= 4 })
+        XCTAssertEqual(committed.sorted(), Array(1...9))
+        XCTAssertEqual(writeBack.stats.duplicates, 4)
+        XCTAssertEqual(writeBack.stats.committed, 9)
+        XCTAssertTrue(writeBack.isIdle)
+    }
+
+    func testFlushesAfterInterval() async throws {
+        let server = FakeServer()
+        var policy = WriteBackPolicy()
+        policy.flushInterval = 0.02
+        let writeBack = makeWriteBack(server, policy: policy)
+
+        writeBack.enqueue([1, 2])
+        XCTAssertTrue(server.batches.isEmpty)
+        try await Task.sleep(nanoseconds: 200_000_000)
+        XCTAssertEqual(server.batches, [[1, 2]])
+    }
+
+    func testRetriesWithBackoffThenGivesUp() async {
+        let server = FakeServer()
+        var policy = WriteBackPolicy()
+        policy.maxAttempts = 3
+        policy.initialRetryDelay = 0.001
+        let writeBack = makeWriteBack(server, policy: policy)
+
+        // 2 回失敗して 3 回目で成功
+        server.failures = 2
+        writeBack.enqueue([1])
+        await writeBack.flush()
+        XCTAssertEqual(server.batches, [[1]])
+        XCTAssertEqual(writeBack.stats.retries, 2)
+
+        // 使い切ったら onFailed。キーは送り直し待ちに残り、重複としては受けない
+        server.failures = 3
+        var failed: [Int] = []
+        writeBack.onFailed = { keys, _ in failed += keys }
+        writeBack.enqueue([2])
+        await writeBack.flush()
+        XCTAssertEqual(failed, [2])
+        XCTAssertEqual(writeBack.stats.failed, 1)
+        XCTAssertEqual(writeBack.pendingCount, 1)
+        XCTAssertFalse(writeBack.isIdle)
+        XCTAssertEqual(writeBack.enqueue([2]), 0)
+
+        // 明示の flush では送り直し待ちもすぐに送る
+        await writeBack.flush()
+        XCTAssertEqual(server.batches, [[1], [2]])
+        XCTAssertTrue(writeBack.isIdle)
+
+        XCTAssertEqual(policy.retryDelay(attempt: 1), 0.001)
+        XCTAssertEqual(policy.retryDelay(attempt: 3), 0.004)
+    }
+
+    /// 再試行を使い切ったバッチも、requeueDelay 後に自動で送り直されて反映される
+    func testExhaustedBatchIsEventuallyCommitted() async throws {
+        let server = FakeServer()
+        var policy = WriteBackPolicy()
+        policy.maxAttempts = 2
+        policy.initialRetryDelay = 0.001
+        policy.requeueDelay = 0.05
+        let writeBack = makeWriteBack(server, policy: policy)
+        var committed: [Int] = []
+        var failures = 0
+        writeBack.onCommitted = { committed += $0 }
+        writeBack.onFailed = { _, _ in failures += 1 }
+
+        // 1 回目のバッチは 2 回とも失敗、2 回目のバッチの 1 回目も失敗
+        server.failures = 3
+        writeBack.enqueue([1, 2, 3])
+        await writeBack.flush()
+        XCTAssertEqual(failures, 1)
+        XCTAssertTrue(committed.isEmpty)
+        XCTAssertEqual(writeBack.pendingCount, 3)
+
+        try await Task.sleep(nanoseconds: 300_000_000)
+        XCTAssertEqual(committed.sorted(), [1, 2, 3])
+        XCTAssertEqual(server.batches, [[1, 2, 3]])
+        XCTAssertEqual(writeBack.stats.committed, 3)
+        XCTAssertTrue(writeBack.isIdle)
+    }
+
+    func testResetDropsParkedKeys() async throws {
+        let server = FakeServer()
+        var policy = WriteBackPolicy()
+        policy.maxAttempts = 1
+        policy.requeueDelay = 0.05
+        let writeBack = makeWriteBack(server, policy: policy)
+
+        server.failures = 1
+        writeBack.enqueue([1])
+        await writeBack.flush()
+        XCTAssertEqual(writeBack.pendingCount, 1)
+        await writeBack.reset()
+        try await Task.sleep(nanoseconds: 200_000_000)
+        XCTAssertTrue(server.batches.isEmpty)
+        XCTAssertTrue(writeBack.isIdle)
+    }
+
+    func testResetDropsPendingAndForgetsKeys() async {
+        let server = FakeServer()
+        var policy = WriteBackPolicy()
+        policy.flushInterval = 60
+        let writeBack = makeWriteBack(server, policy: policy)
+
+        writeBack.enqueue([1, 2, 3])
+        await writeBack.reset()
+        XCTAssertEqual(writeBack.pendingCount, 0)
+        await writeBack.flush()
+        XCTAssertTrue(server.batches.isEmpty)
+
+        XCTAssertEqual(writeBack.enqueue([1]), 1)
+        await writeBack.flush()
+        XCTAssertEqual(server.batches, [[1]])
+    }
+}
@@ -0,0 +1,73 @@
+//
+//  ItemJoinDecoderTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/25.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class ItemJoinDecoderTests: XCTestCase {
+
+    private func row(_ id: String, master: String, target: String = "clinic", inventoried: String = "false") -> String {
+        """
+        {"id":"\(id)","created_at":"c","updated_at":"u","rfid":"E280\(id)","inventory_master_id":"\(master)",
+         "user_id":null,"is_inventoried":\(inventoried),
+         "inventory_masters":{"id":"\(master)","created_at":"c","updated_at":"u","col_1":"名前\(master)",
+          "col_2":null,"product_code":"PC-\(master)","target":"\(target)"}}
+        """
+    }
+
+    func testDecodesRowsAndDedupsMasters() throws {
+        let json = "[" + [row("1", master: "a"), row("2", master: "b", inventoried: "true"),
+                          row("3", master: "a", inventoried: "null")].joined(separator: ",") + "]"
+        let payload = try ItemJoinDecoder.decode(Data(json.utf8))
+
+        XCTAssertEqual(payload.items.map(\.id), ["1", "2", "3"])
+        XCTAssertEqual(payload.items.map(\.isInventoried), [false, true, false])
+        XCTAssertEqual(payload.items[0].rfid, "E2801")
+        XCTAssertNil(payload.items[0].userId)
+        XCTAssertEqual(payload.skipped, 0)
+
+        XCTAssertEqual(Set(payload.masters.keys), ["a", "b"])
+        let master = try XCTUnwrap(payload.masters["a"])
+        XCTAssertEqual(master.col1, "名前a")
+        XCTAssertEqual(master.productCode, "PC-a")
+        XCTAssertNil(master.col3)
+    }
+
+    /// 必須列が欠けた行は捨て、不明な target は clinic 扱い
+    func testSkipsBrokenRowsAndDefaultsUnknownTarget() throws {
+        let json = """
+        [\(row("1", master: "a", target: "unknown_shop")),
+         {"id":"2","rfid":"E2802"},
+         {"id":"3","created_at":"c","updated_at":"u","rfid":"E2803","inventory_master_id":"z"}]
+        """
+        let payload = try ItemJoinDecoder.decode(Data(json.utf8))
+
+        XCTAssertEqual(payload.items.map(\.id), ["1", "3"])
+        XCTAssertEqual(payload.skipped, 1)
+        XCTAssertEqual(payload.masters["a"]?.target, .clinic)
+        XCTAssertNil(payload.masters["z"])
+        XCTAssertEqual(payload.lastRow, ItemJoinRowKey(id: "3", updatedAt: "u"))
+    }
+
+    /// 最後の行を捨てても、その行の id / updated_at はカーソル用に残る
+    func testLastRowKeepsKeyOfSkippedRow() throws {
+        let json = """
+        [\(row("1", master: "a")),
+         {"id":"2","updated_at":"u2","rfid":"E2802"}]
+        """
+        let payload = try ItemJoinDecoder.decode(Data(json.utf8))
+
+        XCTAssertEqual(payload.items.map(\.id), ["1"])
+        XCTAssertEqual(payload.lastRow, ItemJoinRowKey(id: "2", updatedAt: "u2"))
+    }
+
+    func testEmptyArrayAndInvalidJSON() async throws {
+        let empty = try await ItemJoinDecoder.decodeDetached(Data("[]".utf8))
+        XCTAssertTrue(empty.items.isEmpty)
+        XCTAssertThrowsError(try ItemJoinDecoder.decode(Data("{\"message\":\"error\"}".utf8)))
+    }
+}
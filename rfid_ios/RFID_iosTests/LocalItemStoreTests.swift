@@ -0,0 +1,148 @@
+//
+//  LocalItemStoreTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/24.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class LocalItemStoreTests: XCTestCase {
+
+    private func master(_ id: String, target: TargetType, code: String?, updatedAt: String = "2025-05-01T00:00:00+00:00") -> InventoryMaster {
+        InventoryMaster(id: id, createdAt: updatedAt, updatedAt: updatedAt, col1: "商品\(id)", col2: nil, col3: nil,
+                        productCode: code, target: target, userId: nil, productImage: nil)
+    }
+
+    private func item(_ id: String, rfid: String, master: String, inventoried: Bool = false) -> Item {
+        Item(id: id, createdAt: "2025-05-01T00:00:00+00:00", updatedAt: "2025-05-01T00:00:00+00:00", rfid: rfid,
+             inventoryMasterId: master, userId: nil, isInventoried: inventoried)
+    }
+
+    private func makeStore() throws -> LocalItemStore {
+        let store = try LocalItemStore(path: ":memory:")
+        try store.upsert(masters: [
+            master("m1", target: .clinic, code: "ABC-001"),
+            master("m2", target: .clinic, code: "ABC-002"),
+            master("m3", target: .cardShop, code: "X_9%"),
+        ])
+        try store.upsert(items: [
+            item("i1", rfid: "E2801170000002000000000001", master: "m1"),
+            item("i2", rfid: "E2801170000002000000000002", master: "m1"),
+            item("i3", rfid: "E2801170000002000000000003", master: "m2"),
+            item("i4", rfid: "E2801170000002000000000004", master: "m3"),
+        ])
+        return store
+    }
+
+    func testQueriesByTargetRFIDAndProductCode() throws {
+        let store = try makeStore()
+
+        let clinic = try store.items(target: .clinic)
+        XCTAssertEqual(Set(clinic.items.map(\.id)), ["i1", "i2", "i3"])
+        XCTAssertEqual(Set(clinic.masters.keys), ["m1", "m2"])
+
+        let found = try XCTUnwrap(store.item(rfid: "E2801170000002000000000004"))
+        XCTAssertEqual(found.item.id, "i4")
+        XCTAssertEqual(found.master?.target, .cardShop)
+        XCTAssertNil(try store.item(rfid: "E2801170000002000000000099"))
+
+        XCTAssertEqual(try store.masters(productCodeContaining: "abc").map(\.id), ["m1", "m2"])
+        // LIKE のワイルドカードは文字として扱う
+        XCTAssertEqual(try store.masters(productCodeContaining: "_9%").map(\.id), ["m3"])
+        XCTAssertEqual(try store.masters(productCodeContaining: "%").map(\.id), ["m3"])
+    }
+
+    func testLocalWritesAreQueuedAndSurviveServerUpsert() throws {
+        let store = try makeStore()
+        try store.setInventoried(itemIds: ["i1", "i2"], value: true)
+        let registered = try store.insertItem(rfid: "E2801170000002000000000010", inventoryMasterId: "m2")
+
+        // 棚卸し済みは端末だけに書き、送信待ちには登録だけが積まれる
+        let outbox = try store.pendingOutbox()
+        XCTAssertEqual(outbox.map(\.operation), [
+            .insertItem(id: registered.id, rfid: "E2801170000002000000000010", inventoryMasterId: "m2"),
+        ])
+
+        // サーバーの行が届いても端末の棚卸し済みは残す（新しい行は未棚卸しで入る）
+        try store.upsert(items: [item("i1", rfid: "E2801170000002000000000001", master: "m1", inventoried: false),
+                                 item("i9", rfid: "E2801170000002000000000009", master: "m1", inventoried: true)])
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000001")?.item.isInventoried, true)
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000009")?.item.isInventoried, false)
+
+        try store.failOutbox(outbox[0].seq)
+        XCTAssertEqual(try store.pendingOutbox().first?.attempts, 1)
+        for entry in outbox { try store.completeOutbox(entry.seq) }
+        XCTAssertEqual(try store.outboxCount(), 0)
+    }
+
+    /// 読取は対象のセッションに追記され、締めると次の読取から新しいセッションになる
+    func testScansAreAppendedToSessionsPerTarget() throws {
+        let store = try makeStore()
+        XCTAssertNil(try store.openSessionId(target: .clinic))
+        XCTAssertNil(try store.appendScans([], target: .clinic))
+
+        let first = try XCTUnwrap(try store.appendScans(["E2801170000002000000000001", "E28011700000FFFF"], target: .clinic))
+        XCTAssertEqual(try store.appendScans(["E2801170000002000000000002"], target: .clinic), first)
+        let other = try XCTUnwrap(try store.appendScans(["E2801170000002000000000004"], target: .cardShop))
+        XCTAssertNotEqual(first, other)
+        try store.setInventoried(itemIds: ["i1", "i2", "i4"], value: true)
+
+        XCTAssertEqual(try store.closeSession(target: .clinic), first)
+        XCTAssertNil(try store.openSessionId(target: .clinic))
+        // 締めた対象だけ棚卸し済みが戻る
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000001")?.item.isInventoried, false)
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000004")?.item.isInventoried, true)
+        XCTAssertEqual(try store.openSessionId(target: .cardShop), other)
+
+        let next = try XCTUnwrap(try store.appendScans(["E2801170000002000000000003"], target: .clinic))
+        XCTAssertNotEqual(next, first)
+        XCTAssertEqual(try store.closeSession(target: .cardShop, discard: true), other)
+        XCTAssertNil(try store.closeSession(target: .cardShop))
+
+        XCTAssertEqual(try store.pendingOutbox().map(\.operation), [
+            .openSession(id: first, target: TargetType.clinic.rawValue),
+            .appendScans(sessionId: first, rfids: ["E2801170000002000000000001", "E28011700000FFFF"]),
+            .appendScans(sessionId: first, rfids: ["E2801170000002000000000002"]),
+            .openSession(id: other, target: TargetType.cardShop.rawValue),
+            .appendScans(sessionId: other, rfids: ["E2801170000002000000000004"]),
+            .closeSession(id: first, discard: false),
+            .openSession(id: next, target: TargetType.clinic.rawValue),
+            .appendScans(sessionId: next, rfids: ["E2801170000002000000000003"]),
+            .closeSession(id: other, discard: true),
+        ])
+    }
+
+    func testCursorsAndFullReset() throws {
+        let store = try makeStore()
+        XCTAssertNil(try store.cursor(for: .items))
+        let cursor = SyncCursor(updatedAt: "2025-05-02T00:00:00.123+00:00", id: "i9")
+        try store.setCursor(cursor, for: .items)
+        XCTAssertEqual(try store.cursor(for: .items), cursor)
+        XCTAssertNil(try store.cursor(for: .inventoryMasters))
+
+        try store.setInventoried(itemIds: ["i1", "i4"], value: true)
+        try store.resetCursors()
+        XCTAssertNil(try store.cursor(for: .items))
+        XCTAssertEqual(try store.count(.items), 0)
+        XCTAssertEqual(try store.count(.inventoryMasters), 0)
+
+        // 取り直した行には端末の棚卸し済みが戻る（締めた対象の分は戻さない）
+        try store.closeSession(target: .cardShop)
+        try store.upsert(masters: [master("m1", target: .clinic, code: nil), master("m3", target: .cardShop, code: nil)])
+        try store.upsert(items: [
+            item("i1", rfid: "E2801170000002000000000001", master: "m1"),
+            item("i2", rfid: "E2801170000002000000000002", master: "m1"),
+            item("i4", rfid: "E2801170000002000000000004", master: "m3"),
+        ])
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000001")?.item.isInventoried, true)
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000002")?.item.isInventoried, false)
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000004")?.item.isInventoried, false)
+
+        // 戻した後は通常どおり（サーバーの行で棚卸し済みは変わらない）
+        try store.setInventoried(itemIds: ["i1"], value: false)
+        try store.upsert(items: [item("i1", rfid: "E2801170000002000000000001", master: "m1")])
+        XCTAssertEqual(try store.item(rfid: "E2801170000002000000000001")?.item.isInventoried, false)
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  LogTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/19.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class LogTests: XCTestCase {
+
+    private var savedLevel: LogLevel = .debug
+    private var savedEcho = false
+
+    override func setUp() {
+        savedLevel = Log.minimumLevel
+        savedEcho = Log.echoToConsole
+        Log.echoToConsole = false
+        Log.store.removeAll()
+    }
+
+    override func tearDown() {
+        Log.minimumLevel = savedLevel
+        Log.echoToConsole = savedEcho
+    }
+
+    func testDisabledLevelDoesNotEvaluateMessage() {
+        Log.minimumLevel = .warning
+        var evaluated = 0
+        func message() -> String { evaluated += 1; return "expensive" }
+
+        Log.debug(.ingest, message())
+        Log.info(.ingest, message())
+        Log.warning(.ingest, message())
+
+        XCTAssertEqual(evaluated, 1)
+        XCTAssertEqual(Log.store.entries().map(\.level), [.warning])
+    }
+
+    func testStoreKeepsNewestEntries() {
+        let store = LogStore(capacity: 3)
+        for i in 0..<5 {
+            store.append(LogEntry(time: Date(), level: .info, category: .scanner, message: "\(i)"))
+        }
+        XCTAssertEqual(store.entries().map(\.message), ["2", "3", "4"])
+    }
+
+    func testDumpFiltersByLevel() {
+        Log.minimumLevel = .debug
+        Log.info(.compare, "matched 3")
+        Log.error(.sync, "upload failed")
+
+        let dump = Log.dump(minimumLevel: .warning)
+        XCTAssertFalse(dump.contains("matched 3"))
+        XCTAssertTrue(dump.contains("[sync] upload failed"))
+    }
+}
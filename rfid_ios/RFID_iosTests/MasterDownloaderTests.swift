@@ -0,0 +1,137 @@
+//
+//  MasterDownloaderTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/26.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class MasterDownloaderTests: XCTestCase {
+
+    /// id 昇順に並んだ偽のテーブル。範囲とカーソルで切り出して JSON を返す
+    private final class FakeTable: @unchecked Sendable {
+        let ids: [String]
+        private let lock = NSLock()
+        private var inFlight = 0
+        private(set) var maxInFlight = 0
+        private(set) var requests = 0
+        /// 必須列を欠いた行として返す id
+        var broken: Set<String> = []
+
+        init(count: Int) {
+            ids = (0..<count).map { _ in UUID().uuidString.lowercased() }.sorted()
+        }
+
+        func fetch(_ range: MasterIdRange, _ afterId: String?, _ limit: Int) async throws -> Data {
+            lock.lock(); inFlight += 1; requests += 1; maxInFlight = max(maxInFlight, inFlight); lock.unlock()
+            try await Task.sleep(nanoseconds: 1_000_000)
+            lock.lock(); inFlight -= 1; lock.unlock()
+            let page = ids.lazy
+                .filter { $0 >= range.lower && (range.upper.map { up in $0 < up } ?? true) }
+                .filter { id in afterId.map { id > $0 } ?? true }
+                .prefix(limit)
+            let rows = page.map { id in
+                broken.contains(id) ? "{\"id\":\"\(id)\"}" : """
+                {"id":"\(id)","created_at":"c","updated_at":"u","rfid":"E280\(id.prefix(8))","inventory_master_id":"m\(id.first!)",
+                 "inventory_masters":{"id":"m\(id.first!)","created_at":"c","updated_at":"u","col_1":"x","target":"clinic"}}
+                """
+            }
+            return Data(("[" + rows.joined(separator: ",") + "]").utf8)
+        }
+    }
+
+    func testPartitionsCoverIdSpace() {
+        let ranges = MasterIdRange.partitions(4)
+        XCTAssertEqual(ranges.map { $0.lower.prefix(1) }, ["0", "4", "8", "c"])
+        XCTAssertEqual(ranges.last?.upper, nil)
+        XCTAssertEqual(ranges[0].upper, ranges[1].lower)
+        XCTAssertEqual(MasterIdRange.partitions(99).count, 16)
+    }
+
+    @MainActor
+    func testDownloadsEveryRowOnceWithinConcurrencyLimit() async throws {
+        let table = FakeTable(count: 1_234)
+        var policy = MasterDownloadPolicy()
+        policy.pageSize = 50
+        policy.maxConcurrentPages = 3
+        policy.partitions = 8
+        let downloader = MasterDownloader(policy: policy) { try await table.fetch($0, $1, $2) }
+
+        var received: [String] = []
+        var masters: Set<String> = []
+        var lastProgress = MasterDownloadProgress()
+        try await downloader.run(totalRows: table.ids.count, onPage: { page in
+            received += page.items.map(\.id)
+            masters.formUnion(page.masters.keys)
+        }, onProgress: { lastProgress = $0 })
+
+        XCTAssertEqual(received.sorted(), table.ids)
+        XCTAssertEqual(masters.count, Set(table.ids.map { $0.first! }).count)
+        XCTAssertLessThanOrEqual(table.maxInFlight, 3)
+        XCTAssertEqual(lastProgress.rowsLoaded, table.ids.count)
+        XCTAssertEqual(lastProgress.rangesDone, 8)
+        XCTAssertEqual(lastProgress.fraction, 1)
+    }
+
+    @MainActor
+    func testCancellationStopsBetweenPages() async throws {
+        let table = FakeTable(count: 2_000)
+        var policy = MasterDownloadPolicy()
+        policy.pageSize = 20
+        policy.maxConcurrentPages = 2
+        let downloader = MasterDownloader(policy: policy) { try await table.fetch($0, $1, $2) }
+
+        var pages = 0
+        let task = Task { @MainActor in
+            try await downloader.run(onPage: { _ in
+                pages += 1
+                if pages == 3 { withUnsafeCurrentTask { $0?.cancel() } }
+            }, onProgress: { _ in })
+        }
+        do {
+            try await task.value
+            XCTFail("キャンセルされていません")
+        } catch is CancellationError {
+        }
+        XCTAssertLessThan(table.requests, 2_000 / 20)
+    }
+
+    @MainActor
+    func testBrokenLastRowsDoNotEndRange() async throws {
+        let table = FakeTable(count: 300)
+        var policy = MasterDownloadPolicy()
+        policy.pageSize = 10
+        policy.partitions = 1
+        // 先頭のページは丸ごと、以降もページの最後の行を不正にする
+        table.broken = Set(table.ids.prefix(10)).union(stride(from: 19, to: 300, by: 10).map { table.ids[$0] })
+        let downloader = MasterDownloader(policy: policy) { try await table.fetch($0, $1, $2) }
+
+        var received: [String] = []
+        var lastProgress = MasterDownloadProgress()
+        try await downloader.run(onPage: { page in
+            received += page.items.map(\.id)
+        }, onProgress: { lastProgress = $0 })
+
+        XCTAssertEqual(received.sorted(), table.ids.filter { !table.broken.contains($0) })
+        XCTAssertEqual(lastProgress.rowsLoaded, table.ids.count)
+        XCTAssertEqual(lastProgress.rangesDone, 1)
+    }
+
+    @MainActor
+    func testFullPageWithoutLastIdFails() async {
+        var policy = MasterDownloadPolicy()
+        policy.pageSize = 2
+        policy.partitions = 1
+        let downloader = MasterDownloader(policy: policy) { _, _, _ in
+            Data(#"[{"id":"1","rfid":"E2801"},{"rfid":"E2802"}]"#.utf8)
+        }
+        do {
+            try await downloader.run(onPage: { _ in }, onProgress: { _ in })
+            XCTFail("失敗になっていません")
+        } catch {
+            XCTAssertEqual(error as? ItemJoinError, .missingCursor("id"))
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  MasterPrefilterTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/28.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class MasterPrefilterTests: XCTestCase {
+
+    private func uii(_ i: Int) -> EPC { EPC(hex: String(format: "E2801170000002%010lX", i))! }
+
+    func testNoFalseNegativesAndRateNearTarget() {
+        let masters = (0..<50_000).map(uii)
+        let filter = MasterBloomFilter(masters, count: masters.count, falsePositiveRate: 0.01)
+
+        XCTAssertTrue(masters.allSatisfy(filter.mayContain))
+        XCTAssertEqual(filter.insertedCount, 50_000)
+        // 1% なら 1 件あたり約 9.6 bit（2 のべき乗へ切り上げても 2 倍未満）
+        XCTAssertLessThan(filter.memoryBytes, 50_000 * 10 * 2 / 8)
+        XCTAssertLessThan(filter.expectedFalsePositiveRate, 0.01)
+
+        let foreign = (1_000_000..<1_100_000).map(uii)
+        let passed = foreign.filter(filter.mayContain).count
+        XCTAssertLessThan(Double(passed) / Double(foreign.count), 0.02)
+    }
+
+    /// 前段フィルタの有無で突き合わせ結果が変わらないこと
+    func testEngineResultsMatchWithPrefilter() throws {
+        let plain = CompareEngine()
+        let filtered = CompareEngine()
+        filtered.prefilterRate = 0.01
+        let masters = (0..<5_000).map(uii)
+        plain.loadMaster(masters)
+        filtered.loadMaster(masters)
+
+        let reads = (0..<2_000).map { uii($0 * 3) } + (900_000..<905_000).map(uii)
+        XCTAssertEqual(plain.consume(reads), filtered.consume(reads))
+        XCTAssertEqual(plain.counts, filtered.counts)
+        XCTAssertEqual(plain.outer, filtered.outer)
+
+        // ページ毎の追加で想定件数を超えても取りこぼさない
+        let added = (10_000..<20_000).map(uii)
+        filtered.addMaster(added)
+        filtered.consume([uii(15_000), uii(19_999)])
+        XCTAssertTrue(filtered.isMatched(uii(15_000)) && filtered.isMatched(uii(19_999)))
+        XCTAssertEqual(Set(filtered.masterTags), Set(masters + added))
+
+        let report = try XCTUnwrap(filtered.prefilterReport)
+        XCTAssertEqual(report.keys, 15_000)
+        XCTAssertNil(plain.prefilterReport)
+
+        filtered.prefilterRate = nil
+        XCTAssertNil(filtered.prefilterReport)
+    }
+
+    func testReportCountsRejectionsAndFalsePositives() throws {
+        let engine = CompareEngine()
+        engine.prefilterRate = 0.05
+        engine.loadMaster((0..<1_000).map(uii))
+        engine.consume((0..<100).map(uii) + (500_000..<510_000).map(uii))
+
+        let report = try XCTUnwrap(engine.prefilterReport)
+        XCTAssertEqual(report.confirmed, 100)
+        XCTAssertEqual(report.rejected + report.falsePositives, 10_000)
+        XCTAssertLessThan(try XCTUnwrap(report.observedFalsePositiveRate), 0.1)
+        XCTAssertGreaterThan(report.exactSetBytes, report.memoryBytes)
+    }
+}
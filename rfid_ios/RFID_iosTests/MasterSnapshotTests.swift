@@ -0,0 +1,130 @@
+//
+//  MasterSnapshotTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/27.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class MasterSnapshotTests: XCTestCase {
+
+    private func item(_ i: Int, rfid: String, master: String, inventoried: Bool = false) -> Item {
+        Item(id: "item-\(i)", createdAt: "c", updatedAt: "u", rfid: rfid,
+             inventoryMasterId: master, userId: nil, isInventoried: inventoried)
+    }
+
+    private func master(_ id: String, code: String?) -> InventoryMaster {
+        InventoryMaster(id: id, createdAt: "c", updatedAt: "u", col1: "商品\(id)", col2: "説明", col3: nil,
+                        productCode: code, target: .clinic, userId: nil, productImage: nil)
+    }
+
+    func testRoundTripLooksUpInPlace() throws {
+        let items = [
+            item(0, rfid: "E2801170000002000000000A", master: "b", inventoried: true),
+            item(1, rfid: "E28011700000020000000001", master: "a"),
+            item(2, rfid: "3000ABCD", master: "a"),
+            item(3, rfid: "XYZ", master: "a"),              // RFID 不正
+            item(4, rfid: "E28011700000020000000002", master: "missing"),
+        ]
+        let data = MasterSnapshot.build(items: items, masters: ["a": master("a", code: "PC-1"), "b": master("b", code: nil)])
+        let snapshot = try MasterSnapshot(data: data)
+
+        XCTAssertEqual(snapshot.count, 3)
+        XCTAssertEqual(snapshot.masterCount, 2)
+        XCTAssertEqual(Array(snapshot.epcs), Array(snapshot.epcs).sorted())
+
+        let i = try XCTUnwrap(snapshot.index(of: EPC(hex: "E2801170000002000000000A")!))
+        XCTAssertEqual(snapshot.itemId(at: i), "item-0")
+        XCTAssertTrue(snapshot.isInventoried(at: i))
+        XCTAssertEqual(snapshot.master(at: snapshot.masterIndex(at: i)),
+                       MasterSnapshot.Master(id: "b", col1: "商品b", productCode: nil))
+
+        let short = try XCTUnwrap(snapshot.index(of: EPC(hex: "3000ABCD")!))
+        XCTAssertFalse(snapshot.isInventoried(at: short))
+        XCTAssertEqual(snapshot.master(at: snapshot.masterIndex(at: short)).productCode, "PC-1")
+
+        XCTAssertNil(snapshot.index(of: EPC(hex: "E28011700000020000000002")!))
+        XCTAssertNil(snapshot.index(of: EPC(hex: "3000ABCE")!))
+    }
+
+    func testEmptyAndBrokenData() throws {
+        let empty = try MasterSnapshot(data: MasterSnapshot.build(items: [], masters: [:]))
+        XCTAssertEqual(empty.count, 0)
+        XCTAssertNil(empty.index(of: EPC(hex: "E280")!))
+
+        var data = MasterSnapshot.build(items: [item(0, rfid: "E280", master: "a")], masters: ["a": master("a", code: nil)])
+        XCTAssertThrowsError(try MasterSnapshot(data: data.dropLast()))
+        data[4] = 9
+        XCTAssertThrowsError(try MasterSnapshot(data: data)) { error in
+            XCTAssertEqual(error as? MasterSnapshotError, .version(9))
+        }
+    }
+
+    /// 大きさが合っていても、長さ・文字列番号・オフセットが範囲外なら開く時点で失敗にする
+    func testCorruptBodyIsRejected() throws {
+        let items = [item(0, rfid: "E280", master: "a"), item(1, rfid: "E28011700000020000000001", master: "a")]
+        let data = MasterSnapshot.build(items: items, masters: ["a": master("a", code: nil)])
+        XCTAssertNoThrow(try MasterSnapshot(data: data))
+        // 見出し 24 byte + EPC 2 × 16 byte の後ろが長さ、4 byte 境界に揃えた後ろが行
+        let lengths = 24 + 2 * EPC.maxByteCount
+        let rows = (lengths + 2 + 3) & ~3
+        let masters = rows + 2 * 12
+        let offsets = masters + 12
+
+        func assertCorrupt(_ mutate: (inout Data) -> Void, line: UInt = #line) {
+            var broken = data
+            mutate(&broken)
+            XCTAssertEqual(broken.count, data.count, line: line)
+            XCTAssertThrowsError(try MasterSnapshot(data: broken), line: line) { error in
+                guard case .corrupt = error as? MasterSnapshotError else {
+                    return XCTFail("\(error)", line: line)
+                }
+            }
+        }
+        func setWord(_ data: inout Data, _ offset: Int, _ value: UInt32) {
+            withUnsafeBytes(of: value.littleEndian) { data.replaceSubrange(offset..<offset + 4, with: $0) }
+        }
+        assertCorrupt { $0[lengths] = 0 }
+        assertCorrupt { $0[lengths + 1] = UInt8(EPC.maxByteCount + 1) }
+        assertCorrupt { setWord(&$0, rows, 1_000) }                 // items.id の文字列番号
+        assertCorrupt { setWord(&$0, rows + 12, UInt32.max) }      // items.id は nil にできない
+        assertCorrupt { setWord(&$0, rows + 4, 1) }                // マスター番号
+        assertCorrupt { setWord(&$0, masters + 4, 99) }            // col_1 の文字列番号
+        assertCorrupt { setWord(&$0, offsets + 4, 10_000) }        // 文字列の終わりが範囲外
+        assertCorrupt { setWord(&$0, offsets + 8, 0) }             // 逆順のオフセット
+
+        // 壊れたファイルは開かずに捨てる（起動の度に落ちない）
+        let dir = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: dir) }
+        let store = MasterSnapshotStore(directory: dir)
+        var broken = data
+        broken[lengths] = 0xFF
+        try broken.write(to: store.url(for: .clinic))
+        XCTAssertNil(store.load(.clinic))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.url(for: .clinic).path))
+    }
+
+    /// ファイルに書いてメモリマップで開き直す。壊れたファイルは捨てる
+    func testStoreSavesAndMaps() throws {
+        let dir = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: dir) }
+        let store = MasterSnapshotStore(directory: dir)
+
+        XCTAssertNil(store.load(.clinic))
+        let items = (0..<1_000).map { item($0, rfid: String(format: "E28011700000020000%06X", $0 * 7), master: "a") }
+        try store.save(items: items.shuffled(), masters: ["a": master("a", code: "PC")], for: .clinic)
+
+        let snapshot = try XCTUnwrap(store.load(.clinic))
+        XCTAssertEqual(snapshot.count, 1_000)
+        XCTAssertEqual(snapshot.itemId(at: try XCTUnwrap(snapshot.index(of: EPC(hex: items[500].rfid)!))), "item-500")
+        XCTAssertNil(store.load(.cardShop))
+
+        try Data("broken".utf8).write(to: store.url(for: .cardShop))
+        XCTAssertNil(store.load(.cardShop))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.url(for: .cardShop).path))
+    }
+}
@@ -0,0 +1,104 @@
+//
+//  PublishCoalescerTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/27.
+//
+
+import XCTest
+@testable import RFID_ios
+
+@MainActor
+final class PublishCoalescerTests: XCTestCase {
+
+    /// 通知された要素と時刻を記録する
+    private final class Recorder {
+        var batches: [[Int]] = []
+        var times: [TimeInterval] = []
+        func record(_ batch: [Int]) {
+            batches.append(batch)
+            times.append(ProcessInfo.processInfo.systemUptime)
+        }
+    }
+
+    private func makeCoalescer(_ recorder: Recorder, rate: Double) -> PublishCoalescer<Int> {
+        PublishCoalescer(maxEmitsPerSecond: rate) { recorder.record($0) }
+    }
+
+    private func wait(_ seconds: Double) async throws {
+        try await Task.sleep(nanoseconds: UInt64(seconds * 1_000_000_000))
+    }
+
+    /// 同じ runloop 内の追加は、後でまとめて 1 回だけ通知される
+    func testTrailingEdgeFlushCombinesAppends() async throws {
+        let recorder = Recorder()
+        let coalescer = makeCoalescer(recorder, rate: 10)
+
+        coalescer.append(contentsOf: [1, 2])
+        coalescer.append(contentsOf: [3])
+        coalescer.append(contentsOf: [])
+        XCTAssertTrue(recorder.batches.isEmpty)
+        XCTAssertEqual(coalescer.pendingCount, 3)
+
+        try await wait(0.05)
+        XCTAssertEqual(recorder.batches, [[1, 2, 3]])
+        XCTAssertEqual(coalescer.pendingCount, 0)
+    }
+
+    /// 通知の間隔は 1 / maxEmitsPerSecond 秒より詰まらず、間に届いた分は次の 1 回にまとまる
+    func testCapsEmitRate() async throws {
+        let recorder = Recorder()
+        let coalescer = makeCoalescer(recorder, rate: 10)
+
+        coalescer.append(contentsOf: [1])
+        try await wait(0.02)
+        XCTAssertEqual(recorder.batches, [[1]])
+
+        coalescer.append(contentsOf: [2])
+        try await wait(0.02)
+        coalescer.append(contentsOf: [3])
+        try await wait(0.02)
+        XCTAssertEqual(recorder.batches, [[1]])
+
+        try await wait(0.2)
+        XCTAssertEqual(recorder.batches, [[1], [2, 3]])
+        XCTAssertGreaterThanOrEqual(recorder.times[1] - recorder.times[0], 0.09)
+    }
+
+    /// flush() は間隔を待たずにすぐ通知し、空なら何もしない
+    func testFlushEmitsImmediately() {
+        let recorder = Recorder()
+        let coalescer = makeCoalescer(recorder, rate: 1)
+
+        coalescer.flush()
+        XCTAssertTrue(recorder.batches.isEmpty)
+        coalescer.append(contentsOf: [1, 2])
+        coalescer.flush()
+        XCTAssertEqual(recorder.batches, [[1, 2]])
+    }
+
+    /// 捨てた要素は通知されず、その後に追加した分だけが通知される
+    func testDiscardPendingDropsQueuedElements() async throws {
+        let recorder = Recorder()
+        let coalescer = makeCoalescer(recorder, rate: 10)
+
+        coalescer.append(contentsOf: [1, 2])
+        coalescer.discardPending()
+        XCTAssertEqual(coalescer.pendingCount, 0)
+        try await wait(0.05)
+        XCTAssertTrue(recorder.batches.isEmpty)
+
+        coalescer.append(contentsOf: [1, 2])
+        coalescer.discardPending()
+        coalescer.append(contentsOf: [3])
+        try await wait(0.05)
+        XCTAssertEqual(recorder.batches, [[3]])
+    }
+
+    func testRateIsAtLeastOnePerSecond() {
+        let coalescer = PublishCoalescer<Int>(maxEmitsPerSecond: 0) { _ in }
+        XCTAssertEqual(coalescer.maxEmitsPerSecond, 1)
+        coalescer.maxEmitsPerSecond = -5
+        XCTAssertEqual(coalescer.maxEmitsPerSecond, 1)
+    }
+}
@@ -0,0 +1,75 @@
+//
+//  RSSILocatorTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/20.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class RSSILocatorTests: XCTestCase {
+
+    private let target = EPC(hex: "E28011700000020A1B2C3D4E")!
+
+    func testFilterSmoothsNoiseWhileHolding() {
+        var filter = OneEuroFilter()
+        var output = 0.0
+        // -50 ± 4 のノイズ、100 読取/秒
+        for i in 0..<200 {
+            output = filter.filter(-50 + (i % 2 == 0 ? 4 : -4), at: Double(i) * 0.01)
+        }
+        XCTAssertEqual(output, -50, accuracy: 1.5)
+    }
+
+    func testFilterFollowsStepQuickly() {
+        var filter = OneEuroFilter()
+        for i in 0..<100 { _ = filter.filter(-70, at: Double(i) * 0.01) }
+        // 近づいて -40 に上がってから 50ms 後には半分以上追従していること
+        var output = -70.0
+        for i in 100..<105 { output = filter.filter(-40, at: Double(i) * 0.01) }
+        XCTAssertGreaterThan(output, -55)
+    }
+
+    func testIgnoresNeighbouringTags() {
+        let locator = RSSILocator(target: target)
+        var samples = 0
+        locator.onSample = { _ in samples += 1 }
+
+        for i in 0..<300 {
+            let neighbour = EPC(hex: String(format: "E280117000000200%08lX", i))!
+            locator.ingest(uii: neighbour.data, rssi: -40, at: 0.001 * Double(i))
+        }
+        XCTAssertTrue(locator.ingest(uii: target.data, rssi: -60, at: 0.5))
+
+        let reading = locator.reading(at: 0.5)
+        XCTAssertEqual(samples, 1)
+        XCTAssertEqual(locator.ignoredReads, 300)
+        XCTAssertEqual(reading.rawRSSI, -60)
+        XCTAssertFalse(reading.isLost)
+    }
+
+    func testProximityAndLost() {
+        let locator = RSSILocator(target: target,
+                                  calibration: LocateCalibration(floorRSSI: -80, ceilingRSSI: -40),
+                                  staleAfter: 0.5)
+        for i in 0..<50 { locator.ingest(uii: target.data, rssi: -60, at: Double(i) * 0.01) }
+
+        let near = locator.reading(at: 0.5)
+        XCTAssertEqual(near.proximity, 0.5, accuracy: 0.01)
+        XCTAssertEqual(near.readsPerSecond, 100, accuracy: 5)
+
+        let lost = locator.reading(at: 2)
+        XCTAssertTrue(lost.isLost)
+        XCTAssertEqual(lost.proximity, 0)
+        XCTAssertEqual(lost.peakRSSI ?? 0, -60, accuracy: 0.01)
+    }
+
+    /// 見失った後に読めたら前の値を引きずらない
+    func testResetsAfterLost() {
+        let locator = RSSILocator(target: target, staleAfter: 0.5)
+        for i in 0..<50 { locator.ingest(uii: target.data, rssi: -70, at: Double(i) * 0.01) }
+        locator.ingest(uii: target.data, rssi: -45, at: 3)
+        XCTAssertEqual(locator.reading(at: 3).rssi ?? 0, -45, accuracy: 0.01)
+    }
+}
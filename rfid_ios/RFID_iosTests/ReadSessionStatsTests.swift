@@ -0,0 +1,89 @@
+//
+//  ReadSessionStatsTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/27.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class ReadSessionStatsTests: XCTestCase {
+
+    func testRecordsDifferenceFromStart() {
+        var session = ReadSessionStats(mode: .buffered)
+        session.record(from: ReadSessionCounters(reads: 1_000, callbacks: 40, unique: 120),
+                       to: ReadSessionCounters(reads: 4_000, callbacks: 70, unique: 420))
+        session.duration = 10
+
+        XCTAssertEqual(session.reads, 3_000)
+        XCTAssertEqual(session.callbacks, 30)
+        XCTAssertEqual(session.uniqueTags, 300)
+        XCTAssertEqual(session.tagsPerSecond, 30, accuracy: 0.001)
+        XCTAssertEqual(session.readsPerCallback, 100, accuracy: 0.001)
+    }
+
+    /// 読取中に読取済みをクリアすると件数が開始時を下回る。負の件数にはしない
+    func testClearDuringSessionDoesNotGoNegative() {
+        var session = ReadSessionStats(mode: .streaming)
+        session.record(from: ReadSessionCounters(reads: 10, callbacks: 5, unique: 500),
+                       to: ReadSessionCounters(reads: 90, callbacks: 25, unique: 30))
+
+        XCTAssertEqual(session.reads, 80)
+        XCTAssertEqual(session.callbacks, 20)
+        XCTAssertEqual(session.uniqueTags, 0)
+    }
+
+    /// 続けて読み直したときは、前回の停止時を基準にした分だけが入る
+    func testConsecutiveSessionsUseTheirOwnBaseline() {
+        let first = ReadSessionCounters(reads: 0, callbacks: 0, unique: 0)
+        let second = ReadSessionCounters(reads: 500, callbacks: 10, unique: 50)
+        let third = ReadSessionCounters(reads: 800, callbacks: 16, unique: 60)
+
+        var a = ReadSessionStats(mode: .streaming)
+        a.record(from: first, to: second)
+        var b = ReadSessionStats(mode: .streaming)
+        b.record(from: second, to: third)
+
+        XCTAssertEqual(a.reads + b.reads, third.reads)
+        XCTAssertEqual(b.reads, 300)
+        XCTAssertEqual(b.uniqueTags, 10)
+    }
+
+    func testRatesAreZeroWithoutDurationOrCallbacks() {
+        var session = ReadSessionStats(mode: .streaming)
+        session.uniqueTags = 10
+        session.reads = 10
+        XCTAssertEqual(session.tagsPerSecond, 0)
+        XCTAssertEqual(session.readsPerCallback, 0)
+    }
+
+    /// 電池消費は 1 分以上で、両端の残量が分かるときだけ出す
+    func testHostDrainNeedsOneMinuteAndKnownLevels() {
+        var session = ReadSessionStats(mode: .buffered)
+        session.hostBatteryStart = 0.80
+        session.hostBatteryEnd = 0.78
+
+        session.duration = 59
+        XCTAssertNil(session.hostDrainPerHour)
+
+        session.duration = 1_800
+        XCTAssertEqual(session.hostDrainPerHour ?? 0, 4, accuracy: 0.01)
+
+        // UIDevice は監視できないとき -1 を返す
+        session.hostBatteryEnd = -1
+        XCTAssertNil(session.hostDrainPerHour)
+        session.hostBatteryEnd = nil
+        XCTAssertNil(session.hostDrainPerHour)
+    }
+
+    func testReadModeIsSaved() {
+        let previous = ReadMode.saved
+        defer { previous.save() }
+
+        ReadMode.buffered.save()
+        XCTAssertEqual(ReadMode.saved, .buffered)
+        ReadMode.streaming.save()
+        XCTAssertEqual(ReadMode.saved, .streaming)
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  ScanCaptureTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/10.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class ScanCaptureTests: XCTestCase {
+
+    private func sample() -> ScanCapture {
+        ScanCapture(startedAt: Date(timeIntervalSince1970: 1_746_000_000.25), batches: [
+            CapturedBatch(offsetNanos: 0, reads: [
+                CapturedRead(uii: Data([0x30, 0x00, 0x01]), pc: 0x3000, rssi: -52),
+                CapturedRead(uii: Data([0x30, 0x00, 0x02]), pc: 0x3000, rssi: -71),
+            ]),
+            CapturedBatch(offsetNanos: 25_000_000, reads: [
+                CapturedRead(uii: Data(repeating: 0xAB, count: 16), pc: 0x4000, rssi: -30),
+            ]),
+        ])
+    }
+
+    func testRoundTrip() throws {
+        let capture = sample()
+        let decoded = try ScanCapture(data: capture.encoded())
+        XCTAssertEqual(decoded, capture)
+        XCTAssertEqual(decoded.readCount, 3)
+    }
+
+    func testRejectsBrokenFiles() {
+        let encoded = sample().encoded()
+        XCTAssertThrowsError(try ScanCapture(data: encoded.dropLast(3))) {
+            XCTAssertEqual($0 as? ScanCaptureError, .truncated)
+        }
+        XCTAssertThrowsError(try ScanCapture(data: Data("NOPE".utf8) + encoded.dropFirst(4))) {
+            XCTAssertEqual($0 as? ScanCaptureError, .badMagic)
+        }
+    }
+
+    /// 追記は書き込み用キューに積まれ、close() で全部書き終わる
+    func testWriterFlushesQueuedBatchesOnClose() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).rfcap")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let writer = try ScanCaptureWriter(url: url, flushThreshold: 32)
+        let batches = sample().batches
+        for _ in 0..<50 {
+            for batch in batches { writer.append(batch.reads) }
+        }
+        writer.close()
+
+        XCTAssertEqual(writer.batchCount, 100)
+        let decoded = try ScanCapture(contentsOf: url)
+        XCTAssertEqual(decoded.batches.count, 100)
+        XCTAssertEqual(decoded.batches.map(\.reads), Array(repeating: batches.map(\.reads), count: 50).flatMap { $0 })
+        XCTAssertEqual(decoded.batches.map(\.offsetNanos), decoded.batches.map(\.offsetNanos).sorted())
+    }
+
+    func testReplayFeedsPipeline() {
+        let pipeline = ScanIngestPipeline<CapturedRead>(capacity: 8)
+        var added: [EPC] = []
+        pipeline.onDelta = { added.append(contentsOf: $0.added) }
+
+        ScanReplayer(capture: sample(), speed: .maximum).run { pipeline.push($0) }
+        pipeline.waitUntilIdle()
+
+        XCTAssertEqual(added.count, 3)
+        XCTAssertEqual(pipeline.currentCounters.batchesConsumed, 2)
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  ScanIngestPipelineTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/08.
+//
+
+import XCTest
+@testable import RFID_ios
+
+/// SDK の RFIDData の代わりに流すフェイク
+private struct FakeRead: RawTagRead {
+    let uiiData: Data?
+    init(_ hex: String) { uiiData = EPC(hex: hex)?.data }
+}
+
+final class ScanIngestPipelineTests: XCTestCase {
+
+    func testDeduplicatesAcrossBatches() {
+        let pipeline = ScanIngestPipeline<FakeRead>(capacity: 8)
+        var added: [EPC] = []
+        pipeline.onDelta = { added.append(contentsOf: $0.added) }
+
+        pipeline.push([FakeRead("01"), FakeRead("02"), FakeRead("01")])
+        pipeline.push([FakeRead("02"), FakeRead("03")])
+        pipeline.waitUntilIdle()
+
+        XCTAssertEqual(added.map(\.hex), ["01", "02", "03"])
+        XCTAssertEqual(pipeline.record(for: EPC(hex: "02")!)?.readCount, 2)
+        XCTAssertEqual(pipeline.currentCounters.readsDecoded, 5)
+    }
+
+    func testDropNewestCountsOverflow() {
+        let queue = DispatchQueue(label: "test.ingest")
+        let pipeline = ScanIngestPipeline<FakeRead>(capacity: 2, policy: .dropNewest, queue: queue)
+        var added: [EPC] = []
+        pipeline.onDelta = { added.append(contentsOf: $0.added) }
+
+        queue.suspend()
+        for i in 1...4 { pipeline.push([FakeRead(String(format: "%02X", i))]) }
+        queue.resume()
+        pipeline.waitUntilIdle()
+
+        let counters = pipeline.currentCounters
+        XCTAssertEqual(counters.batchesPushed, 4)
+        XCTAssertEqual(counters.batchesDropped, 2)
+        XCTAssertEqual(counters.highWatermark, 2)
+        XCTAssertEqual(added.map(\.hex), ["01", "02"])
+    }
+
+    func testDropOldestKeepsLatestBatches() {
+        let queue = DispatchQueue(label: "test.ingest")
+        let pipeline = ScanIngestPipeline<FakeRead>(capacity: 2, policy: .dropOldest, queue: queue)
+        var added: [EPC] = []
+        pipeline.onDelta = { added.append(contentsOf: $0.added) }
+
+        queue.suspend()
+        for i in 1...4 { pipeline.push([FakeRead(String(format: "%02X", i))]) }
+        queue.resume()
+        pipeline.waitUntilIdle()
+
+        XCTAssertEqual(pipeline.currentCounters.batchesDropped, 2)
+        XCTAssertEqual(added.map(\.hex), ["03", "04"])
+    }
+
+    func testResetStartsNewGeneration() {
+        let pipeline = ScanIngestPipeline<FakeRead>(capacity: 8)
+        var deltas: [ScanIngestPipeline<FakeRead>.Delta] = []
+        pipeline.onDelta = { deltas.append($0) }
+
+        pipeline.push([FakeRead("01")])
+        pipeline.waitUntilIdle()
+        let generation = pipeline.reset()
+        pipeline.push([FakeRead("01")])
+        pipeline.waitUntilIdle()
+
+        XCTAssertEqual(deltas.count, 2)
+        XCTAssertEqual(deltas.last?.generation, generation)
+        XCTAssertEqual(deltas.last?.uniqueCount, 1)
+    }
+}
@@ -0,0 +1,72 @@
+//
+//  ScanTunerTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/13.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class ScanTunerTests: XCTestCase {
+
+    /// 仮想スキャナで 1 ウィンドウ分読んだ新規ユニーク数
+    private func measure(_ scanner: SimulatedScanner, _ profile: ScanProfile, window: TimeInterval) -> Int {
+        scanner.settings.qParam = profile.qParam
+        switch profile.session {
+        case .s0:       scanner.settings.session = .s0
+        case .s1:       scanner.settings.session = .s1
+        case .s2, .s3:  scanner.settings.session = .s2
+        }
+        let before = scanner.stats.uniqueTags
+        scanner.run(duration: window) { _ in }
+        return scanner.stats.uniqueTags - before
+    }
+
+    func testRaisesQForLargePopulation() {
+        var settings = SimulatedScanSettings()
+        settings.adaptiveQ = false
+        let scanner = SimulatedScanner(population: .random(count: 400, seed: 5), settings: settings, seed: 9)
+        var config = ScanTuner.Configuration()
+        config.window = 0.5
+        config.maxWindows = 60
+        let tuner = ScanTuner(start: ScanProfile(qParam: 5, session: .s0, linkProfile: 1), configuration: config)
+
+        var step = ScanTuner.Step.measure(tuner.current)
+        while case .measure(let profile) = step {
+            let found = measure(scanner, profile, window: config.window)
+            step = tuner.windowCompleted(newUniqueTags: found, duration: config.window)
+        }
+
+        guard case .finished(let best) = step else { return XCTFail() }
+        XCTAssertGreaterThan(best.qParam, 5)
+        XCTAssertLessThanOrEqual(tuner.windows, config.maxWindows)
+    }
+
+    func testFinishesOnPlateau() {
+        var config = ScanTuner.Configuration()
+        config.plateauWindows = 2
+        let tuner = ScanTuner(start: .default, configuration: config)
+        let counts = [100, 80, 60, 40, 1, 0, 0, 0, 0, 0]
+        var result: ScanTuner.Step?
+        for n in counts {
+            result = tuner.windowCompleted(newUniqueTags: n, duration: 1)
+            if case .finished = result { break }
+        }
+        XCTAssertEqual(result, .finished(.default))
+        XCTAssertLessThan(tuner.windows, counts.count)
+    }
+
+    func testProfileIsClampedAndPersistedPerTarget() {
+        let defaults = UserDefaults(suiteName: "ScanTunerTests")!
+        defaults.removePersistentDomain(forName: "ScanTunerTests")
+        let store = ScanProfileStore(defaults: defaults)
+        let profile = ScanProfile(qParam: 12, session: .s1, linkProfile: 3).clamped
+
+        store.save(profile, for: TargetType.cardShop.rawValue)
+
+        XCTAssertEqual(profile, ScanProfile(qParam: 7, session: .s1, linkProfile: 1))
+        XCTAssertEqual(store.profile(for: TargetType.cardShop.rawValue), profile)
+        XCTAssertNil(store.profile(for: TargetType.apparelShop.rawValue))
+    }
+}
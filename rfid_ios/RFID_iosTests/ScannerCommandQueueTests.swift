@@ -0,0 +1,130 @@
+//
+//  ScannerCommandQueueTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/15.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class ScannerCommandQueueTests: XCTestCase {
+
+    /// 先頭コマンドでキューを塞ぎ、その間に後続を積むためのゲート
+    private func blockQueue(_ queue: ScannerCommandQueue) -> (started: XCTestExpectation, release: DispatchSemaphore) {
+        let started = expectation(description: "blocker started")
+        let release = DispatchSemaphore(value: 0)
+        Task {
+            try? await queue.run("block") {
+                started.fulfill()
+                release.wait()
+            }
+        }
+        return (started, release)
+    }
+
+    func testRunsOneCommandAtATime() async throws {
+        let queue = ScannerCommandQueue()
+        var running = 0
+        var maxRunning = 0
+        let lock = NSLock()
+        let tasks = (0..<8).map { _ in
+            Task {
+                try await queue.run("exclusive") {
+                    lock.lock(); running += 1; maxRunning = max(maxRunning, running); lock.unlock()
+                    Thread.sleep(forTimeInterval: 0.005)
+                    lock.lock(); running -= 1; lock.unlock()
+                }
+            }
+        }
+        for task in tasks { try await task.value }
+
+        XCTAssertEqual(maxRunning, 1)
+        XCTAssertEqual(queue.latencySnapshot()["exclusive"]?.completed, 8)
+    }
+
+    func testCoalescingSupersedesPendingCommands() async throws {
+        let queue = ScannerCommandQueue()
+        let gate = blockQueue(queue)
+        await fulfillment(of: [gate.started], timeout: 1)
+
+        var applied: [Int] = []
+        let tasks = (1...3).map { value in
+            Task { () -> Result<Int, Error> in
+                do {
+                    return .success(try await queue.run("power", coalescing: true) { applied.append(value); return value })
+                } catch {
+                    return .failure(error)
+                }
+            }
+        }
+        try await Task.sleep(nanoseconds: 50_000_000)
+        gate.release.signal()
+
+        var superseded = 0
+        for task in tasks {
+            if case .failure(let error) = await task.value {
+                XCTAssertEqual(error as? ScannerCommandError, .superseded)
+                superseded += 1
+            }
+        }
+        // 最後に積まれた 1 件だけが実行される（Task の起動順は不定）
+        XCTAssertEqual(applied.count, 1)
+        XCTAssertEqual(superseded, 2)
+        XCTAssertEqual(queue.latencySnapshot()["power"]?.superseded, 2)
+    }
+
+    func testTimeoutIncludesWaitTime() async {
+        let queue = ScannerCommandQueue()
+        let gate = blockQueue(queue)
+        await fulfillment(of: [gate.started], timeout: 1)
+
+        var ran = false
+        do {
+            try await queue.run("slow", timeout: 0.1) { ran = true }
+            XCTFail("timeout expected")
+        } catch {
+            XCTAssertEqual(error as? ScannerCommandError, .timedOut("slow"))
+        }
+        gate.release.signal()
+        queue.waitUntilIdle()
+        // タイムアウト済みのコマンドは実行されない
+        XCTAssertFalse(ran)
+        XCTAssertEqual(queue.latencySnapshot()["slow"]?.timedOut, 1)
+    }
+
+    func testCancellationResumesCaller() async {
+        let queue = ScannerCommandQueue()
+        let gate = blockQueue(queue)
+        await fulfillment(of: [gate.started], timeout: 1)
+
+        let task = Task { try await queue.run("cancelled") { } }
+        task.cancel()
+        do {
+            try await task.value
+            XCTFail("cancellation expected")
+        } catch {
+            XCTAssertTrue(error is CancellationError)
+        }
+        gate.release.signal()
+        queue.waitUntilIdle()
+        XCTAssertEqual(queue.latencySnapshot()["cancelled"]?.cancelled, 1)
+    }
+
+    func testRecordsFailuresAndLatency() async {
+        let queue = ScannerCommandQueue()
+        let failure = NSError(domain: "test", code: 1)
+        do {
+            try await queue.run("fail") { try sdkCall { $0 = failure } }
+            XCTFail("error expected")
+        } catch {
+            XCTAssertEqual(error as NSError, failure)
+        }
+        try? await queue.run("sleep") { Thread.sleep(forTimeInterval: 0.02) }
+
+        let snapshot = queue.latencySnapshot()
+        XCTAssertEqual(snapshot["fail"]?.failed, 1)
+        XCTAssertEqual(snapshot["sleep"]?.completed, 1)
+        XCTAssertGreaterThanOrEqual(snapshot["sleep"]?.p50ExecMillis ?? 0, 15)
+    }
+}
@@ -0,0 +1,149 @@
+//
+//  ScannerConnectionTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/16.
+//
+
+import XCTest
+@testable import RFID_ios
+
+/// CommScanner の代わり
+private final class FakeScannerLink: ScannerLink {
+    let modelName: String
+    /// 残り何回 CLAIM を失敗させるか
+    var claimFailures: Int
+    /// 何回目の確認から RFIDScanner が取れるか
+    var readyAfterChecks: Int
+    private(set) var claims = 0
+    private(set) var checks = 0
+
+    init(_ name: String = "SP1", claimFailures: Int = 0, readyAfterChecks: Int = 1) {
+        self.modelName = name
+        self.claimFailures = claimFailures
+        self.readyAfterChecks = readyAfterChecks
+    }
+
+    func claimLink() throws {
+        claims += 1
+        if claimFailures > 0 {
+            claimFailures -= 1
+            throw NSError(domain: "FakeScanner", code: -1)
+        }
+    }
+
+    var isRFIDAvailable: Bool {
+        checks += 1
+        return checks >= readyAfterChecks
+    }
+}
+
+@MainActor
+final class ScannerConnectionTests: XCTestCase {
+
+    private var connection: ScannerConnection!
+    private var discoveries = 0
+    private var readyEvents: [Bool] = []
+    private var lostEvents = 0
+
+    override func setUp() async throws {
+        var policy = ConnectionPolicy()
+        policy.initialReadyCheckDelay = 0.001
+        policy.maxReadyCheckDelay = 0.005
+        policy.readyTimeout = 0.5
+        policy.initialReconnectDelay = 0.005
+        policy.maxReconnectDelay = 0.02
+        policy.reconnectAttempts = 3
+        connection = ScannerConnection(policy: policy, commands: ScannerCommandQueue())
+        discoveries = 0
+        readyEvents = []
+        lostEvents = 0
+        connection.startDiscovery = { [unowned self] in self.discoveries += 1 }
+        connection.onReady = { [unowned self] _, restored in self.readyEvents.append(restored) }
+        connection.onLost = { [unowned self] _ in self.lostEvents += 1 }
+        connection.start()
+    }
+
+    /// 条件を満たすまで待つ（バックオフ待ちのあるもの用）
+    private func waitUntil(timeout: TimeInterval = 2, _ condition: () -> Bool) async {
+        let deadline = Date().addingTimeInterval(timeout)
+        while !condition(), Date() < deadline {
+            try? await Task.sleep(nanoseconds: 2_000_000)
+        }
+    }
+
+    func testClaimThenReadyRecordsTimes() async {
+        let link = FakeScannerLink()
+        await connection.scannerAppeared(link)
+
+        XCTAssertEqual(connection.state, .ready)
+        XCTAssertEqual(readyEvents, [false])
+        XCTAssertEqual(connection.metrics.connects, 1)
+        XCTAssertNotNil(connection.metrics.timeToClaim)
+        XCTAssertGreaterThanOrEqual(connection.metrics.timeToReady ?? -1, connection.metrics.timeToClaim ?? 0)
+        XCTAssertEqual(discoveries, 1)
+    }
+
+    func testRetriesClaimWithBackoff() async {
+        let link = FakeScannerLink(claimFailures: 2)
+        await connection.scannerAppeared(link)
+
+        XCTAssertEqual(link.claims, 3)
+        XCTAssertEqual(connection.metrics.claimFailures, 2)
+        XCTAssertEqual(connection.state, .ready)
+    }
+
+    func testWaitsForRFIDScanner() async {
+        let link = FakeScannerLink(readyAfterChecks: 4)
+        await connection.scannerAppeared(link)
+
+        XCTAssertEqual(connection.state, .ready)
+        XCTAssertEqual(connection.metrics.readyChecks, 4)
+    }
+
+    func testReconnectsAfterDropoutAndReportsRestore() async {
+        let link = FakeScannerLink()
+        await connection.scannerAppeared(link)
+        connection.scannerLost(link)
+
+        XCTAssertEqual(lostEvents, 1)
+        XCTAssertEqual(connection.state, .reconnecting(attempt: 1))
+        // バックオフ後に再検出を始める
+        await waitUntil { self.discoveries >= 2 }
+        XCTAssertGreaterThanOrEqual(discoveries, 2)
+
+        await connection.scannerAppeared(FakeScannerLink("SP1-again"))
+        XCTAssertEqual(connection.state, .ready)
+        XCTAssertEqual(readyEvents, [false, true])
+        XCTAssertEqual(connection.metrics.reconnects, 1)
+        XCTAssertNotNil(connection.metrics.lastOutage)
+    }
+
+    func testGivesUpAfterReconnectAttempts() async {
+        let link = FakeScannerLink()
+        await connection.scannerAppeared(link)
+        connection.scannerLost(link)
+
+        await waitUntil { if case .failed = self.connection.state { return true } else { return false } }
+        guard case .failed = connection.state else { return XCTFail("\(connection.state)") }
+        // 初回の start と 3 回の再検出
+        XCTAssertEqual(discoveries, 4)
+
+        // 手動の再接続で最初からやり直せる
+        connection.reconnect()
+        XCTAssertEqual(connection.state, .idle)
+        await connection.scannerAppeared(FakeScannerLink())
+        XCTAssertEqual(connection.state, .ready)
+    }
+
+    func testIgnoresEventsFromOtherScanners() async {
+        let link = FakeScannerLink()
+        await connection.scannerAppeared(link)
+        connection.scannerLost(FakeScannerLink("other"))
+        await connection.scannerAppeared(FakeScannerLink("other"))
+
+        XCTAssertEqual(connection.state, .ready)
+        XCTAssertTrue(connection.link === link)
+        XCTAssertEqual(lostEvents, 0)
+    }
+}
@@ -0,0 +1,56 @@
+//
+//  SelectMaskPlannerTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/12.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class SelectMaskPlannerTests: XCTestCase {
+
+    private func epc(_ hex: String) -> EPC { EPC(hex: hex)! }
+
+    func testCommonPrefixBecomesSingleMask() {
+        let masters = ["300011110000000000000001", "300011110000000000000002", "3000111100000000000000FF"].map(epc)
+        let masks = SelectMaskPlanner.plan(covering: masters, maxMasks: 1)
+
+        XCTAssertEqual(masks.count, 1)
+        XCTAssertEqual(masks[0].bitLength, 88)
+        XCTAssertTrue(masters.allSatisfy { masks[0].matches($0) })
+        XCTAssertFalse(masks[0].matches(epc("300011120000000000000001")))
+    }
+
+    func testSplitsAtWeakestPrefix() {
+        let shopA = (1...50).map { epc(String(format: "3000AAAA00000000%08lX", $0)) }
+        let shopB = (1...50).map { epc(String(format: "3000BBBB00000000%08lX", $0)) }
+        let masks = SelectMaskPlanner.plan(covering: shopA + shopB, maxMasks: 2)
+
+        XCTAssertEqual(masks.count, 2)
+        XCTAssertTrue((shopA + shopB).allSatisfy { uii in masks.contains { $0.matches(uii) } })
+        // 別店舗の 3000CCCC... は通さない
+        XCTAssertFalse(masks.contains { $0.matches(epc("3000CCCC0000000000000001")) })
+    }
+
+    func testEveryMasterIsCoveredWithinBudget() {
+        var rng = SplitMix64(seed: 3)
+        let masters = (0..<2_000).map { _ -> EPC in
+            let bytes = (0..<12).map { _ in UInt8.random(in: 0...255, using: &rng) }
+            return EPC(bytes: bytes)!
+        }
+        for budget in [1, 4, 8, 64] {
+            let masks = SelectMaskPlanner.plan(covering: masters, maxMasks: budget)
+            XCTAssertLessThanOrEqual(masks.count, budget)
+            if masks.isEmpty { continue }
+            XCTAssertTrue(masters.allSatisfy { uii in masks.contains { $0.matches(uii) } })
+        }
+    }
+
+    func testPrefixHelpers() {
+        let a = epc("30001111000000000000ABCD")
+        XCTAssertEqual(a.commonPrefixBitLength(with: epc("30001111000000000000ABCC")), 95)
+        XCTAssertEqual(a.prefix(bitLength: 20).hex, "300010")
+        XCTAssertLessThan(epc("3000"), epc("300000"))
+    }
+}
@@ -0,0 +1,82 @@
+//
+//  SignalStatsTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/27.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class SignalStatsTests: XCTestCase {
+
+    private func sample(_ rssi: Int, antenna: Int = 1, channel: Int = 0) -> SignalSample {
+        SignalSample(rssi: rssi, antenna: antenna, channel: channel, phase: rssi & 0xFF, polarization: antenna % 2)
+    }
+
+    func testEmptyStats() {
+        let stats = SignalStats()
+        XCTAssertFalse(stats.hasSamples)
+        XCTAssertEqual(stats.sampleCount, 0)
+        XCTAssertEqual(stats.rssiMean, 0)
+        XCTAssertEqual(stats.rssiMax, Int.min)
+        XCTAssertNil(stats.lastRSSI)
+        XCTAssertNil(stats.lastAntenna)
+    }
+
+    /// 逐次平均が全件の算術平均と一致する（件数が多くても誤差が溜まらない）
+    func testRunningMeanMatchesArithmeticMean() {
+        var stats = SignalStats()
+        let values = (0..<10_000).map { -80 + ($0 * 37) % 45 }
+        for v in values { stats.add(sample(v)) }
+
+        let expected = Double(values.reduce(0, +)) / Double(values.count)
+        XCTAssertEqual(stats.sampleCount, values.count)
+        XCTAssertEqual(stats.rssiMean, expected, accuracy: 1e-6)
+        XCTAssertEqual(stats.rssiMax, values.max())
+    }
+
+    /// 最大値は全期間、それ以外は最後の読取の値
+    func testMaxIsStickyAndLastFieldsFollowLatestRead() {
+        var stats = SignalStats()
+        stats.add(sample(-40, antenna: 1, channel: 3))
+        stats.add(sample(-70, antenna: 2, channel: 9))
+
+        XCTAssertEqual(stats.rssiMax, -40)
+        XCTAssertEqual(stats.lastRSSI, -70)
+        XCTAssertEqual(stats.lastAntenna, 2)
+        XCTAssertEqual(stats.lastChannel, 9)
+        XCTAssertEqual(stats.lastPolarization, 0)
+        XCTAssertEqual(stats.rssiMean, -55, accuracy: 0.001)
+    }
+
+    /// 読取済みをクリアして読み直したタグは、統計も最初から取り直す
+    func testStoreClearRestartsStats() {
+        var store = TagStore()
+        let tag = EPC(hex: "0A")!
+        store.insert(tag, at: Date(timeIntervalSince1970: 0), signal: sample(-30))
+        store.insert(tag, at: Date(timeIntervalSince1970: 1), signal: sample(-50))
+        store.removeAll()
+
+        store.insert(tag, at: Date(timeIntervalSince1970: 10), signal: sample(-60))
+        let record = store.record(for: tag)!
+        XCTAssertEqual(record.signal.sampleCount, 1)
+        XCTAssertEqual(record.signal.rssiMean, -60, accuracy: 0.001)
+        XCTAssertEqual(record.signal.rssiMax, -60)
+        XCTAssertEqual(record.readCount, 1)
+        XCTAssertEqual(record.readsPerSecond, 0)
+    }
+
+    /// signal の無い読取（setResponse 未対応）は回数だけ数え、統計には入れない
+    func testReadsWithoutSignalDoNotCount() {
+        var store = TagStore()
+        let tag = EPC(hex: "0B")!
+        store.insert(tag, at: Date(timeIntervalSince1970: 0), signal: sample(-45))
+        store.insert(tag, at: Date(timeIntervalSince1970: 4))
+
+        let record = store.record(for: tag)!
+        XCTAssertEqual(record.readCount, 2)
+        XCTAssertEqual(record.signal.sampleCount, 1)
+        XCTAssertEqual(record.readsPerSecond, 0.5, accuracy: 0.001)
+    }
+}
@@ -0,0 +1,88 @@
+//
+//  SimulatedScannerTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/11.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class SimulatedScannerTests: XCTestCase {
+
+    private func run(_ settings: SimulatedScanSettings, tags: Int = 500, duration: TimeInterval = 2) -> (SimulatedScanner.Stats, [CapturedRead]) {
+        let scanner = SimulatedScanner(population: .random(count: tags, seed: 7), settings: settings, seed: 42)
+        var reads: [CapturedRead] = []
+        let stats = scanner.run(duration: duration) { reads.append(contentsOf: $0) }
+        return (stats, reads)
+    }
+
+    func testSameSeedIsReproducible() {
+        let (a, readsA) = run(SimulatedScanSettings())
+        let (b, readsB) = run(SimulatedScanSettings())
+        XCTAssertEqual(a, b)
+        XCTAssertEqual(readsA, readsB)
+    }
+
+    func testSessionFlagControlsRepeats() {
+        var s0 = SimulatedScanSettings()
+        s0.qParam = 7
+        var s2 = s0
+        s2.session = .s2
+
+        let (repeated, _) = run(s0)
+        let (once, reads) = run(s2)
+        XCTAssertGreaterThan(repeated.reads, repeated.uniqueTags)
+        XCTAssertEqual(once.reads, once.uniqueTags)
+        XCTAssertEqual(Set(reads.map(\.uii)).count, reads.count)
+    }
+
+    func testLowPowerReadsFewerTags() {
+        var high = SimulatedScanSettings()
+        high.qParam = 7
+        high.session = .s1
+        var low = high
+        low.powerLevelRead = 10
+
+        XCTAssertLessThan(run(low).0.uniqueTags, run(high).0.uniqueTags)
+    }
+
+    func testAdaptiveQSpreadsLargePopulation() {
+        var fixed = SimulatedScanSettings()
+        fixed.qParam = 2
+        fixed.adaptiveQ = false
+        var adaptive = fixed
+        adaptive.adaptiveQ = true
+
+        XCTAssertGreaterThan(run(adaptive, tags: 2_000, duration: 2).0.uniqueTags,
+                             run(fixed, tags: 2_000, duration: 2).0.uniqueTags)
+    }
+
+    func testSmallQCollidesOnLargePopulation() {
+        var small = SimulatedScanSettings()
+        small.qParam = 2
+        small.adaptiveQ = false
+        var large = small
+        large.qParam = 7
+
+        let (collided, _) = run(small, tags: 2_000, duration: 1)
+        let (spread, _) = run(large, tags: 2_000, duration: 1)
+        XCTAssertGreaterThan(Double(collided.collidedSlots) / Double(collided.slots),
+                             Double(spread.collidedSlots) / Double(spread.slots))
+    }
+
+    /// 10 万件母集団での取り込み負荷（ScanIngestPipeline まで）
+    func testHundredThousandTagIngest() {
+        var settings = SimulatedScanSettings()
+        settings.qParam = 7
+        settings.session = .s1
+        let scanner = SimulatedScanner(population: .random(count: 100_000), settings: settings)
+        let pipeline = ScanIngestPipeline<CapturedRead>(capacity: 4096, policy: .dropNewest,
+                                                        expectedTagCount: 100_000)
+        measure {
+            scanner.run(duration: 1) { pipeline.push($0) }
+            pipeline.waitUntilIdle()
+        }
+        XCTAssertEqual(pipeline.currentCounters.batchesDropped, 0)
+    }
+}
@@ -0,0 +1,62 @@
+//
+//  TagStoreTests.swift
+//  RFID_iosTests
+//
+//  Created on 2025/05/07.
+//
+
+import XCTest
+@testable import RFID_ios
+
+final class TagStoreTests: XCTestCase {
+
+    func testInsertDeduplicatesAndKeepsOrder() {
+        var store = TagStore()
+        let (a, b, c) = (EPC(hex: "0A")!, EPC(hex: "0B")!, EPC(hex: "0C")!)
+        let t0 = Date(timeIntervalSince1970: 0)
+        let t1 = Date(timeIntervalSince1970: 1)
+
+        XCTAssertEqual(store.insert(contentsOf: [a, b, a], at: t0), [a, b])
+        XCTAssertEqual(store.insert(contentsOf: [b, c], at: t1), [c])
+        XCTAssertEqual(store.uiis, [a, b, c])
+
+        let record = store.record(for: b)
+        XCTAssertEqual(record?.readCount, 2)
+        XCTAssertEqual(record?.firstSeen, t0)
+        XCTAssertEqual(record?.lastSeen, t1)
+    }
+
+    func testSignalStatsAccumulate() {
+        var store = TagStore()
+        let tag = EPC(hex: "0A")!
+        store.insert(tag, at: Date(timeIntervalSince1970: 0),
+                     signal: SignalSample(rssi: -60, antenna: 1, channel: 5, phase: 0, polarization: 0))
+        store.insert(tag, at: Date(timeIntervalSince1970: 2),
+                     signal: SignalSample(rssi: -50, antenna: 2, channel: 7, phase: 0, polarization: 1))
+
+        let record = store.record(for: tag)!
+        XCTAssertEqual(record.signal.rssiMean, -55, accuracy: 0.001)
+        XCTAssertEqual(record.signal.rssiMax, -50)
+        XCTAssertEqual(record.signal.lastAntenna, 2)
+        XCTAssertEqual(record.signal.lastChannel, 7)
+        XCTAssertEqual(record.readsPerSecond, 1, accuracy: 0.001)
+    }
+
+    /// 5 万件の合成 UII を 2 周（新規 + 重複）投入し ns/tag を出力
+    func testInsertThroughput50k() {
+        let tagCount = 50_000
+        let uiis = (0..<tagCount).map { EPC(hex: String(format: "3000E2%018lX", $0))! }
+
+        var nsPerTag = 0.0
+        measure {
+            var store = TagStore(minimumCapacity: tagCount)
+            let start = DispatchTime.now().uptimeNanoseconds
+            store.insert(contentsOf: uiis)
+            store.insert(contentsOf: uiis)
+            let elapsed = DispatchTime.now().uptimeNanoseconds - start
+            nsPerTag = Double(elapsed) / Double(tagCount * 2)
+            XCTAssertEqual(store.count, tagCount)
+        }
+        print("📊 [Bench] TagStore insert: \(String(format: "%.1f", nsPerTag)) ns/tag")
+    }
+}
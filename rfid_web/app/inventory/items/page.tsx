@@ -5,8 +5,9 @@ import Image from "next/image";
 import Link from "next/link";
 import { Eye, Filter, Search } from "lucide-react";
 
-import { InventoryMaster, Item } from "@/lib/db";
+import { InventoryMaster, InventorySession, Item } from "@/lib/db";
 import { Constants } from "@/lib/db/database.types";
+import { getLatestClosedSessions } from "@/lib/db/inventory-session";
 import { getItemsWithMasterInfo } from "@/lib/db/items";
 import { Button } from "@/components/ui/Button";
 import { Card } from "@/components/ui/Card";
@@ -38,6 +39,8 @@ export default function ItemsPage() {
   const [loading, setLoading] = useState(true);
   const [searchTerm, setSearchTerm] = useState("");
   const [filteredItems, setFilteredItems] = useState<ItemWithMaster[]>([]);
+  // 棚卸し状態の基準になる業種ごとの最新の締め済みセッション
+  const [sessions, setSessions] = useState<InventorySession[]>([]);
   const [itemStats, setItemStats] = useState<{
     total: number;
     byTarget: Record<string, number>;
@@ -58,7 +61,10 @@ export default function ItemsPage() {
   useEffect(() => {
     const fetchData = async () => {
       try {
-        const data = await getItemsWithMasterInfo();
+        const [data, latestSessions] = await Promise.all([
+          getItemsWithMasterInfo(),
+          getLatestClosedSessions(),
+        ]);
 
         // 商品数の集計
         const stats = {
@@ -86,6 +92,7 @@ export default function ItemsPage() {
         });
 
         setItemStats(stats);
+        setSessions(latestSessions);
         setItems(data);
         setFilteredItems(data);
       } catch (error) {
@@ -156,6 +163,20 @@ export default function ItemsPage() {
           総数: {itemStats.total} | 棚卸済: {itemStats.inventoried} | 未棚卸:{" "}
           {itemStats.notInventoried}
         </div>
+        <div className="text-xs text-muted-foreground mt-1">
+          {sessions.length === 0
+            ? "締め済みの棚卸しはまだありません"
+            : sessions
+                .map(
+                  (session) =>
+                    `${getTargetLabel(session.target)}: ${new Date(
+                      session.closed_at ?? session.created_at
+                    ).toLocaleString("ja-JP")} の棚卸し（外れ ${
+                      session.outer_count ?? 0
+                    }件）`
+                )
+                .join(" / ")}
+        </div>
       </div>
 
       <div className="mb-6 flex flex-col md:flex-row gap-4">
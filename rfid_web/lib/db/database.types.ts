@@ -98,6 +98,77 @@ export type Database = {
           },
         ];
       };
+      inventory_sessions: {
+        Row: {
+          id: string;
+          created_at: string;
+          updated_at: string;
+          target: Database["public"]["Enums"]["target_type"];
+          status: Database["public"]["Enums"]["inventory_session_status"];
+          closed_at: string | null;
+          matched_count: number | null;
+          uncounted_count: number | null;
+          outer_count: number | null;
+          user_id: string | null;
+        };
+        Insert: {
+          id?: string;
+          created_at?: string;
+          updated_at?: string;
+          target: Database["public"]["Enums"]["target_type"];
+          status?: Database["public"]["Enums"]["inventory_session_status"];
+          closed_at?: string | null;
+          matched_count?: number | null;
+          uncounted_count?: number | null;
+          outer_count?: number | null;
+          user_id?: string | null;
+        };
+        Update: {
+          id?: string;
+          created_at?: string;
+          updated_at?: string;
+          target?: Database["public"]["Enums"]["target_type"];
+          status?: Database["public"]["Enums"]["inventory_session_status"];
+          closed_at?: string | null;
+          matched_count?: number | null;
+          uncounted_count?: number | null;
+          outer_count?: number | null;
+          user_id?: string | null;
+        };
+        Relationships: [
+          {
+            foreignKeyName: "inventory_sessions_user_id_fkey";
+            columns: ["user_id"];
+            referencedRelation: "users";
+            referencedColumns: ["id"];
+          },
+        ];
+      };
+      inventory_scans: {
+        Row: {
+          session_id: string;
+          rfid: string;
+          scanned_at: string;
+        };
+        Insert: {
+          session_id: string;
+          rfid: string;
+          scanned_at?: string;
+        };
+        Update: {
+          session_id?: string;
+          rfid?: string;
+          scanned_at?: string;
+        };
+        Relationships: [
+          {
+            foreignKeyName: "inventory_scans_session_id_fkey";
+            columns: ["session_id"];
+            referencedRelation: "inventory_sessions";
+            referencedColumns: ["id"];
+          },
+        ];
+      };
       profiles: {
         Row: {
           avatar_url: string | null;
@@ -154,12 +225,56 @@ export type Database = {
       };
     };
     Views: {
-      [_ in never]: never;
+      item_inventory_status: {
+        Row: {
+          item_id: string;
+          inventory_master_id: string;
+          target: Database["public"]["Enums"]["target_type"];
+          session_id: string | null;
+          closed_at: string | null;
+          is_inventoried: boolean;
+        };
+        Relationships: [];
+      };
+      inventory_master_stock: {
+        Row: {
+          inventory_master_id: string;
+          item_count: number;
+          inventoried_count: number;
+          counted_at: string | null;
+        };
+        Relationships: [];
+      };
     };
     Functions: {
-      [_ in never]: never;
+      append_inventory_scans: {
+        Args: {
+          p_session_id: string;
+          p_rfids: string[];
+        };
+        Returns: number;
+      };
+      inventory_session_results: {
+        Args: {
+          p_session_id: string;
+        };
+        Returns: {
+          rfid: string;
+          result: "matched" | "uncounted" | "outer";
+          item_id: string | null;
+          inventory_master_id: string | null;
+        }[];
+      };
+      close_inventory_session: {
+        Args: {
+          p_session_id: string;
+          p_discard?: boolean;
+        };
+        Returns: Database["public"]["Tables"]["inventory_sessions"]["Row"];
+      };
     };
     Enums: {
+      inventory_session_status: "open" | "closed" | "discarded";
       message_role: "system" | "user" | "assistant";
       pricing_plan_interval: "day" | "week" | "month" | "year";
       pricing_type: "one_time" | "recurring";
@@ -288,6 +403,7 @@ export type CompositeTypes<
 export const Constants = {
   public: {
     Enums: {
+      inventory_session_status: ["open", "closed", "discarded"],
       message_role: ["system", "user", "assistant"],
       pricing_plan_interval: ["day", "week", "month", "year"],
       pricing_type: ["one_time", "recurring"],
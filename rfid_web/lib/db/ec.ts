@@ -1,4 +1,5 @@
 import { Database } from "@/lib/db/database.types";
+import { getMasterStock, MasterStock } from "@/lib/db/inventory-session";
 import { createClient } from "@/lib/supabase/client";
 
 export type ECProduct = {
@@ -13,14 +14,32 @@ export type ECProduct = {
   created_at: string;
 };
 
+/**
+ * 在庫ステータスを判定する
+ * 在庫は最新の締め済み棚卸しセッションで数えたアイテム数
+ */
+function stockStatus(stock: MasterStock | undefined) {
+  const count = stock?.inventoried_count ?? 0;
+  let status: ECProduct["status"] = "available";
+  if (!stock || stock.item_count === 0) {
+    status = "out_of_stock";
+  } else if (!stock.counted_at) {
+    // 商品はあるが締めた棚卸しがまだない場合は在庫確認中
+    status = "checking";
+  } else if (count === 0) {
+    status = "out_of_stock";
+  }
+  return { stock: count, status };
+}
+
 /**
  * 在庫のある商品を取得する
- * 在庫がゼロのマスターと棚卸し済みでない商品は在庫確認中ステータスにする
+ * 在庫がゼロのマスターは品切れ、締めた棚卸しがまだない商品は在庫確認中ステータスにする
  */
 export async function getAvailableProducts(): Promise<ECProduct[]> {
   const supabase = createClient();
 
-  // マスターと在庫データを結合して取得
+  // マスターを取得（在庫数は棚卸しセッションから別に取る）
   const { data, error } = await supabase
     .from("inventory_masters")
     .select(
@@ -31,8 +50,7 @@ export async function getAvailableProducts(): Promise<ECProduct[]> {
       col_3,
       product_image,
       target,
-      created_at,
-      items:items(id, rfid, is_inventoried)
+      created_at
     `
     )
     .order("created_at", { ascending: false });
@@ -42,22 +60,14 @@ export async function getAvailableProducts(): Promise<ECProduct[]> {
     return [];
   }
 
+  // 最新の締め済み棚卸しセッションでの在庫数
+  const stocks = await getMasterStock(data.map((master) => master.id)).catch(
+    () => new Map<string, MasterStock>()
+  );
+
   // 商品データを整形
   const products: ECProduct[] = data.map((master) => {
-    // 在庫数をカウント（棚卸し済みの商品のみ）
-    const inventoriedItems = master.items.filter(
-      (item) => item.is_inventoried === true
-    );
-    const stock = inventoriedItems.length;
-
-    // 在庫ステータスを判定
-    let status: ECProduct["status"] = "available";
-    if (stock === 0) {
-      status = "out_of_stock";
-    } else if (master.items.length > 0 && inventoriedItems.length === 0) {
-      // 商品はあるが棚卸し済みのものがない場合は在庫確認中
-      status = "checking";
-    }
+    const { stock, status } = stockStatus(stocks.get(master.id));
 
     // 価格を数値に変換
     const price = master.col_3 ? parseFloat(master.col_3) : 0;
@@ -94,8 +104,7 @@ export async function getProductById(id: string): Promise<ECProduct | null> {
       col_3,
       product_image,
       target,
-      created_at,
-      items:items(id, rfid, is_inventoried)
+      created_at
     `
     )
     .eq("id", id)
@@ -106,20 +115,11 @@ export async function getProductById(id: string): Promise<ECProduct | null> {
     return null;
   }
 
-  // 在庫数をカウント（棚卸し済みの商品のみ）
-  const inventoriedItems = data.items.filter(
-    (item) => item.is_inventoried === true
+  // 最新の締め済み棚卸しセッションでの在庫数
+  const stocks = await getMasterStock([id]).catch(
+    () => new Map<string, MasterStock>()
   );
-  const stock = inventoriedItems.length;
-
-  // 在庫ステータスを判定
-  let status: ECProduct["status"] = "available";
-  if (stock === 0) {
-    status = "out_of_stock";
-  } else if (data.items.length > 0 && inventoriedItems.length === 0) {
-    // 商品はあるが棚卸し済みのものがない場合は在庫確認中
-    status = "checking";
-  }
+  const { stock, status } = stockStatus(stocks.get(data.id));
 
   // 価格を数値に変換
   const price = data.col_3 ? parseFloat(data.col_3) : 0;
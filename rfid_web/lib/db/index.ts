@@ -4,4 +4,6 @@ export * from "./database.types";
 export type Profile = Tables<"profiles">;
 export type InventoryMaster = Tables<"inventory_masters">;
 export type Item = Tables<"items">;
+export type InventorySession = Tables<"inventory_sessions">;
+export type InventoryScan = Tables<"inventory_scans">;
 export type TokenUsage = Tables<"token_usage">;
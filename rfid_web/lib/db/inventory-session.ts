@@ -0,0 +1,121 @@
+import { createClient } from "@/lib/supabase/client";
+
+import { Constants, Database } from "./database.types";
+import { InventorySession } from "./index";
+
+export type InventorySessionResult =
+  Database["public"]["Functions"]["inventory_session_results"]["Returns"][number];
+
+export type MasterStock =
+  Database["public"]["Views"]["inventory_master_stock"]["Row"];
+
+// in() に渡す ID の数（URL の長さと PostgREST の max-rows に収める）
+const ID_CHUNK_SIZE = 200;
+
+function chunk<T>(values: T[], size = ID_CHUNK_SIZE) {
+  const chunks: T[][] = [];
+  for (let i = 0; i < values.length; i += size) {
+    chunks.push(values.slice(i, i + size));
+  }
+  return chunks;
+}
+
+/**
+ * 業種ごとに最新の締め済み棚卸しセッションを取得する
+ */
+export async function getLatestClosedSessions() {
+  const supabase = createClient();
+  // 履歴全体を取らず、業種ごとに 1 件だけ取る
+  const results = await Promise.all(
+    Constants.public.Enums.target_type.map((target) =>
+      supabase
+        .from("inventory_sessions")
+        .select("*")
+        .eq("target", target)
+        .eq("status", "closed")
+        .order("closed_at", { ascending: false })
+        .limit(1)
+        .maybeSingle()
+    )
+  );
+
+  const sessions: InventorySession[] = [];
+  for (const { data, error } of results) {
+    if (error) {
+      console.error("Error fetching inventory sessions:", error);
+      throw error;
+    }
+    if (data) sessions.push(data as InventorySession);
+  }
+  return sessions;
+}
+
+/**
+ * 最新の締め済みセッションでの棚卸し状態（アイテムID → 棚卸し済みか）を取得する
+ * 取得済みのアイテムIDだけを分割して問い合わせる
+ */
+export async function getItemInventoryStatus(itemIds: string[]) {
+  const supabase = createClient();
+  const results = await Promise.all(
+    chunk(itemIds).map((ids) =>
+      supabase
+        .from("item_inventory_status")
+        .select("item_id, is_inventoried")
+        .in("item_id", ids)
+    )
+  );
+
+  const status = new Map<string, boolean>();
+  for (const { data, error } of results) {
+    if (error) {
+      console.error("Error fetching item inventory status:", error);
+      throw error;
+    }
+    data.forEach((row) => status.set(row.item_id, row.is_inventoried));
+  }
+  return status;
+}
+
+/**
+ * マスターごとのアイテム数と、最新の締め済みセッションで数えた数を取得する
+ */
+export async function getMasterStock(masterIds: string[]) {
+  const supabase = createClient();
+  const results = await Promise.all(
+    chunk(masterIds).map((ids) =>
+      supabase
+        .from("inventory_master_stock")
+        .select("*")
+        .in("inventory_master_id", ids)
+    )
+  );
+
+  const stocks = new Map<string, MasterStock>();
+  for (const { data, error } of results) {
+    if (error) {
+      console.error("Error fetching master stock:", error);
+      throw error;
+    }
+    (data as MasterStock[]).forEach((row) =>
+      stocks.set(row.inventory_master_id, row)
+    );
+  }
+  return stocks;
+}
+
+/**
+ * セッションの一致 / 未読込 / 外れをサーバー側で突き合わせて取得する
+ */
+export async function getSessionResults(sessionId: string) {
+  const supabase = createClient();
+  const { data, error } = await supabase.rpc("inventory_session_results", {
+    p_session_id: sessionId,
+  });
+
+  if (error) {
+    console.error(`Error fetching results for session ${sessionId}:`, error);
+    throw error;
+  }
+
+  return data as InventorySessionResult[];
+}
@@ -2,6 +2,19 @@ import { createClient } from "@/lib/supabase/client";
 
 import { Database } from "./database.types";
 import { InventoryMaster, Item } from "./index";
+import { getItemInventoryStatus } from "./inventory-session";
+
+/**
+ * is_inventoried を最新の締め済み棚卸しセッションの結果に置き換える
+ * （items.is_inventoried はアプリからは更新されない）
+ */
+async function withLatestSessionStatus<T extends Item>(items: T[]) {
+  const status = await getItemInventoryStatus(items.map((item) => item.id));
+  return items.map((item) => ({
+    ...item,
+    is_inventoried: status.get(item.id) ?? false,
+  }));
+}
 
 /**
  * アイテムを取得する
@@ -18,7 +31,7 @@ export async function getItems() {
     throw error;
   }
 
-  return data as Item[];
+  return withLatestSessionStatus(data as Item[]);
 }
 
 /**
@@ -49,7 +62,9 @@ export async function getItemsWithMasterInfo() {
     throw error;
   }
 
-  return data as (Item & { inventory_masters: InventoryMaster })[];
+  return withLatestSessionStatus(
+    data as (Item & { inventory_masters: InventoryMaster })[]
+  );
 }
 
 /**
@@ -68,42 +83,16 @@ export async function getItemsByMasterId(masterId: string) {
     throw error;
   }
 
-  return data as Item[];
+  return withLatestSessionStatus(data as Item[]);
 }
 
 /**
  * 在庫状態でアイテムをフィルタリングして取得する
+ * 在庫状態は最新の締め済み棚卸しセッションの結果
  */
 export async function getItemsByInventoryStatus(isInventoried: boolean) {
-  const supabase = createClient();
-  const { data, error } = await supabase
-    .from("items")
-    .select(
-      `
-      *,
-      inventory_masters:inventory_master_id (
-        id,
-        col_1,
-        col_2,
-        col_3,
-        product_code,
-        product_image,
-        target
-      )
-    `
-    )
-    .eq("is_inventoried", isInventoried)
-    .order("created_at", { ascending: false });
-
-  if (error) {
-    console.error(
-      `Error fetching items with inventory status ${isInventoried}:`,
-      error
-    );
-    throw error;
-  }
-
-  return data as (Item & { inventory_masters: InventoryMaster })[];
+  const items = await getItemsWithMasterInfo();
+  return items.filter((item) => item.is_inventoried === isInventoried);
 }
 
 /**
@@ -137,7 +126,9 @@ export async function getItemsByTargetType(
     throw error;
   }
 
-  return data as (Item & { inventory_masters: InventoryMaster })[];
+  return withLatestSessionStatus(
+    data as (Item & { inventory_masters: InventoryMaster })[]
+  );
 }
 
 /**
@@ -169,7 +160,10 @@ export async function getItemById(id: string) {
     throw error;
   }
 
-  return data as Item & { inventory_masters: InventoryMaster };
+  const [item] = await withLatestSessionStatus([
+    data as Item & { inventory_masters: InventoryMaster },
+  ]);
+  return item;
 }
 
 /**
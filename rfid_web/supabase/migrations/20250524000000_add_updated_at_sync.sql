@@ -0,0 +1,22 @@
+-- Keep updated_at current so clients can pull changes by (updated_at, id)
+CREATE OR REPLACE FUNCTION "public"."set_updated_at"()
+RETURNS TRIGGER
+LANGUAGE plpgsql
+AS $function$
+BEGIN
+    NEW.updated_at = clock_timestamp();
+    RETURN NEW;
+END;
+$function$;
+
+CREATE TRIGGER items_set_updated_at
+    BEFORE UPDATE ON "public"."items"
+    FOR EACH ROW EXECUTE FUNCTION "public"."set_updated_at"();
+
+CREATE TRIGGER inventory_masters_set_updated_at
+    BEFORE UPDATE ON "public"."inventory_masters"
+    FOR EACH ROW EXECUTE FUNCTION "public"."set_updated_at"();
+
+-- Create index for keyset paging by (updated_at, id)
+CREATE INDEX items_updated_at_id_idx ON "public"."items" ("updated_at", "id");
+CREATE INDEX inventory_masters_updated_at_id_idx ON "public"."inventory_masters" ("updated_at", "id");
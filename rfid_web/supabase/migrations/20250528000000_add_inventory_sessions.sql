@@ -0,0 +1,223 @@
+-- Record each inventory count as a session with append-only scans
+-- (items.is_inventoried is no longer written by the app; kept for older clients)
+CREATE TYPE "public"."inventory_session_status" AS ENUM ('open', 'closed', 'discarded');
+
+-- Create inventory_sessions table
+CREATE TABLE "public"."inventory_sessions" (
+    "id" UUID NOT NULL DEFAULT gen_random_uuid(),
+    "created_at" TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT now(),
+    "updated_at" TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT now(),
+    "target" target_type NOT NULL,
+    "status" inventory_session_status NOT NULL DEFAULT 'open',
+    "closed_at" TIMESTAMP WITH TIME ZONE,
+    -- Filled by close_inventory_session()
+    "matched_count" INTEGER,
+    "uncounted_count" INTEGER,
+    "outer_count" INTEGER,
+    "user_id" UUID DEFAULT auth.uid(),
+    CONSTRAINT "inventory_sessions_pkey" PRIMARY KEY ("id"),
+    CONSTRAINT "inventory_sessions_user_id_fkey" FOREIGN KEY ("user_id")
+        REFERENCES auth.users(id) ON DELETE CASCADE
+);
+
+-- Create inventory_scans table (one row per RFID read in a session)
+CREATE TABLE "public"."inventory_scans" (
+    "session_id" UUID NOT NULL,
+    "rfid" TEXT NOT NULL,
+    "scanned_at" TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT now(),
+    CONSTRAINT "inventory_scans_pkey" PRIMARY KEY ("session_id", "rfid"),
+    CONSTRAINT "inventory_scans_session_id_fkey" FOREIGN KEY ("session_id")
+        REFERENCES "public"."inventory_sessions"("id") ON DELETE CASCADE
+);
+
+CREATE TRIGGER inventory_sessions_set_updated_at
+    BEFORE UPDATE ON "public"."inventory_sessions"
+    FOR EACH ROW EXECUTE FUNCTION "public"."set_updated_at"();
+
+-- Create index for finding the latest closed session per target
+CREATE INDEX inventory_sessions_latest_idx
+    ON "public"."inventory_sessions" ("user_id", "target", "status", "closed_at" DESC);
+-- Match scans against items by upper-case RFID
+CREATE INDEX items_upper_rfid_idx ON "public"."items" (upper("rfid"));
+
+-- Enable Row Level Security
+ALTER TABLE "public"."inventory_sessions" ENABLE ROW LEVEL SECURITY;
+ALTER TABLE "public"."inventory_scans" ENABLE ROW LEVEL SECURITY;
+
+-- Create policies
+CREATE POLICY "Users can view their own inventory sessions"
+    ON "public"."inventory_sessions"
+    FOR SELECT
+    TO authenticated
+    USING (auth.uid() = user_id);
+
+CREATE POLICY "Users can create their own inventory sessions"
+    ON "public"."inventory_sessions"
+    FOR INSERT
+    TO authenticated
+    WITH CHECK (auth.uid() = user_id);
+
+CREATE POLICY "Users can update their own inventory sessions"
+    ON "public"."inventory_sessions"
+    FOR UPDATE
+    TO authenticated
+    USING (auth.uid() = user_id);
+
+CREATE POLICY "Users can delete their own inventory sessions"
+    ON "public"."inventory_sessions"
+    FOR DELETE
+    TO authenticated
+    USING (auth.uid() = user_id);
+
+CREATE POLICY "Users can view scans of their own sessions"
+    ON "public"."inventory_scans"
+    FOR SELECT
+    TO authenticated
+    USING (EXISTS (
+        SELECT 1 FROM "public"."inventory_sessions" s
+        WHERE s.id = session_id AND s.user_id = auth.uid()
+    ));
+
+CREATE POLICY "Users can append scans to their own sessions"
+    ON "public"."inventory_scans"
+    FOR INSERT
+    TO authenticated
+    WITH CHECK (EXISTS (
+        SELECT 1 FROM "public"."inventory_sessions" s
+        WHERE s.id = session_id AND s.user_id = auth.uid()
+    ));
+
+-- Grant permissions (scans are append-only for clients)
+GRANT ALL ON TABLE "public"."inventory_sessions" TO authenticated;
+GRANT ALL ON TABLE "public"."inventory_sessions" TO service_role;
+GRANT SELECT, INSERT ON TABLE "public"."inventory_scans" TO authenticated;
+GRANT ALL ON TABLE "public"."inventory_scans" TO service_role;
+
+-- Append scanned RFIDs to an open session in one call. Returns the number of new rows
+-- (re-sent batches are ignored). Appending to a closed session is a no-op.
+CREATE OR REPLACE FUNCTION "public"."append_inventory_scans"(p_session_id UUID, p_rfids TEXT[])
+RETURNS INTEGER
+LANGUAGE plpgsql
+SET search_path = public
+AS $function$
+DECLARE
+    v_status inventory_session_status;
+    v_inserted INTEGER;
+BEGIN
+    SELECT status INTO v_status FROM inventory_sessions WHERE id = p_session_id;
+    IF NOT FOUND THEN
+        RAISE EXCEPTION 'inventory session % not found', p_session_id USING ERRCODE = '23503';
+    END IF;
+    IF v_status <> 'open' THEN
+        RETURN 0;
+    END IF;
+
+    INSERT INTO inventory_scans (session_id, rfid)
+    SELECT DISTINCT p_session_id, upper(r) FROM unnest(p_rfids) AS r
+    ON CONFLICT DO NOTHING;
+    GET DIAGNOSTICS v_inserted = ROW_COUNT;
+    RETURN v_inserted;
+END;
+$function$;
+
+-- Per-RFID result of a session: items of the session's target vs. its scans
+--   matched   : in both
+--   uncounted : item not scanned
+--   outer     : scanned, not an item of the target
+CREATE OR REPLACE FUNCTION "public"."inventory_session_results"(p_session_id UUID)
+RETURNS TABLE (rfid TEXT, result TEXT, item_id UUID, inventory_master_id UUID)
+LANGUAGE sql
+STABLE
+SET search_path = public
+AS $function$
+    WITH expected AS (
+        SELECT upper(i.rfid) AS rfid, i.id AS item_id, i.inventory_master_id
+        FROM items i
+        JOIN inventory_masters m ON m.id = i.inventory_master_id
+        JOIN inventory_sessions s ON s.target = m.target
+        WHERE s.id = p_session_id
+    ), scanned AS (
+        SELECT sc.rfid FROM inventory_scans sc WHERE sc.session_id = p_session_id
+    )
+    SELECT COALESCE(e.rfid, sc.rfid),
+           CASE WHEN e.rfid IS NULL THEN 'outer'
+                WHEN sc.rfid IS NULL THEN 'uncounted'
+                ELSE 'matched' END,
+           e.item_id,
+           e.inventory_master_id
+    FROM expected e
+    FULL OUTER JOIN scanned sc ON sc.rfid = e.rfid;
+$function$;
+
+-- Close (or discard) a session and store its counts. Closing again returns the stored row.
+CREATE OR REPLACE FUNCTION "public"."close_inventory_session"(p_session_id UUID, p_discard BOOLEAN DEFAULT FALSE)
+RETURNS "public"."inventory_sessions"
+LANGUAGE plpgsql
+SET search_path = public
+AS $function$
+DECLARE
+    v_session inventory_sessions;
+BEGIN
+    UPDATE inventory_sessions s SET
+        status = CASE WHEN p_discard THEN 'discarded' ELSE 'closed' END::inventory_session_status,
+        closed_at = now(),
+        matched_count = r.matched_count,
+        uncounted_count = r.uncounted_count,
+        outer_count = r.outer_count
+    FROM (
+        SELECT count(*) FILTER (WHERE x.result = 'matched') AS matched_count,
+               count(*) FILTER (WHERE x.result = 'uncounted') AS uncounted_count,
+               count(*) FILTER (WHERE x.result = 'outer') AS outer_count
+        FROM inventory_session_results(p_session_id) x
+    ) r
+    WHERE s.id = p_session_id AND s.status = 'open'
+    RETURNING s.* INTO v_session;
+
+    IF v_session.id IS NULL THEN
+        SELECT * INTO v_session FROM inventory_sessions WHERE id = p_session_id;
+        IF NOT FOUND THEN
+            RAISE EXCEPTION 'inventory session % not found', p_session_id USING ERRCODE = '23503';
+        END IF;
+    END IF;
+    RETURN v_session;
+END;
+$function$;
+
+GRANT EXECUTE ON FUNCTION "public"."append_inventory_scans"(UUID, TEXT[]) TO authenticated;
+GRANT EXECUTE ON FUNCTION "public"."inventory_session_results"(UUID) TO authenticated;
+GRANT EXECUTE ON FUNCTION "public"."close_inventory_session"(UUID, BOOLEAN) TO authenticated;
+
+-- Inventory state of each item as of the latest closed session of its target
+CREATE OR REPLACE VIEW "public"."item_inventory_status"
+WITH (security_invoker = true)
+AS
+WITH latest AS (
+    SELECT DISTINCT ON (s.user_id, s.target) s.id, s.user_id, s.target, s.closed_at
+    FROM inventory_sessions s
+    WHERE s.status = 'closed'
+    ORDER BY s.user_id, s.target, s.closed_at DESC
+)
+SELECT i.id AS item_id,
+       i.inventory_master_id,
+       m.target,
+       latest.id AS session_id,
+       latest.closed_at,
+       (sc.rfid IS NOT NULL) AS is_inventoried
+FROM items i
+JOIN inventory_masters m ON m.id = i.inventory_master_id
+LEFT JOIN latest ON latest.target = m.target AND latest.user_id = i.user_id
+LEFT JOIN inventory_scans sc ON sc.session_id = latest.id AND sc.rfid = upper(i.rfid);
+
+-- Per-master stock for the EC views (items counted in the latest closed session)
+CREATE OR REPLACE VIEW "public"."inventory_master_stock"
+WITH (security_invoker = true)
+AS
+SELECT inventory_master_id,
+       count(*)::INTEGER AS item_count,
+       (count(*) FILTER (WHERE is_inventoried))::INTEGER AS inventoried_count,
+       max(closed_at) AS counted_at
+FROM item_inventory_status
+GROUP BY inventory_master_id;
+
+GRANT SELECT ON "public"."item_inventory_status" TO authenticated;
+GRANT SELECT ON "public"."inventory_master_stock" TO authenticated;